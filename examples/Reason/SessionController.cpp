@@ -1801,6 +1801,7 @@ bool SessionController::quantizeMidiNotes (uint64_t clipId, const juce::Array<ju
     const auto clipStartBeat = te::toBeats (clipStart, edit->tempoSequence);
     auto& undo = edit->getUndoManager();
     undo.beginNewTransaction ("Quantize MIDI Notes");
+    const te::MidiList::ScopedBulkEdit bulkEdit (midiClip->getSequence());
 
     for (auto* note : notes)
     {
@@ -29,7 +29,13 @@
 #define ENGINE_UNIT_TESTS_EDIT                          1
 #define ENGINE_UNIT_TESTS_EDITCLIP                      1
 #define ENGINE_UNIT_TESTS_EDIT_LOADER                   1
+#define ENGINE_UNIT_TESTS_BINARY_EDIT_FILE              1
+#define ENGINE_UNIT_TESTS_BIQUAD_CASCADE                1
+#define ENGINE_UNIT_TESTS_EDIT_JOURNAL                  1
+#define ENGINE_UNIT_TESTS_EDIT_FILE_OPERATIONS          1
 #define ENGINE_UNIT_TESTS_EDIT_TIME                     1
+#define ENGINE_UNIT_TESTS_ENVELOPE                      1
+#define ENGINE_UNIT_TESTS_FDN_REVERB                    1
 #define ENGINE_UNIT_TESTS_FREEZE                        1
 #define ENGINE_UNIT_TESTS_FOLLOW_ACTIONS                1
 #define ENGINE_UNIT_TESTS_LATENCY                       1
@@ -40,21 +46,30 @@
 #define ENGINE_UNIT_TESTS_LOOP_INFO                     1
 #define ENGINE_UNIT_TESTS_MIDILIST                      1
 #define ENGINE_UNIT_TESTS_MODIFIERS                     1
+#define ENGINE_UNIT_TESTS_OSCILLATORS                   1
+#define ENGINE_UNIT_TESTS_OVERSAMPLER                   1
 #define ENGINE_UNIT_TESTS_PAN_LAW                       1
+#define ENGINE_UNIT_TESTS_PARTITIONED_CONVOLVER         1
 #define ENGINE_UNIT_TESTS_PLAYBACK                      1
 #define ENGINE_UNIT_TESTS_PLUGINS                       1
+#define ENGINE_UNIT_TESTS_PLUGIN_NODE                   1
 #define ENGINE_UNIT_TESTS_PDC                           1
 #define ENGINE_UNIT_TESTS_RACKINSTANCE                  1
 #define ENGINE_UNIT_TESTS_RECORDING                     1
 #define ENGINE_UNIT_TESTS_RENDERING                     1
+#define ENGINE_UNIT_TESTS_SAMPLER                       1
 #define ENGINE_UNIT_TESTS_TIMESTRETCHER                 1
 #define ENGINE_UNIT_TESTS_CLIPS                         1
 #define ENGINE_UNIT_TESTS_SELECTABLE                    1
+#define ENGINE_UNIT_TESTS_SHARED_AUDIO_DATA_STORE       1
 #define ENGINE_UNIT_TESTS_AUDIO_FILE                    1
 #define ENGINE_UNIT_TESTS_AUDIO_FILE_CACHE              1
+#define ENGINE_UNIT_TESTS_CHUNKED_AUDIO_RING            1
 #define ENGINE_UNIT_TESTS_VOLPANPLUGIN                  1
 #define ENGINE_UNIT_TESTS_TEMPO_SEQUENCE                1
+#define ENGINE_UNIT_TESTS_VALUE_TREE_OBJECT_LIST        1
 #define ENGINE_UNIT_TESTS_QUANTISATION_TYPE             1
+#define ENGINE_UNIT_TESTS_MIDI_INPUT_DEVICE             1
 #define ENGINE_UNIT_TESTS_WAVE_INPUT_DEVICE             1
 #define ENGINE_UNIT_TESTS_WAVENODE_READAHEAD            1
 
@@ -79,9 +94,16 @@
 #define ENGINE_BENCHMARKS_AUDIOFILECACHE                1
 #define ENGINE_BENCHMARKS_CONTAINERCLIP                 1
 #define ENGINE_BENCHMARKS_MIDICLIP                      1
+#define ENGINE_BENCHMARKS_MIDILIST                      1
 #define ENGINE_BENCHMARKS_EDITITEMID                    1
 #define ENGINE_BENCHMARKS_WAVENODE                      1
 #define ENGINE_BENCHMARKS_RESAMPLING                    1
 #define ENGINE_BENCHMARKS_RACKS                         1
 #define ENGINE_BENCHMARKS_SELECTABLE                    1
+#define ENGINE_BENCHMARKS_BIQUAD_CASCADE                1
+#define ENGINE_BENCHMARKS_FDN_REVERB                    1
+#define ENGINE_BENCHMARKS_OVERSAMPLER                   1
+#define ENGINE_BENCHMARKS_PARTITIONED_CONVOLVER         1
 #define ENGINE_BENCHMARKS_PLUGINNODE                    1
+#define ENGINE_BENCHMARKS_VALUE_TREE_OBJECT_LIST        1
+#define ENGINE_BENCHMARKS_BINARY_EDIT_FILE              1
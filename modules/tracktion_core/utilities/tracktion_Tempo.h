@@ -12,6 +12,8 @@
 
 #include <cassert>
 #include <algorithm>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include "tracktion_Time.h"
@@ -158,6 +160,20 @@ namespace tempo
         /** Converts a time to a number of BarsAndBeats. */
         BarsAndBeats toBarsAndBeats (TimePosition) const;
 
+        //==============================================================================
+        /** Converts a number of times to beats.
+            This is much quicker than converting each one individually if the times are
+            ascending as the sections only need to be searched once and each run of times
+            in the same section is converted in a tight loop.
+            The destination must be at least as big as the source.
+        */
+        void toBeats (std::span<const TimePosition>, std::span<BeatPosition>) const;
+
+        /** Converts a number of beats to times.
+            @see toBeats
+        */
+        void toTime (std::span<const BeatPosition>, std::span<TimePosition>) const;
+
         //==============================================================================
         /** Returns the tempo at a position. */
         double getBpmAt (TimePosition) const;
@@ -372,34 +388,72 @@ struct Sequence::Section
 
 namespace details
 {
-    inline BeatPosition toBeats (const std::vector<Sequence::Section>& sections, TimePosition time)
+    /** Returns the index of the last section starting at or before a time, or 0 if there isn't one.
+        If a hint is given, that and the following section are checked before searching.
+    */
+    inline size_t findSectionForTime (const std::vector<Sequence::Section>& sections, TimePosition time,
+                                      size_t hint = 0)
     {
-        for (int i = (int) sections.size(); --i > 0;)
+        assert (! sections.empty());
+        const auto numSections = sections.size();
+
+        if (hint < numSections && sections[hint].startTime <= time)
         {
-            auto& it = sections[(size_t) i];
+            if (hint + 1 == numSections || sections[hint + 1].startTime > time)
+                return hint;
 
-            if (it.startTime <= time)
-                return it.startBeat + (time - it.startTime) * it.beatsPerSecond;
+            if (hint + 2 == numSections || sections[hint + 2].startTime > time)
+                return hint + 1;
         }
 
-        auto& it = sections[0];
-        return it.startBeat + ((time - it.startTime) * it.beatsPerSecond);
+        auto iter = std::upper_bound (sections.begin() + 1, sections.end(), time,
+                                      [] (TimePosition t, const Sequence::Section& s) { return t < s.startTime; });
+        return static_cast<size_t> (std::distance (sections.begin(), iter)) - 1;
     }
 
-    inline TimePosition toTime (const std::vector<Sequence::Section>& sections, BeatPosition beats)
+    /** Returns the index of the last section starting at or before a beat, or 0 if there isn't one.
+        If a hint is given, that and the following section are checked before searching.
+    */
+    inline size_t findSectionForBeat (const std::vector<Sequence::Section>& sections, BeatPosition beat,
+                                      size_t hint = 0)
     {
-        for (int i = (int) sections.size(); --i >= 0;)
+        assert (! sections.empty());
+        const auto numSections = sections.size();
+
+        if (hint < numSections && sections[hint].startBeat <= beat)
         {
-            auto& it = sections[(size_t) i];
+            if (hint + 1 == numSections || sections[hint + 1].startBeat > beat)
+                return hint;
 
-            if (toPosition (beats - it.startBeat) >= BeatPosition())
-                return it.startTime + it.secondsPerBeat * (beats - it.startBeat);
+            if (hint + 2 == numSections || sections[hint + 2].startBeat > beat)
+                return hint + 1;
         }
 
-        auto& it = sections[0];
+        auto iter = std::upper_bound (sections.begin() + 1, sections.end(), beat,
+                                      [] (BeatPosition b, const Sequence::Section& s) { return b < s.startBeat; });
+        return static_cast<size_t> (std::distance (sections.begin(), iter)) - 1;
+    }
+
+    inline BeatPosition toBeats (const Sequence::Section& it, TimePosition time)
+    {
+        return it.startBeat + (time - it.startTime) * it.beatsPerSecond;
+    }
+
+    inline TimePosition toTime (const Sequence::Section& it, BeatPosition beats)
+    {
         return it.startTime + it.secondsPerBeat * (beats - it.startBeat);
     }
 
+    inline BeatPosition toBeats (const std::vector<Sequence::Section>& sections, TimePosition time)
+    {
+        return toBeats (sections[findSectionForTime (sections, time)], time);
+    }
+
+    inline TimePosition toTime (const std::vector<Sequence::Section>& sections, BeatPosition beats)
+    {
+        return toTime (sections[findSectionForBeat (sections, beats)], beats);
+    }
+
     inline TimePosition toTime (const std::vector<Sequence::Section>& sections, BarsAndBeats barsBeats)
     {
         for (int i = (int) sections.size(); --i >= 0;)
@@ -419,26 +473,17 @@ namespace details
 
     inline BarsAndBeats toBarsAndBeats (const std::vector<Sequence::Section>& sections, TimePosition time)
     {
-        for (int i = (int) sections.size(); --i >= 0;)
-        {
-            auto& it = sections[(size_t) i];
-
-            if (it.startTime <= time || i == 0)
-            {
-                const auto beatsSinceFirstBar = ((time - it.timeOfFirstBar) * it.beatsPerSecond).inBeats();
+        auto& it = sections[findSectionForTime (sections, time)];
+        const auto beatsSinceFirstBar = ((time - it.timeOfFirstBar) * it.beatsPerSecond).inBeats();
 
-                if (beatsSinceFirstBar < 0)
-                    return { it.barNumberOfFirstBar + (int) std::floor (beatsSinceFirstBar / it.numerator),
-                             BeatDuration::fromBeats (std::fmod (std::fmod (beatsSinceFirstBar, it.numerator) + it.numerator, it.numerator)),
-                             it.numerator };
+        if (beatsSinceFirstBar < 0)
+            return { it.barNumberOfFirstBar + (int) std::floor (beatsSinceFirstBar / it.numerator),
+                     BeatDuration::fromBeats (std::fmod (std::fmod (beatsSinceFirstBar, it.numerator) + it.numerator, it.numerator)),
+                     it.numerator };
 
-                return { it.barNumberOfFirstBar + (int) std::floor (beatsSinceFirstBar / it.numerator),
-                         BeatDuration::fromBeats (std::fmod (beatsSinceFirstBar, it.numerator)),
-                         it.numerator };
-            }
-        }
-
-        return { 0, {} };
+        return { it.barNumberOfFirstBar + (int) std::floor (beatsSinceFirstBar / it.numerator),
+                 BeatDuration::fromBeats (std::fmod (beatsSinceFirstBar, it.numerator)),
+                 it.numerator };
     }
 }
 
@@ -690,61 +735,75 @@ inline BarsAndBeats Sequence::toBarsAndBeats (TimePosition t) const
     return details::toBarsAndBeats (sections, t);
 }
 
-//==============================================================================
-inline double Sequence::getBpmAt (TimePosition t) const
+inline void Sequence::toBeats (std::span<const TimePosition> times, std::span<BeatPosition> beats) const
 {
-    for (int i = (int) sections.size(); --i >= 0;)
+    assert (beats.size() >= times.size());
+    const auto numSections = sections.size();
+    const auto num = times.size();
+    size_t sectionIndex = 0;
+
+    for (size_t i = 0; i < num;)
     {
-        auto& it = sections[(size_t) i];
+        sectionIndex = details::findSectionForTime (sections, times[i], sectionIndex);
+        const auto& section = sections[sectionIndex];
+        const auto sectionEnd = sectionIndex + 1 < numSections ? sections[sectionIndex + 1].startTime
+                                                               : TimePosition::fromSeconds (std::numeric_limits<double>::max());
 
-        if (it.startTime <= t || i == 0)
-            return it.bpm;
-    }
+        // Find the run of ascending times in this section and convert them in one go
+        auto runEnd = i + 1;
 
-    assert(false);
-    return 120.0;
+        while (runEnd < num && times[runEnd] >= times[runEnd - 1] && times[runEnd] < sectionEnd)
+            ++runEnd;
+
+        for (; i < runEnd; ++i)
+            beats[i] = details::toBeats (section, times[i]);
+    }
 }
 
-inline Key Sequence::getKeyAt (TimePosition t) const
+inline void Sequence::toTime (std::span<const BeatPosition> beats, std::span<TimePosition> times) const
 {
-    for (int i = (int) sections.size(); --i >= 0;)
+    assert (times.size() >= beats.size());
+    const auto numSections = sections.size();
+    const auto num = beats.size();
+    size_t sectionIndex = 0;
+
+    for (size_t i = 0; i < num;)
     {
-        auto& it = sections[(size_t) i];
+        sectionIndex = details::findSectionForBeat (sections, beats[i], sectionIndex);
+        const auto& section = sections[sectionIndex];
+        const auto sectionEnd = sectionIndex + 1 < numSections ? sections[sectionIndex + 1].startBeat
+                                                               : BeatPosition::fromBeats (std::numeric_limits<double>::max());
 
-        if (it.startTime <= t || i == 0)
-            return it.key;
-    }
+        auto runEnd = i + 1;
 
-    assert(false);
-    return {};
+        while (runEnd < num && beats[runEnd] >= beats[runEnd - 1] && beats[runEnd] < sectionEnd)
+            ++runEnd;
+
+        for (; i < runEnd; ++i)
+            times[i] = details::toTime (section, beats[i]);
+    }
 }
 
-inline TimeSignature Sequence::getTimeSignatureAt (TimePosition t) const
+//==============================================================================
+inline double Sequence::getBpmAt (TimePosition t) const
 {
-    for (int i = (int) sections.size(); --i >= 0;)
-    {
-        auto& it = sections[(size_t) i];
+    return sections[details::findSectionForTime (sections, t)].bpm;
+}
 
-        if (it.startTime <= t || i == 0)
-            return { .numerator = it.numerator, .denominator = it.denominator };
-    }
+inline Key Sequence::getKeyAt (TimePosition t) const
+{
+    return sections[details::findSectionForTime (sections, t)].key;
+}
 
-    assert(false);
-    return {};
+inline TimeSignature Sequence::getTimeSignatureAt (TimePosition t) const
+{
+    auto& it = sections[details::findSectionForTime (sections, t)];
+    return { .numerator = it.numerator, .denominator = it.denominator };
 }
 
 inline BeatsPerSecond Sequence::getBeatsPerSecondAt (TimePosition t) const
 {
-    for (int i = (int) sections.size(); --i >= 0;)
-    {
-        auto& it = sections[(size_t) i];
-
-        if (it.startTime <= t || i == 0)
-            return it.beatsPerSecond;
-    }
-
-    assert(false);
-    return { 2.0 };
+    return sections[details::findSectionForTime (sections, t)].beatsPerSecond;
 }
 
 inline size_t Sequence::hash() const
@@ -808,31 +867,16 @@ inline Key Sequence::Position::getKey() const
 //==============================================================================
 inline void Sequence::Position::set (TimePosition t)
 {
-    const auto maxIndex = sequence.sections.size() - 1;
-
-    if (index > maxIndex)
-    {
-        index = maxIndex;
-        time = sequence.sections[index].startTime;
-    }
-
-    if (t >= time)
-    {
-        while (index < maxIndex && sequence.sections[index + 1].startTime <= t)
-            ++index;
-    }
-    else
-    {
-        while (index > 0 && sequence.sections[index].startTime > t)
-            --index;
-    }
-
+    // The hint covers the common case of moving forwards within or into the next section,
+    // anything else is a binary search
+    index = details::findSectionForTime (sequence.sections, t, index);
     time = t;
 }
 
 inline TimePosition Sequence::Position::set (BeatPosition t)
 {
-    set (details::toTime (sequence.sections, t));
+    index = details::findSectionForBeat (sequence.sections, t, index);
+    time = details::toTime (sequence.sections[index], t);
     return time;
 }
 
@@ -949,13 +993,9 @@ inline BeatPosition Sequence::Position::getBeatOfNextChange() const
 //==============================================================================
 inline void Sequence::Position::setPPQTime (double ppq)
 {
-    for (int i = (int) sequence.sections.size(); --i >= 0;)
-    {
-        index = (size_t) i;
-
-        if (sequence.sections[index].ppqAtStart <= ppq)
-            break;
-    }
+    auto iter = std::upper_bound (sequence.sections.begin() + 1, sequence.sections.end(), ppq,
+                                  [] (double p, const Section& s) { return p < s.ppqAtStart; });
+    index = static_cast<size_t> (std::distance (sequence.sections.begin(), iter)) - 1;
 
     const auto& it = sequence.sections[index];
     const auto beatsSinceStart = BeatPosition::fromBeats (((ppq - it.ppqAtStart) * it.denominator) / 4.0);
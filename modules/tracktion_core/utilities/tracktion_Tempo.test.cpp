@@ -424,6 +424,50 @@ private:
                 expect (pos.getKey() == tempo::Key { 42, 1 });
             }
         }
+
+        beginTest ("Batch conversions");
+        {
+            tempo::Sequence seq ({{ BeatPosition(), 120.0, 0.5f },
+                                  { BeatPosition::fromBeats (16), 60.0, -1.0f },
+                                  { BeatPosition::fromBeats (24), 140.0, 0.0f } },
+                                 {{ BeatPosition(), 4, 4, false },
+                                  { BeatPosition::fromBeats (20), 3, 4, false }},
+                                 tempo::LengthOfOneBeat::dependsOnTimeSignature);
+
+            std::vector<TimePosition> times;
+            std::vector<BeatPosition> beats;
+
+            // Include negative positions and a jump backwards to check the non-ascending path
+            for (double t = -1.0; t < 40.0; t += 0.01)
+                times.push_back (TimePosition::fromSeconds (t));
+
+            times.push_back (TimePosition::fromSeconds (3.0));
+            times.push_back (TimePosition::fromSeconds (2.0));
+
+            for (double b = -1.0; b < 80.0; b += 0.01)
+                beats.push_back (BeatPosition::fromBeats (b));
+
+            std::vector<BeatPosition> convertedBeats (times.size());
+            std::vector<TimePosition> convertedTimes (beats.size());
+            seq.toBeats (times, convertedBeats);
+            seq.toTime (beats, convertedTimes);
+
+            tempo::Sequence::Position pos (seq);
+            bool allMatch = true;
+
+            for (size_t i = 0; i < times.size(); ++i)
+            {
+                pos.set (times[i]);
+                allMatch = allMatch && convertedBeats[i] == seq.toBeats (times[i])
+                                    && pos.getBeats() == convertedBeats[i];
+            }
+
+            for (size_t i = 0; i < beats.size(); ++i)
+                allMatch = allMatch && convertedTimes[i] == seq.toTime (beats[i])
+                                    && pos.set (beats[i]) == convertedTimes[i];
+
+            expect (allMatch);
+        }
     }
 };
 
@@ -460,6 +504,18 @@ public:
             benchmarkSequence (-0.5f);
             benchmarkSequence (0.5f);
         }
+
+        beginTest ("Benchmark: Tempo Position");
+        {
+            benchmarkPosition (0.0f);
+            benchmarkPosition (0.5f);
+        }
+
+        beginTest ("Benchmark: Sequential tempo ramp conversion");
+        {
+            benchmarkSequential (0.0f);
+            benchmarkSequential (0.5f);
+        }
     }
 
     void benchmarkSequence (float curve)
@@ -606,6 +662,69 @@ public:
         for (auto bm : { &bm1, &bm2, &bm3, &bm4 })
             BenchmarkList::getInstance().addResult (bm->getResult());
     }
+
+    void benchmarkSequential (float curve)
+    {
+        // Create a long sequence of ramped tempos (which get subdivided in to many sections)
+        // then convert ascending times to beats as the playback graph does:
+        //  - Individually through the Sequence
+        //  - Through a Position
+        //  - As a batch
+
+        constexpr int numIterations = 10;
+        constexpr int numBeats = 1000;
+        constexpr int numConversions = 100'000;
+        juce::Random r (4200);
+
+        using choc::text::replace;
+        const auto curveDesc = replace ("(4/4, curve = CCC)", "CCC", std::to_string (curve));
+        Benchmark bm1 (createBenchmarkDescription ("Tempo Sequence", "Convert 100,000 ascending", "1000 ramped tempos, individually " + curveDesc));
+        Benchmark bm2 (createBenchmarkDescription ("Tempo Sequence", "Convert 100,000 ascending", "1000 ramped tempos, Position " + curveDesc));
+        Benchmark bm3 (createBenchmarkDescription ("Tempo Sequence", "Convert 100,000 ascending", "1000 ramped tempos, batch " + curveDesc));
+
+        std::vector<tempo::TempoChange> tempos;
+
+        for (int b = 0; b < numBeats; b += 4)
+            tempos.push_back ({ BeatPosition::fromBeats (b), (double) r.nextInt ({ 60, 180 }), curve });
+
+        const tempo::Sequence seq (std::move (tempos), {{ BeatPosition(), 4, 4, false }},
+                                   tempo::LengthOfOneBeat::dependsOnTimeSignature);
+
+        const auto endTime = seq.toTime (BeatPosition::fromBeats (numBeats));
+        std::vector<TimePosition> times;
+        std::vector<BeatPosition> beats (numConversions);
+
+        for (int i = 0; i < numConversions; ++i)
+            times.push_back (endTime * (i / (double) numConversions));
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            bm1.start();
+
+            for (size_t c = 0; c < times.size(); ++c)
+                beats[c] = seq.toBeats (times[c]);
+
+            bm1.stop();
+
+            tempo::Sequence::Position pos (seq);
+            bm2.start();
+
+            for (size_t c = 0; c < times.size(); ++c)
+            {
+                pos.set (times[c]);
+                beats[c] = pos.getBeats();
+            }
+
+            bm2.stop();
+
+            bm3.start();
+            seq.toBeats (times, beats);
+            bm3.stop();
+        }
+
+        for (auto bm : { &bm1, &bm2, &bm3 })
+            BenchmarkList::getInstance().addResult (bm->getResult());
+    }
 };
 
 static TempoBenchmarks tempoBenchmarks;
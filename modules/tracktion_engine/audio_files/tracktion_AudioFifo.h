@@ -145,6 +145,12 @@ public:
         return true;
     }
 
+    /** Discards up to numSamples of the samples ready to be read. */
+    void skip (int numSamples) noexcept
+    {
+        fifo.finishedRead (juce::jmin (numSamples, getNumReady()));
+    }
+
     bool readAdding (juce::AudioBuffer<float>& dest, int startSampleInDestBuffer)
     {
         return readAdding (dest, startSampleInDestBuffer, dest.getNumSamples());
@@ -477,6 +477,11 @@ struct AudioFileManager::KnownFile
     {
     }
 
+    KnownFile (const AudioFile& f, AudioFileInfo i)
+        : file (f), info (std::move (i))
+    {
+    }
+
     AudioFile file;
     AudioFileInfo info;
 
@@ -823,8 +828,25 @@ AudioFile AudioFileManager::getAudioFile (ProjectItemID sourceID)
 
 AudioFileInfo AudioFileManager::getInfo (const AudioFile& file)
 {
+    const auto hash = file.getHash();
+
+    {
+        const juce::ScopedLock sl (knownFilesLock);
+
+        if (auto kf = knownFiles.find (hash); kf != knownFiles.end())
+            return kf->second->info;
+    }
+
+    // Parse without holding the lock so several files can be read at once, e.g. when loading an Edit
+    auto info = AudioFileInfo::parse (file);
+
     const juce::ScopedLock sl (knownFilesLock);
-    return findOrCreateKnown (file).info;
+    auto& kf = knownFiles[hash];
+
+    if (kf == nullptr)
+        kf = std::make_unique<KnownFile> (file, std::move (info));
+
+    return kf->info;
 }
 
 bool AudioFileManager::checkFileTime (KnownFile& f)
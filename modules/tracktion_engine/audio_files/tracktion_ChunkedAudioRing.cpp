@@ -0,0 +1,508 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace chunked_audio_ring
+{
+    static constexpr float intScale = 8388608.0f; // 2^23
+    static constexpr size_t alignment = 16;
+    static constexpr size_t maxNumChunksPerSegment = 16;
+    static constexpr size_t numInitialSegments = 3;
+
+    static size_t alignUp (size_t numBytes)
+    {
+        return (numBytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    static uint32_t zigzag (int32_t v)
+    {
+        return (static_cast<uint32_t> (v) << 1) ^ static_cast<uint32_t> (v >> 31);
+    }
+
+    static int32_t unzigzag (uint32_t v)
+    {
+        return static_cast<int32_t> (v >> 1) ^ -static_cast<int32_t> (v & 1);
+    }
+
+    /** Returns the number of bits needed for each delta, or -1 if the samples aren't all whole 24-bit values. */
+    static int getNumPackedBits (const float* data, int numFrames)
+    {
+        uint32_t allBits = 0;
+        int32_t previous = 0;
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const auto scaled = data[i] * intScale;
+
+            // This also rejects NaNs
+            if (! (scaled >= -intScale && scaled <= intScale))
+                return -1;
+
+            const auto value = static_cast<int32_t> (scaled);
+
+            if (static_cast<float> (value) != scaled)
+                return -1;
+
+            if (i > 0)
+                allBits |= zigzag (value - previous);
+
+            previous = value;
+        }
+
+        int numBits = 0;
+
+        for (; allBits != 0; allBits >>= 1)
+            ++numBits;
+
+        return numBits;
+    }
+
+    /** The first value, the number of bits, then the packed deltas. */
+    static size_t getPackedSize (int numFrames, int numBits)
+    {
+        return sizeof (int32_t) + 1 + (static_cast<size_t> (numFrames - 1) * static_cast<size_t> (numBits) + 7) / 8;
+    }
+
+    static char* pack (const float* data, int numFrames, int numBits, char* dest) noexcept
+    {
+        auto previous = static_cast<int32_t> (data[0] * intScale);
+        std::memcpy (dest, &previous, sizeof (previous));
+        dest[sizeof (previous)] = static_cast<char> (numBits);
+
+        auto out = reinterpret_cast<uint8_t*> (dest + sizeof (previous) + 1);
+        uint64_t bits = 0;
+        int numBitsPending = 0;
+
+        for (int i = 1; i < numFrames; ++i)
+        {
+            const auto value = static_cast<int32_t> (data[i] * intScale);
+            bits |= static_cast<uint64_t> (zigzag (value - previous)) << numBitsPending;
+            numBitsPending += numBits;
+            previous = value;
+
+            for (; numBitsPending >= 8; numBitsPending -= 8)
+            {
+                *out++ = static_cast<uint8_t> (bits);
+                bits >>= 8;
+            }
+        }
+
+        if (numBitsPending > 0)
+            *out++ = static_cast<uint8_t> (bits);
+
+        return reinterpret_cast<char*> (out);
+    }
+
+    static const char* unpack (const char* src, int numFrames, float* dest) noexcept
+    {
+        int32_t value;
+        std::memcpy (&value, src, sizeof (value));
+        const int numBits = static_cast<uint8_t> (src[sizeof (value)]);
+        const auto mask = static_cast<uint64_t> ((1u << numBits) - 1);
+
+        auto in = reinterpret_cast<const uint8_t*> (src + sizeof (value) + 1);
+        uint64_t bits = 0;
+        int numBitsAvailable = 0;
+        dest[0] = static_cast<float> (value) / intScale;
+
+        for (int i = 1; i < numFrames; ++i)
+        {
+            for (; numBitsAvailable < numBits; numBitsAvailable += 8)
+                bits |= static_cast<uint64_t> (*in++) << numBitsAvailable;
+
+            value += unzigzag (static_cast<uint32_t> (bits & mask));
+            bits >>= numBits;
+            numBitsAvailable -= numBits;
+            dest[i] = static_cast<float> (value) / intScale;
+        }
+
+        return reinterpret_cast<const char*> (in);
+    }
+}
+
+//==============================================================================
+void ChunkedAudioRing::prepare (const Options& newOptions)
+{
+    CRASH_TRACER
+    using namespace chunked_audio_ring;
+
+    options = newOptions;
+    jassert (options.numChannels > 0 && options.numFramesPerChunk > 1);
+    options.numChannels = std::max (1, options.numChannels);
+    options.numFramesPerChunk = std::max (2, options.numFramesPerChunk);
+
+    const auto numChannels = static_cast<size_t> (options.numChannels);
+    const auto numFramesPerChunk = options.numFramesPerChunk;
+    maxNumFrames = std::max<SampleCount> (1, static_cast<SampleCount> (std::ceil (options.lengthInSeconds * options.sampleRate)));
+
+    // There's one more chunk than needed as the oldest will usually be partly outside the time window
+    const auto numChunksNeeded = static_cast<size_t> ((maxNumFrames + numFramesPerChunk - 1) / numFramesPerChunk) + 1;
+    const auto numFloatBytes = alignUp (numChannels * static_cast<size_t> (numFramesPerChunk) * sizeof (float));
+
+    // Chunks aren't split across segments, but as no chunk is bigger than a float one a full segment
+    // always holds at least numChunksPerSegment of them. So this is enough for the whole length even if
+    // none of the chunks can be encoded, plus one segment being written and one being dropped.
+    const auto numChunksPerSegment = std::min (maxNumChunksPerSegment, numChunksNeeded);
+    const auto maxNumSegments = (numChunksNeeded + numChunksPerSegment - 1) / numChunksPerSegment + 2;
+
+    const juce::ScopedLock sl (allocationLock);
+    segmentSize = numChunksPerSegment * numFloatBytes;
+    segments.clear();
+    segments.resize (maxNumSegments);
+
+    // Float chunks will need all of them so there's no point growing
+    const auto numToAllocate = options.encodeChunks ? std::min (numInitialSegments, maxNumSegments)
+                                                    : maxNumSegments;
+
+    for (size_t i = 0; i < numToAllocate; ++i)
+        segments[i].allocate (segmentSize, false);
+
+    numSegmentsAllocated = numToAllocate;
+    needsMoreSegments = false;
+
+    chunks.assign (numChunksNeeded + 2, {});
+    pendingChunk.setSize (options.numChannels, numFramesPerChunk);
+    channelBits.assign (numChannels, 0);
+
+    reset();
+}
+
+void ChunkedAudioRing::reset() noexcept
+{
+    oldestChunk = 0;
+    numChunks = 0;
+    writeSegment = 0;
+    writeOffset = 0;
+    numPendingFrames = 0;
+    totalFramesWritten = 0;
+    numFramesInChunks = 0;
+    numBytesUsed = 0;
+    numFramesStored = 0;
+}
+
+//==============================================================================
+void ChunkedAudioRing::write (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    if (segmentSize == 0)
+    {
+        jassertfalse; // Not prepared
+        return;
+    }
+
+    const auto numChannelsToCopy = std::min (buffer.getNumChannels(), options.numChannels);
+
+    while (numSamples > 0)
+    {
+        const auto numThisTime = std::min (numSamples, options.numFramesPerChunk - numPendingFrames);
+
+        for (int chan = 0; chan < options.numChannels; ++chan)
+        {
+            if (chan < numChannelsToCopy)
+                pendingChunk.copyFrom (chan, numPendingFrames, buffer, chan, startSample, numThisTime);
+            else
+                pendingChunk.clear (chan, numPendingFrames, numThisTime);
+        }
+
+        numPendingFrames += numThisTime;
+        totalFramesWritten += numThisTime;
+        startSample += numThisTime;
+        numSamples -= numThisTime;
+
+        if (numPendingFrames == options.numFramesPerChunk)
+            storePendingChunk();
+    }
+
+    numFramesStored = getAvailableRange().getLength();
+}
+
+const ChunkedAudioRing::ChunkInfo& ChunkedAudioRing::getChunk (size_t index) const noexcept
+{
+    jassert (index < numChunks);
+    return chunks[(oldestChunk + index) % chunks.size()];
+}
+
+void ChunkedAudioRing::storePendingChunk() noexcept
+{
+    using namespace chunked_audio_ring;
+
+    const auto numFrames = numPendingFrames;
+    ChunkInfo info;
+    info.startFrame = totalFramesWritten - numFrames;
+    info.numFrames = numFrames;
+
+    if (options.encodeChunks)
+    {
+        size_t numPackedBytes = 0;
+        info.encoding = Encoding::packed24;
+
+        for (int chan = 0; chan < options.numChannels; ++chan)
+        {
+            const auto numBits = getNumPackedBits (pendingChunk.getReadPointer (chan), numFrames);
+
+            if (numBits < 0)
+            {
+                info.encoding = Encoding::floats;
+                break;
+            }
+
+            channelBits[static_cast<size_t> (chan)] = numBits;
+            numPackedBytes += getPackedSize (numFrames, numBits);
+        }
+
+        info.numBytes = alignUp (numPackedBytes);
+    }
+
+    if (info.encoding == Encoding::floats)
+        info.numBytes = alignUp (static_cast<size_t> (options.numChannels * numFrames) * sizeof (float));
+
+    auto dest = allocate (info.numBytes);
+    info.segment = writeSegment;
+    info.offset = writeOffset - info.numBytes;
+
+    for (int chan = 0; chan < options.numChannels; ++chan)
+    {
+        if (info.encoding == Encoding::packed24)
+        {
+            dest = pack (pendingChunk.getReadPointer (chan), numFrames, channelBits[static_cast<size_t> (chan)], dest);
+        }
+        else
+        {
+            std::memcpy (dest, pendingChunk.getReadPointer (chan), static_cast<size_t> (numFrames) * sizeof (float));
+            dest += static_cast<size_t> (numFrames) * sizeof (float);
+        }
+    }
+
+    if (numChunks == chunks.size())
+        removeOldestChunk();
+
+    chunks[(oldestChunk + numChunks) % chunks.size()] = info;
+    ++numChunks;
+    numFramesInChunks += numFrames;
+    numBytesUsed += info.numBytes;
+    numPendingFrames = 0;
+
+    // Drop any chunks that are entirely outside the time window
+    while (numChunks > 1 && numFramesInChunks - getChunk (0).numFrames >= maxNumFrames)
+        removeOldestChunk();
+
+    // Ask for another segment before the space runs out, allowing for the gaps at the ends of segments
+    const auto numSegments = numSegmentsAllocated.load (std::memory_order_acquire);
+
+    if (numSegments < segments.size()
+        && numBytesUsed + 2 * segmentSize > numSegments * segmentSize)
+        needsMoreSegments = true;
+}
+
+char* ChunkedAudioRing::allocate (size_t numBytes) noexcept
+{
+    jassert (numBytes <= segmentSize);
+
+    if (writeOffset + numBytes > segmentSize)
+    {
+        // Chunks are never split so the space at the end of the segment is skipped.
+        // Anything stored there is the oldest audio so is dropped first.
+        while (numChunks > 0 && getChunk (0).segment == writeSegment && getChunk (0).offset >= writeOffset)
+            removeOldestChunkToMakeRoom();
+
+        // Any segment added since the last pass is empty, so it's next in age order and can be
+        // written before the ones wrapped around to
+        writeSegment = (writeSegment + 1) % numSegmentsAllocated.load (std::memory_order_acquire);
+        writeOffset = 0;
+    }
+
+    // The oldest chunks always follow the write position so only they can be in the way
+    while (numChunks > 0)
+    {
+        auto& oldest = getChunk (0);
+
+        if (oldest.segment != writeSegment
+            || oldest.offset >= writeOffset + numBytes
+            || writeOffset >= oldest.offset + oldest.numBytes)
+            break;
+
+        removeOldestChunkToMakeRoom();
+    }
+
+    auto dest = segments[writeSegment].get() + writeOffset;
+    writeOffset += numBytes;
+    return dest;
+}
+
+bool ChunkedAudioRing::allocateMoreIfNeeded()
+{
+    if (! needsMoreSegments.exchange (false))
+        return false;
+
+    const juce::ScopedLock sl (allocationLock);
+    const auto numSegments = numSegmentsAllocated.load();
+
+    if (numSegments >= segments.size())
+        return false;
+
+    segments[numSegments].allocate (segmentSize, false);
+    numSegmentsAllocated.store (numSegments + 1, std::memory_order_release);
+    return true;
+}
+
+void ChunkedAudioRing::removeOldestChunk() noexcept
+{
+    jassert (numChunks > 0);
+    auto& oldest = chunks[oldestChunk];
+    numBytesUsed -= oldest.numBytes;
+    numFramesInChunks -= oldest.numFrames;
+    oldestChunk = (oldestChunk + 1) % chunks.size();
+    --numChunks;
+}
+
+void ChunkedAudioRing::removeOldestChunkToMakeRoom() noexcept
+{
+    // If this is still inside the time window the ring has run out of space
+    if (numFramesInChunks - getChunk (0).numFrames < maxNumFrames
+        && numSegmentsAllocated.load (std::memory_order_acquire) < segments.size())
+        needsMoreSegments = true;
+
+    removeOldestChunk();
+}
+
+//==============================================================================
+SampleRange ChunkedAudioRing::getAvailableRange() const noexcept
+{
+    const auto oldestFrame = numChunks > 0 ? getChunk (0).startFrame
+                                           : totalFramesWritten - numPendingFrames;
+
+    return { std::max (oldestFrame, totalFramesWritten - maxNumFrames), totalFramesWritten };
+}
+
+template<typename Visitor>
+bool ChunkedAudioRing::visitRange (SampleRange range, Visitor&& visitor) const
+{
+    using namespace chunked_audio_ring;
+
+    if (range.isEmpty())
+        return true;
+
+    if (! getAvailableRange().contains (range))
+        return false;
+
+    const auto numChannels = options.numChannels;
+    std::vector<float*> channels (static_cast<size_t> (numChannels));
+    juce::AudioBuffer<float> decoded;
+
+    auto visitOverlap = [&] (juce::AudioBuffer<float>& chunkData, SampleCount chunkStart)
+    {
+        const auto overlap = SampleRange::withStartAndLength (chunkStart, chunkData.getNumSamples()).getIntersectionWith (range);
+
+        return overlap.isEmpty()
+                || visitor (chunkData, static_cast<int> (overlap.getStart() - chunkStart), static_cast<int> (overlap.getLength()));
+    };
+
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        auto& chunk = getChunk (i);
+
+        if (chunk.startFrame + chunk.numFrames <= range.getStart())
+            continue;
+
+        if (chunk.startFrame >= range.getEnd())
+            break;
+
+        auto src = segments[chunk.segment].get() + chunk.offset;
+
+        if (chunk.encoding == Encoding::floats)
+        {
+            // Refer to the stored samples rather than copying them
+            for (int chan = 0; chan < numChannels; ++chan)
+                channels[static_cast<size_t> (chan)] = reinterpret_cast<float*> (src) + chan * chunk.numFrames;
+
+            juce::AudioBuffer<float> chunkData (channels.data(), numChannels, chunk.numFrames);
+
+            if (! visitOverlap (chunkData, chunk.startFrame))
+                return false;
+        }
+        else
+        {
+            decoded.setSize (numChannels, chunk.numFrames, false, false, true);
+            const char* packed = src;
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                packed = unpack (packed, chunk.numFrames, decoded.getWritePointer (chan));
+
+            if (! visitOverlap (decoded, chunk.startFrame))
+                return false;
+        }
+    }
+
+    if (numPendingFrames > 0)
+    {
+        for (int chan = 0; chan < numChannels; ++chan)
+            channels[static_cast<size_t> (chan)] = const_cast<float*> (pendingChunk.getReadPointer (chan));
+
+        juce::AudioBuffer<float> chunkData (channels.data(), numChannels, numPendingFrames);
+
+        if (! visitOverlap (chunkData, totalFramesWritten - numPendingFrames))
+            return false;
+    }
+
+    return true;
+}
+
+bool ChunkedAudioRing::read (SampleCount startFrame, juce::AudioBuffer<float>& dest, int destStartSample, int numFrames) const
+{
+    jassert (dest.getNumChannels() >= options.numChannels && destStartSample + numFrames <= dest.getNumSamples());
+
+    return visitRange (SampleRange::withStartAndLength (startFrame, numFrames),
+                       [&] (juce::AudioBuffer<float>& chunkData, int start, int num)
+                       {
+                           for (int chan = 0; chan < options.numChannels; ++chan)
+                               dest.copyFrom (chan, destStartSample, chunkData, chan, start, num);
+
+                           destStartSample += num;
+                           return true;
+                       });
+}
+
+bool ChunkedAudioRing::writeTo (AudioFileWriter& writer, SampleRange range) const
+{
+    CRASH_TRACER
+    std::vector<float*> channels (static_cast<size_t> (options.numChannels));
+
+    return visitRange (range,
+                       [&] (juce::AudioBuffer<float>& chunkData, int start, int num)
+                       {
+                           if (start == 0)
+                               return writer.appendBuffer (chunkData, num);
+
+                           for (int chan = 0; chan < options.numChannels; ++chan)
+                               channels[static_cast<size_t> (chan)] = chunkData.getWritePointer (chan, start);
+
+                           juce::AudioBuffer<float> section (channels.data(), options.numChannels, num);
+                           return writer.appendBuffer (section, num);
+                       });
+}
+
+//==============================================================================
+ChunkedAudioRing::MemoryUsage ChunkedAudioRing::getMemoryUsage() const noexcept
+{
+    MemoryUsage usage;
+    const auto fixedSize = static_cast<size_t> (pendingChunk.getNumChannels() * pendingChunk.getNumSamples()) * sizeof (float)
+                             + chunks.size() * sizeof (ChunkInfo);
+
+    usage.numBytesAllocated = numSegmentsAllocated * segmentSize + fixedSize;
+    usage.maxNumBytesAllocated = segments.size() * segmentSize + fixedSize;
+    usage.numBytesUsed = numBytesUsed;
+    usage.numFramesStored = numFramesStored;
+    usage.numBytesUncompressed = static_cast<size_t> (usage.numFramesStored * options.numChannels) * sizeof (float);
+
+    return usage;
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,153 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Keeps the most recent few seconds of a stream of audio, e.g. for
+    retrospective recording.
+
+    Incoming audio is collected into fixed size chunks which are then stored in a
+    ring of equally sized memory segments, the oldest chunks being dropped to make
+    room for new ones. write() never allocates so can be called on the audio thread.
+
+    If encoding is enabled, chunks whose samples all fit exactly in 24 bits (e.g.
+    integer audio converted to floats without any gain) are stored as bit-packed
+    deltas, which is lossless and usually much smaller than the float data. Other
+    chunks are stored as floats. As there's no way of knowing in advance how much
+    of the audio can be encoded, the ring starts with a few segments and write()
+    flags when it needs more. Call allocateMoreIfNeeded() regularly from another
+    thread to add them. The number of segments is capped at enough to hold the
+    whole length as floats. Without encoding, all of them are allocated up front.
+
+    Any range of the stored audio can be read back or written straight to an
+    AudioFileWriter without copying the whole history. Reading must not happen
+    at the same time as writing so the writer should be paused first, e.g. with
+    InputDevice::setRetrospectiveLock.
+*/
+class ChunkedAudioRing
+{
+public:
+    //==============================================================================
+    /** The size and format of the ring. */
+    struct Options
+    {
+        int numChannels = 2;                ///< The number of channels to store.
+        double sampleRate = 44100.0;        ///< The sample rate of the incoming audio.
+        double lengthInSeconds = 30.0;      ///< How much audio to keep.
+        int numFramesPerChunk = 4096;       ///< The number of frames collected before being stored.
+        bool encodeChunks = true;           ///< Whether to losslessly encode chunks where possible and grow the memory as needed.
+    };
+
+    /** Creates an empty ring. Call prepare() before writing to it. */
+    ChunkedAudioRing() = default;
+
+    /** Allocates the memory for a given set of options and clears the ring. */
+    void prepare (const Options&);
+
+    /** Adds another segment if write() has flagged that the ring is running out of space.
+        Call this regularly from a thread other than the one calling write(), e.g. a timer.
+        Returns true if a segment was added.
+    */
+    bool allocateMoreIfNeeded();
+
+    /** Returns the options the ring was prepared with. */
+    const Options& getOptions() const noexcept              { return options; }
+
+    /** Removes all the stored audio. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Adds some audio to the ring, dropping the oldest audio if it's full.
+        This doesn't allocate or lock so can be called on the audio thread.
+    */
+    void write (const juce::AudioBuffer<float>&, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the range of frames that can be read.
+        Frames are numbered from the last call to prepare() or reset().
+    */
+    SampleRange getAvailableRange() const noexcept;
+
+    /** Reads some frames into a buffer.
+        Returns false if the frames aren't all available.
+    */
+    bool read (SampleCount startFrame, juce::AudioBuffer<float>& dest, int destStartSample, int numFrames) const;
+
+    /** Writes a range of frames to a writer.
+        Chunks stored as floats are passed to the writer directly, encoded ones are
+        decoded a chunk at a time. Returns false if the frames aren't all available
+        or the writer fails.
+    */
+    bool writeTo (AudioFileWriter&, SampleRange) const;
+
+    //==============================================================================
+    /** Describes the memory used by the ring. */
+    struct MemoryUsage
+    {
+        size_t numBytesAllocated = 0;       ///< The memory currently allocated.
+        size_t maxNumBytesAllocated = 0;    ///< The most that will be allocated, which is enough for the whole length as floats.
+        size_t numBytesUsed = 0;            ///< The memory holding stored chunks.
+        size_t numBytesUncompressed = 0;    ///< The size the stored chunks would be as floats.
+        SampleCount numFramesStored = 0;    ///< The number of frames that can be read.
+    };
+
+    /** Returns the current memory usage. This can be called from any thread. */
+    MemoryUsage getMemoryUsage() const noexcept;
+
+private:
+    //==============================================================================
+    enum class Encoding : uint8_t
+    {
+        floats,
+        packed24
+    };
+
+    struct ChunkInfo
+    {
+        size_t segment = 0, offset = 0, numBytes = 0;
+        SampleCount startFrame = 0;
+        int numFrames = 0;
+        Encoding encoding = Encoding::floats;
+    };
+
+    Options options;
+    std::vector<juce::HeapBlock<char>> segments;
+    std::atomic<size_t> numSegmentsAllocated { 0 };
+    size_t segmentSize = 0, writeSegment = 0, writeOffset = 0;
+    std::atomic<bool> needsMoreSegments { false };
+    juce::CriticalSection allocationLock;
+
+    std::vector<ChunkInfo> chunks;
+    size_t oldestChunk = 0, numChunks = 0;
+
+    juce::AudioBuffer<float> pendingChunk;
+    std::vector<int> channelBits;
+    int numPendingFrames = 0;
+    SampleCount maxNumFrames = 0, totalFramesWritten = 0, numFramesInChunks = 0;
+
+    std::atomic<size_t> numBytesUsed { 0 };
+    std::atomic<SampleCount> numFramesStored { 0 };
+
+    const ChunkInfo& getChunk (size_t index) const noexcept;
+    void storePendingChunk() noexcept;
+    char* allocate (size_t numBytes) noexcept;
+    void removeOldestChunk() noexcept;
+    void removeOldestChunkToMakeRoom() noexcept;
+
+    template<typename Visitor>
+    bool visitRange (SampleRange, Visitor&&) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChunkedAudioRing)
+};
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,289 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_CHUNKED_AUDIO_RING
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    namespace
+    {
+        /** Fills a buffer with noise quantised to 24 bits, like audio from an interface. */
+        juce::AudioBuffer<float> create24BitNoise (int numChannels, int numFrames, juce::Random& random)
+        {
+            juce::AudioBuffer<float> buffer (numChannels, numFrames);
+
+            for (int chan = 0; chan < numChannels; ++chan)
+                for (int i = 0; i < numFrames; ++i)
+                    buffer.setSample (chan, i, static_cast<float> (random.nextInt ({ -8388608, 8388608 })) / 8388608.0f);
+
+            return buffer;
+        }
+
+        /** Writes a buffer a block at a time, growing the ring between blocks as an owner's timer would. */
+        void writeInBlocks (ChunkedAudioRing& ring, const juce::AudioBuffer<float>& buffer, int blockSize, bool allowGrowing = true)
+        {
+            for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+            {
+                ring.write (buffer, start, std::min (blockSize, buffer.getNumSamples() - start));
+
+                if (allowGrowing)
+                    ring.allocateMoreIfNeeded();
+            }
+        }
+
+        bool rangeMatches (const ChunkedAudioRing& ring, const juce::AudioBuffer<float>& source, SampleRange range)
+        {
+            const auto numFrames = static_cast<int> (range.getLength());
+            juce::AudioBuffer<float> dest (source.getNumChannels(), numFrames);
+
+            if (! ring.read (range.getStart(), dest, 0, numFrames))
+                return false;
+
+            for (int chan = 0; chan < source.getNumChannels(); ++chan)
+                if (std::memcmp (dest.getReadPointer (chan), source.getReadPointer (chan, static_cast<int> (range.getStart())),
+                                 static_cast<size_t> (numFrames) * sizeof (float)) != 0)
+                    return false;
+
+            return true;
+        }
+    }
+
+    TEST_CASE ("ChunkedAudioRing")
+    {
+        juce::Random random (42);
+        ChunkedAudioRing::Options options;
+        options.numChannels = 2;
+        options.sampleRate = 44100.0;
+        options.lengthInSeconds = 1.0;
+        options.numFramesPerChunk = 1024;
+
+        for (bool encode : { false, true })
+        {
+            options.encodeChunks = encode;
+            ChunkedAudioRing ring;
+            ring.prepare (options);
+
+            SUBCASE ("Round trip")
+            {
+                auto source = create24BitNoise (2, 30'000, random);
+                writeInBlocks (ring, source, 333);
+
+                CHECK_EQ (ring.getAvailableRange(), SampleRange (0, 30'000));
+                CHECK (rangeMatches (ring, source, { 0, 30'000 }));
+
+                // Windows that start and end part way through chunks and include the pending chunk
+                CHECK (rangeMatches (ring, source, { 1'500, 2'100 }));
+                CHECK (rangeMatches (ring, source, { 28'000, 30'000 }));
+                CHECK (! rangeMatches (ring, source, { 29'000, 30'001 }));
+            }
+
+            SUBCASE ("Oldest audio is dropped")
+            {
+                auto source = create24BitNoise (2, 200'000, random);
+                writeInBlocks (ring, source, 512);
+
+                const auto available = ring.getAvailableRange();
+                CHECK_EQ (available, SampleRange (200'000 - 44'100, 200'000));
+                CHECK (rangeMatches (ring, source, available));
+                CHECK_EQ (ring.getMemoryUsage().numFramesStored, 44'100);
+
+                ring.reset();
+                CHECK (ring.getAvailableRange().isEmpty());
+            }
+
+            SUBCASE ("Audio that can't be packed")
+            {
+                juce::AudioBuffer<float> source (2, 100'000);
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = 0; i < source.getNumSamples(); ++i)
+                        source.setSample (chan, i, random.nextFloat() * 2.0f - 1.0f);
+
+                // Add some 24-bit sections so packed and float chunks are mixed
+                source.clear (20'000, 10'000);
+                source.clear (60'000, 5'000);
+
+                writeInBlocks (ring, source, 480);
+                CHECK (rangeMatches (ring, source, ring.getAvailableRange()));
+            }
+        }
+    }
+
+    TEST_CASE ("ChunkedAudioRing: memory usage")
+    {
+        juce::Random random (42);
+        ChunkedAudioRing::Options options;
+        options.numChannels = 2;
+        options.lengthInSeconds = 10.0;
+
+        ChunkedAudioRing floatRing, packedRing;
+        options.encodeChunks = false;
+        floatRing.prepare (options);
+        options.encodeChunks = true;
+        packedRing.prepare (options);
+
+        // A quiet signal packs into far fewer bits per sample
+        juce::AudioBuffer<float> source (2, 44'100 * 5);
+
+        for (int chan = 0; chan < 2; ++chan)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (chan, i, static_cast<float> (random.nextInt ({ -1'000, 1'000 })) / 8388608.0f);
+
+        writeInBlocks (floatRing, source, 512);
+        writeInBlocks (packedRing, source, 512);
+
+        const auto floatUsage = floatRing.getMemoryUsage();
+        const auto packedUsage = packedRing.getMemoryUsage();
+
+        CHECK_EQ (floatUsage.numFramesStored, source.getNumSamples());
+        CHECK_EQ (packedUsage.numFramesStored, source.getNumSamples());
+        CHECK_EQ (floatUsage.numBytesUncompressed, packedUsage.numBytesUncompressed);
+        CHECK (floatUsage.numBytesUsed >= floatUsage.numBytesUncompressed - 4096 * 2 * sizeof (float));
+        CHECK (packedUsage.numBytesUsed < floatUsage.numBytesUsed / 2);
+
+        // The float ring allocates everything up front, the packed one only grows as far as it needs to
+        CHECK_EQ (floatUsage.numBytesAllocated, floatUsage.maxNumBytesAllocated);
+        CHECK_EQ (packedUsage.maxNumBytesAllocated, floatUsage.maxNumBytesAllocated);
+        CHECK (packedUsage.numBytesAllocated < floatUsage.numBytesAllocated / 2);
+        CHECK (packedUsage.numBytesAllocated >= packedUsage.numBytesUsed);
+        CHECK (rangeMatches (packedRing, source, packedRing.getAvailableRange()));
+    }
+
+    TEST_CASE ("ChunkedAudioRing: audio that can't be packed keeps the whole length")
+    {
+        juce::Random random (42);
+
+        for (auto sampleRate : { 44100.0, 96000.0 })
+        {
+            for (auto numFramesPerChunk : { 512, 4096, 5000 })
+            {
+                ChunkedAudioRing::Options options;
+                options.numChannels = 2;
+                options.sampleRate = sampleRate;
+                options.lengthInSeconds = 2.0;
+                options.numFramesPerChunk = numFramesPerChunk;
+                options.encodeChunks = true;
+
+                ChunkedAudioRing ring;
+                ring.prepare (options);
+
+                // Noise with gain applied, so no chunk is whole 24-bit values
+                juce::AudioBuffer<float> source (2, static_cast<int> (sampleRate * 5.0));
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = 0; i < source.getNumSamples(); ++i)
+                        source.setSample (chan, i, (random.nextFloat() * 2.0f - 1.0f) * 0.7f);
+
+                writeInBlocks (ring, source, 480);
+
+                const auto expectedLength = static_cast<SampleCount> (sampleRate * options.lengthInSeconds);
+                const auto available = ring.getAvailableRange();
+                CHECK_EQ (available, SampleRange (source.getNumSamples() - expectedLength, source.getNumSamples()));
+                CHECK (rangeMatches (ring, source, available));
+
+                const auto usage = ring.getMemoryUsage();
+                CHECK_EQ (usage.numFramesStored, expectedLength);
+                CHECK (usage.numBytesUsed >= usage.numBytesUncompressed);
+                CHECK (usage.numBytesAllocated <= usage.maxNumBytesAllocated);
+
+                // Carrying on doesn't grow it past its cap
+                writeInBlocks (ring, source, 480);
+                CHECK_EQ (ring.getAvailableRange().getLength(), expectedLength);
+                CHECK (ring.getMemoryUsage().numBytesAllocated <= usage.maxNumBytesAllocated);
+            }
+        }
+    }
+
+    TEST_CASE ("ChunkedAudioRing: only grows when asked")
+    {
+        juce::Random random (42);
+        ChunkedAudioRing::Options options;
+        options.numChannels = 2;
+        options.lengthInSeconds = 10.0;
+        options.numFramesPerChunk = 1024;
+        options.encodeChunks = true;
+
+        ChunkedAudioRing ring;
+        ring.prepare (options);
+        const auto initialUsage = ring.getMemoryUsage();
+
+        // Without anything adding segments the oldest audio is dropped early, but what's left is intact
+        auto source = create24BitNoise (2, 44'100 * 5, random);
+        writeInBlocks (ring, source, 512, false);
+
+        const auto available = ring.getAvailableRange();
+        CHECK_EQ (ring.getMemoryUsage().numBytesAllocated, initialUsage.numBytesAllocated);
+        CHECK (available.getLength() < source.getNumSamples());
+        CHECK_EQ (available.getEnd(), source.getNumSamples());
+        CHECK (rangeMatches (ring, source, available));
+
+        // Segments added later are filled before the audio wraps around
+        int numAdded = 0;
+
+        while (ring.allocateMoreIfNeeded())
+            ++numAdded;
+
+        CHECK_EQ (numAdded, 1);
+
+        ring.reset();
+        writeInBlocks (ring, source, 512);
+        CHECK_EQ (ring.getAvailableRange(), SampleRange (0, source.getNumSamples()));
+        CHECK (rangeMatches (ring, source, ring.getAvailableRange()));
+        CHECK (ring.getMemoryUsage().numBytesAllocated > initialUsage.numBytesAllocated);
+    }
+
+    TEST_CASE ("ChunkedAudioRing: write to file")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        juce::Random random (42);
+
+        ChunkedAudioRing::Options options;
+        options.numChannels = 2;
+        options.lengthInSeconds = 1.0;
+
+        ChunkedAudioRing ring;
+        ring.prepare (options);
+
+        auto source = create24BitNoise (2, 100'000, random);
+        writeInBlocks (ring, source, 512);
+
+        juce::TemporaryFile tempFile (".wav");
+        juce::WavAudioFormat format;
+        const auto range = SampleRange (60'000, 99'000);
+
+        {
+            // Float files so the samples can be compared exactly
+            AudioFileWriter writer (AudioFile (engine, tempFile.getFile()), &format, 2, options.sampleRate, 32, {}, 0);
+            REQUIRE (writer.isOpen());
+            CHECK (ring.writeTo (writer, range));
+            CHECK (! ring.writeTo (writer, { 0, 100 }));
+        }
+
+        std::unique_ptr<juce::AudioFormatReader> reader (format.createReaderFor (tempFile.getFile().createInputStream().release(), true));
+        REQUIRE (reader != nullptr);
+        CHECK_EQ (reader->lengthInSamples, range.getLength());
+
+        juce::AudioBuffer<float> fileData (2, static_cast<int> (range.getLength()));
+        reader->read (&fileData, 0, fileData.getNumSamples(), 0, true, true);
+
+        for (int chan = 0; chan < 2; ++chan)
+            CHECK (std::memcmp (fileData.getReadPointer (chan), source.getReadPointer (chan, static_cast<int> (range.getStart())),
+                                static_cast<size_t> (fileData.getNumSamples()) * sizeof (float)) == 0);
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
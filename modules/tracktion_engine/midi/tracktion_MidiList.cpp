@@ -676,6 +676,11 @@ struct MidiList::EventDelegate<MidiNote>
     {
         removeMidiEventFromSelection (m);
     }
+
+    static BeatPosition getBeatPosition (const juce::ValueTree& v)
+    {
+        return BeatPosition::fromBeats (static_cast<double> (v.getProperty (IDs::b)));
+    }
 };
 
 //==============================================================================
@@ -909,6 +914,11 @@ struct MidiList::EventDelegate<MidiControllerEvent>
     {
         removeMidiEventFromSelection (e);
     }
+
+    static BeatPosition getBeatPosition (const juce::ValueTree& v)
+    {
+        return BeatPosition::fromBeats (static_cast<double> (v.getProperty (IDs::b)));
+    }
 };
 
 //==============================================================================
@@ -1115,6 +1125,11 @@ struct MidiList::EventDelegate<MidiSysexEvent>
     {
         removeMidiEventFromSelection (m);
     }
+
+    static BeatPosition getBeatPosition (const juce::ValueTree& v)
+    {
+        return BeatPosition::fromBeats (static_cast<double> (v.getProperty (IDs::time)));
+    }
 };
 
 TimePosition MidiSysexEvent::getEditTime (const MidiClip& c) const
@@ -1172,9 +1187,36 @@ void MidiList::initialise (juce::UndoManager* um)
     midiChannel.referTo (state, IDs::channelNumber, um);
     isComp.referTo (state, IDs::isComp, um, false);
 
-    noteList        = std::make_unique<EventList<MidiNote>> (state);
-    controllerList  = std::make_unique<EventList<MidiControllerEvent>> (state);
-    sysexList       = std::make_unique<EventList<MidiSysexEvent>> (state);
+    noteList        = std::make_unique<EventList<MidiNote>> (*this, state);
+    controllerList  = std::make_unique<EventList<MidiControllerEvent>> (*this, state);
+    sysexList       = std::make_unique<EventList<MidiSysexEvent>> (*this, state);
+}
+
+//==============================================================================
+MidiList::ScopedBulkEdit::ScopedBulkEdit (MidiList& l)
+    : list (l)
+{
+    ++list.bulkEditDepth;
+}
+
+MidiList::ScopedBulkEdit::~ScopedBulkEdit()
+{
+    jassert (list.bulkEditDepth > 0);
+
+    if (--list.bulkEditDepth > 0)
+        return;
+
+    list.noteList->updateSortedEvents();
+    list.controllerList->updateSortedEvents();
+    list.sysexList->updateSortedEvents();
+
+    if (list.onBulkEditEnded)
+        list.onBulkEditEnded();
+}
+
+int MidiList::getNumFullSorts() const noexcept
+{
+    return noteList->numFullSorts + controllerList->numFullSorts + sysexList->numFullSorts;
 }
 
 void MidiList::clear (juce::UndoManager* um)
@@ -1246,6 +1288,8 @@ void MidiList::moveAllBeatPositions (BeatDuration delta, juce::UndoManager* um)
 {
     if (delta != BeatDuration())
     {
+        const ScopedBulkEdit bulkEdit (*this);
+
         for (auto e : getNotes())
             e->setStartAndLength (e->getStartBeat() + delta, e->getLengthBeats(), um);
 
@@ -1261,6 +1305,8 @@ void MidiList::rescale (double factor, juce::UndoManager* um)
 {
     if (factor != 1.0 && factor > 0.001 && factor < 1000.0)
     {
+        const ScopedBulkEdit bulkEdit (*this);
+
         for (auto e : getNotes())
             e->setStartAndLength (e->getStartBeat() * factor,
                                   e->getLengthBeats() * factor, um);
@@ -1329,11 +1375,7 @@ BeatPosition MidiList::getLastBeatNumber() const
 
 MidiNote* MidiList::getNoteFor (const juce::ValueTree& s)
 {
-    for (auto n : getNotes())
-        if (n->state == s)
-            return n;
-
-    return {};
+    return noteList->getEventFor (s);
 }
 
 juce::Range<int> MidiList::getNoteNumberRange() const
@@ -1513,11 +1555,7 @@ void MidiList::removeControllersBetween (int controllerType, BeatPosition beatSt
 //==============================================================================
 MidiSysexEvent* MidiList::getSysexEventFor (const juce::ValueTree& v) const
 {
-    for (auto n : getSysexEvents())
-        if (n->state == v)
-            return n;
-
-    return {};
+    return sysexList->getEventFor (v);
 }
 
 MidiSysexEvent& MidiList::addSysExEvent (const juce::MidiMessage& message, BeatPosition beat, juce::UndoManager* um)
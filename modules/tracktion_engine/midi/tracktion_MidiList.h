@@ -68,6 +68,35 @@ public:
     void moveAllBeatPositions (BeatDuration deltaBeats, juce::UndoManager*);
     void rescale (double factor, juce::UndoManager*);
 
+    //==============================================================================
+    /** Groups together a set of edits that move lots of events at once.
+
+        Normally, each event that moves is remembered and merged back into place
+        the next time the events are asked for. Whilst one of these is in scope the
+        individual moves aren't tracked and the lists are re-sorted once when the
+        outermost one ends, which is cheaper when most of the events change.
+        Owners listening to the events can also check isInBulkEdit() and use
+        onBulkEditEnded to respond once rather than for every event.
+    */
+    struct ScopedBulkEdit
+    {
+        ScopedBulkEdit (MidiList&);
+        ~ScopedBulkEdit();
+
+        MidiList& list;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBulkEdit)
+    };
+
+    /** Returns true if a ScopedBulkEdit is active for this list. */
+    bool isInBulkEdit() const noexcept                              { return bulkEditDepth > 0; }
+
+    /** Called when the outermost ScopedBulkEdit for this list ends. */
+    std::function<void()> onBulkEditEnded;
+
+    /** @internal Returns the number of times the events have been fully re-sorted. N.B. For testing only. */
+    int getNumFullSorts() const noexcept;
+
     //==============================================================================
     int getNumNotes() const                                         { return getNotes().size(); }
     MidiNote* getNote (int index) const                             { return getNotes()[index]; }
@@ -195,6 +224,7 @@ private:
 
     juce::String importedFileName;
     juce::String importedName;
+    int bulkEditDepth = 0;
 
     void initialise (juce::UndoManager*);
 
@@ -205,68 +235,220 @@ private:
         /** Return true if the order may have changed. */
         static bool updateObject (EventType&, const juce::Identifier&);
         static void removeFromSelection (EventType*);
+        /** Returns the position the event for this state will be sorted by. */
+        static BeatPosition getBeatPosition (const juce::ValueTree&);
     };
 
+    /** Keeps the events of one type and a copy of them sorted by time.
+
+        Each event has a listener on its own state so property changes go straight
+        to it rather than having to search for the event. Lookups from a state go
+        through a hash index of the events by beat position, as juce::ValueTree has
+        no identity that can be hashed, so they never need the list to be sorted.
+        When an event moves, only that event is taken out and merged back into the
+        sorted list, and this is deferred until the list is next asked for so the
+        array isn't changed whilst a caller is iterating it.
+    */
     template<typename EventType>
-    struct EventList : public ValueTreeObjectList<EventType>
+    struct EventList : public IndexedValueTreeObjectList<EventType>
     {
-        EventList (const juce::ValueTree& v)
-            : ValueTreeObjectList<EventType> (v)
+        EventList (MidiList& l, const juce::ValueTree& v)
+            : IndexedValueTreeObjectList<EventType> (v), owner (l)
         {
-            ValueTreeObjectList<EventType>::rebuildObjects();
+            IndexedValueTreeObjectList<EventType>::rebuildObjects();
         }
 
         ~EventList() override
         {
-            ValueTreeObjectList<EventType>::freeObjects();
+            IndexedValueTreeObjectList<EventType>::freeObjects();
         }
 
         EventType* getEventFor (const juce::ValueTree& v)
         {
-            for (auto m : ValueTreeObjectList<EventType>::objects)
-                if (m->state == v)
-                    return m;
+            // Events are usually looked up straight after they've been added
+            if (lastAdded != nullptr && lastAdded->state == v)
+                return lastAdded;
+
+            {
+                const juce::ScopedLock sl (lock);
+                auto range = eventsByBeat.equal_range (EventDelegate<EventType>::getBeatPosition (v).inBeats());
+
+                for (auto iter = range.first; iter != range.second; ++iter)
+                    if (iter->second->state == v)
+                        return iter->second;
+            }
 
-            return {};
+            // The state may have changed without the event being updated yet if this
+            // is called from another listener to the same tree
+            return IndexedValueTreeObjectList<EventType>::getObjectFor (v);
         }
 
         bool isSuitableType (const juce::ValueTree& v) const override   { return EventDelegate<EventType>::isSuitableType (v); }
-        EventType* createNewObject (const juce::ValueTree& v) override  { return new EventType (v); }
-        void deleteObject (EventType* m) override                       { delete m; }
-        void newObjectAdded (EventType*) override                       { triggerSort(); }
-        void objectRemoved (EventType* m) override                      { EventDelegate<EventType>::removeFromSelection (m); triggerSort(); }
+
+        EventType* createNewObject (const juce::ValueTree& v) override
+        {
+            auto e = new EventType (v);
+            eventListeners[e] = std::make_unique<EventListener> (*this, *e);
+
+            const juce::ScopedLock sl (lock);
+            eventsByBeat.emplace (e->getBeatPosition().inBeats(), e);
+
+            return e;
+        }
+
+        void deleteObject (EventType* m) override
+        {
+            eventListeners.erase (m);
+            removeFromIndex (*m, m->getBeatPosition());
+            delete m;
+        }
+
+        void newObjectAdded (EventType* m) override
+        {
+            lastAdded = m;
+            eventMoved (*m);
+        }
+
+        void objectRemoved (EventType* m) override
+        {
+            EventDelegate<EventType>::removeFromSelection (m);
+
+            if (lastAdded == m)
+                lastAdded = nullptr;
+
+            triggerSort();
+        }
+
         void objectOrderChanged() override                              { triggerSort(); }
 
-        void valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& i) override
+        void eventPropertyChanged (EventType& e, const juce::Identifier& i)
         {
-            if (auto e = getEventFor (v))
-                if (EventDelegate<EventType>::updateObject (*e, i))
-                    triggerSort();
+            const auto oldBeat = e.getBeatPosition();
+            const bool mayHaveMoved = EventDelegate<EventType>::updateObject (e, i);
+
+            if (e.getBeatPosition() != oldBeat)
+            {
+                const juce::ScopedLock sl (lock);
+                removeFromIndex (e, oldBeat);
+                eventsByBeat.emplace (e.getBeatPosition().inBeats(), &e);
+            }
+
+            if (mayHaveMoved)
+                eventMoved (e);
+        }
+
+        void removeFromIndex (EventType& e, BeatPosition beat)
+        {
+            const juce::ScopedLock sl (lock);
+            auto range = eventsByBeat.equal_range (beat.inBeats());
+
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if (iter->second == &e)
+                {
+                    eventsByBeat.erase (iter);
+                    return;
+                }
+            }
+
+            jassertfalse;
+        }
+
+        void eventMoved (EventType& e)
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (needsSorting)
+                return;
+
+            // Once most of the list has moved, a full sort is cheaper than merging
+            if (owner.isInBulkEdit()
+                || movedEvents.size() >= (size_t) IndexedValueTreeObjectList<EventType>::objects.size() / 2)
+            {
+                triggerSort();
+                return;
+            }
+
+            movedEvents.push_back (&e);
         }
 
         void triggerSort()
         {
             const juce::ScopedLock sl (lock);
             needsSorting = true;
+            movedEvents.clear();
         }
 
-        const juce::Array<EventType*>& getSortedList()
+        void updateSortedEvents()
         {
-            TRACKTION_ASSERT_MESSAGE_THREAD
-
             const juce::ScopedLock sl (lock);
 
             if (needsSorting)
             {
                 needsSorting = false;
-                sortedEvents = ValueTreeObjectList<EventType>::objects;
+                sortedEvents = IndexedValueTreeObjectList<EventType>::objects;
                 sortMidiEventsByTime (sortedEvents);
+                ++numFullSorts;
+                return;
             }
 
+            if (movedEvents.empty())
+                return;
+
+            std::sort (movedEvents.begin(), movedEvents.end());
+            movedEvents.erase (std::unique (movedEvents.begin(), movedEvents.end()), movedEvents.end());
+
+            // Take the moved events out (new ones won't be there yet) then merge them back in
+            sortedEvents.removeIf ([this] (EventType* e) { return std::binary_search (movedEvents.begin(), movedEvents.end(), e); });
+
+            const auto numUnmoved = sortedEvents.size();
+            auto isEarlier = [] (EventType* a, EventType* b) { return a->getBeatPosition() < b->getBeatPosition(); };
+            std::sort (movedEvents.begin(), movedEvents.end(), isEarlier);
+            sortedEvents.addArray (movedEvents.data(), (int) movedEvents.size());
+            std::inplace_merge (sortedEvents.begin(), sortedEvents.begin() + numUnmoved, sortedEvents.end(), isEarlier);
+
+            movedEvents.clear();
+        }
+
+        const juce::Array<EventType*>& getSortedList()
+        {
+            TRACKTION_ASSERT_MESSAGE_THREAD
+
+            updateSortedEvents();
             return sortedEvents;
         }
 
+        struct EventListener  : public juce::ValueTree::Listener
+        {
+            EventListener (EventList& l, EventType& e)
+                : list (l), event (e)
+            {
+                event.state.addListener (this);
+            }
+
+            ~EventListener() override
+            {
+                event.state.removeListener (this);
+            }
+
+            void valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& i) override
+            {
+                if (v == event.state)
+                    list.eventPropertyChanged (event, i);
+            }
+
+            EventList& list;
+            EventType& event;
+        };
+
+        MidiList& owner;
+        std::unordered_map<EventType*, std::unique_ptr<EventListener>> eventListeners;
+        std::unordered_multimap<double, EventType*> eventsByBeat;
+        EventType* lastAdded = nullptr;
+
         bool needsSorting = true;
+        int numFullSorts = 0;
+        std::vector<EventType*> movedEvents;
         juce::Array<EventType*> sortedEvents;
         juce::CriticalSection lock;
 
@@ -55,6 +55,136 @@ public:
             um->dispatchPendingMessages();
             expect (edit->hasChangedSinceSaved());
         }
+
+        beginTest ("Sorted order and lookups after moving notes");
+        {
+            auto& engine = *Engine::getEngines()[0];
+            auto edit = createTestEdit (engine);
+            auto um = &edit->getUndoManager();
+            auto track = getAudioTracks (*edit)[0];
+            auto mc = insertMIDIClip (*track, { 0_tp, 4_tp });
+            auto& list = mc->getSequence();
+            juce::Random r (42);
+
+            auto expectSortedAndFindable = [this, &list]
+            {
+                auto& notes = list.getNotes();
+                bool sorted = true, findable = true;
+
+                for (int i = 0; i < notes.size(); ++i)
+                {
+                    if (i > 0 && notes[i - 1]->getStartBeat() > notes[i]->getStartBeat())
+                        sorted = false;
+
+                    if (list.getNoteFor (notes[i]->state) != notes[i])
+                        findable = false;
+                }
+
+                expect (sorted);
+                expect (findable);
+            };
+
+            for (int i = 0; i < 200; ++i)
+                list.addNote (60 + r.nextInt (12), BeatPosition::fromBeats (r.nextInt (64) * 0.25), 0.25_bd, 100, 0, um);
+
+            expectEquals (list.getNumNotes(), 200);
+            expectSortedAndFindable();
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto note = list.getNote (r.nextInt (list.getNumNotes()));
+                note->setStartAndLength (BeatPosition::fromBeats (r.nextInt (64) * 0.25), note->getLengthBeats(), um);
+
+                if (r.nextBool())
+                    list.addNote (72, BeatPosition::fromBeats (r.nextInt (64) * 0.25), 0.25_bd, 100, 0, um);
+
+                if (r.nextInt (4) == 0)
+                    list.removeNote (*list.getNote (r.nextInt (list.getNumNotes())), um);
+
+                expectSortedAndFindable();
+            }
+
+            {
+                const MidiList::ScopedBulkEdit bulkEdit (list);
+
+                for (auto note : juce::Array<MidiNote*> (list.getNotes()))
+                    note->setStartAndLength (BeatPosition::fromBeats (r.nextInt (64) * 0.25), note->getLengthBeats(), um);
+            }
+
+            expectSortedAndFindable();
+
+            edit->getUndoManager().undo();
+            expectSortedAndFindable();
+
+            expect (list.getNoteFor (juce::ValueTree (IDs::NOTE)) == nullptr);
+        }
+
+        beginTest ("Quantising 10k notes sorts the list once");
+        {
+            MidiList list (MidiList::createMidiList(), nullptr);
+            juce::Random r (42);
+
+            for (int i = 0; i < 10'000; ++i)
+                list.addNote (r.nextInt (128), BeatPosition::fromBeats (r.nextDouble() * 1000.0), 0.1_bd, 100, 0, nullptr);
+
+            juce::Array<juce::ValueTree> noteStates;
+
+            for (auto n : list.getNotes())
+                noteStates.add (n->state);
+
+            // Looks each note up from its state then moves it, as quantising from a selection does
+            auto quantise = [&list, &noteStates] (BeatDuration offset)
+            {
+                for (auto& v : noteStates)
+                    if (auto n = list.getNoteFor (v))
+                        n->setStartAndLength (BeatPosition::fromBeats (std::round (n->getStartBeat().inBeats() * 4.0) / 4.0) + offset,
+                                              n->getLengthBeats(), nullptr);
+            };
+
+            auto expectSortedAndFindable = [this, &list, &noteStates]
+            {
+                auto& notes = list.getNotes();
+                bool sorted = true, findable = true;
+
+                for (int i = 1; i < notes.size(); ++i)
+                    if (notes[i - 1]->getStartBeat() > notes[i]->getStartBeat())
+                        sorted = false;
+
+                for (auto& v : noteStates)
+                    if (list.getNoteFor (v) == nullptr)
+                        findable = false;
+
+                expect (sorted);
+                expect (findable);
+            };
+
+            int numBulkEditsEnded = 0;
+            list.onBulkEditEnded = [&numBulkEditsEnded] { ++numBulkEditsEnded; };
+
+            const auto numSortsBefore = list.getNumFullSorts();
+            quantise (0_bd);
+            expectEquals (list.getNumFullSorts(), numSortsBefore);
+            expectSortedAndFindable();
+            expectEquals (list.getNumFullSorts(), numSortsBefore + 1);
+
+            {
+                const MidiList::ScopedBulkEdit bulkEdit (list);
+
+                {
+                    const MidiList::ScopedBulkEdit nestedBulkEdit (list);
+                    quantise (0.25_bd);
+                }
+
+                quantise (0.25_bd);
+                expectEquals (list.getNumFullSorts(), numSortsBefore + 1);
+                expectEquals (numBulkEditsEnded, 0);
+            }
+
+            expectEquals (list.getNumFullSorts(), numSortsBefore + 2);
+            expectEquals (numBulkEditsEnded, 1);
+            expectSortedAndFindable();
+            expectEquals (list.getNumFullSorts(), numSortsBefore + 2);
+        }
     }
 };
 
@@ -63,3 +193,135 @@ static MidiListTests midiListTests;
 }} // namespace tracktion { inline namespace engine
 
 #endif
+
+//==============================================================================
+//==============================================================================
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_MIDILIST
+
+#include "../../tracktion_graph/tracktion_graph/tracktion_TestUtilities.h"
+
+namespace tracktion { inline namespace engine
+{
+
+//==============================================================================
+//==============================================================================
+class MidiListBenchmarks  : public juce::UnitTest
+{
+public:
+    MidiListBenchmarks()
+        : juce::UnitTest ("MidiList", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        runEditingBenchmarks();
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    void runEditingBenchmarks()
+    {
+        // Add 50k notes to a clip then time the sorts of bulk edits that
+        // quantising and transposing perform, with and without undo
+
+        auto& engine = *tracktion::engine::Engine::getEngines()[0];
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto um = &edit->getUndoManager();
+        juce::Random r (42);
+
+        beginTest ("Benchmark: MidiList editing");
+        {
+            constexpr int numNotes = 50'000;
+            auto c = getAudioTracks (*edit)[0]->insertMIDIClip ({ 0.0s, TimePosition (60s) }, nullptr);
+            auto& list = c->getSequence();
+
+            {
+                ScopedBenchmark sb (getDescription ("Add 50k notes"));
+
+                for (int i = 0; i < numNotes; ++i)
+                    list.addNote (r.nextInt (128), BeatPosition::fromBeats (r.nextDouble() * 1000.0), 0.1_bd, 100, 0, nullptr);
+            }
+
+            juce::Array<juce::ValueTree> noteStates;
+
+            for (auto n : list.getNotes())
+                noteStates.add (n->state);
+
+            {
+                ScopedBenchmark sb (getDescription ("Find 50k notes from their state"));
+
+                for (auto& v : noteStates)
+                    expect (list.getNoteFor (v) != nullptr);
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Transpose 50k notes"));
+                edit->getUndoManager().beginNewTransaction();
+
+                for (auto& v : noteStates)
+                    if (auto n = list.getNoteFor (v))
+                        n->setNoteNumber (127 - n->getNoteNumber(), um);
+            }
+
+            auto quantise = [] (MidiNote& n)
+            {
+                return BeatPosition::fromBeats (std::round (n.getStartBeat().inBeats() * 4.0) / 4.0);
+            };
+
+            {
+                ScopedBenchmark sb (getDescription ("Quantise 50k notes"));
+                edit->getUndoManager().beginNewTransaction();
+
+                for (auto& v : noteStates)
+                    if (auto n = list.getNoteFor (v))
+                        n->setStartAndLength (quantise (*n), n->getLengthBeats(), um);
+
+                expectEquals (list.getNumNotes(), numNotes);
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Quantise 50k notes in a bulk edit"));
+                edit->getUndoManager().beginNewTransaction();
+                const MidiList::ScopedBulkEdit bulkEdit (list);
+
+                for (auto& v : noteStates)
+                    if (auto n = list.getNoteFor (v))
+                        n->setStartAndLength (quantise (*n) + 0.25_bd, n->getLengthBeats(), um);
+
+                expectEquals (list.getNumNotes(), numNotes);
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Move 100 notes, reading the list after each"));
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    auto n = list.getNote (r.nextInt (numNotes));
+                    n->setStartAndLength (BeatPosition::fromBeats (r.nextDouble() * 1000.0), n->getLengthBeats(), nullptr);
+                    expectEquals (list.getNumNotes(), numNotes);
+                }
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Undo all edits"));
+
+                while (edit->getUndoManager().canUndo())
+                    edit->getUndoManager().undo();
+            }
+        }
+    }
+};
+
+static MidiListBenchmarks midiListBenchmarks;
+
+}} // namespace tracktion { inline namespace engine
+
+#endif
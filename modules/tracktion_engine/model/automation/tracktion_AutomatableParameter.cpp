@@ -182,6 +182,64 @@ struct ModifierAutomationSource : public AutomationModifierSource
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModifierAutomationSource)
 };
 
+//==============================================================================
+/**
+    Hands AutomationIterators built on the message thread over to the threads
+    calling setPosition without either side having to wait for the other.
+
+    A new iterator is picked up the next time it is accessed and the old one is
+    kept in the LockFreeObject's pending slot until the next push, so it's always
+    freed on the message thread. Only one thread can position the iterator at a
+    time, if another is already doing so, access returns false immediately and
+    the caller should use the last published value.
+*/
+class AutomationIteratorHandoff
+{
+public:
+    AutomationIteratorHandoff() = default;
+
+    /** Publishes a new iterator (or nullptr to stop), this must not be called from the audio thread. */
+    void push (std::unique_ptr<AutomationIterator> newIterator)
+    {
+        active.store (newIterator != nullptr, std::memory_order_release);
+        iterator.pushNonRealTime (std::move (newIterator));
+    }
+
+    /** Returns true if the last pushed iterator was non-null. */
+    bool isActive() const noexcept
+    {
+        return active.load (std::memory_order_acquire);
+    }
+
+    /** Calls fn with the current iterator if there is one and no other thread is using it.
+        Returns false if fn couldn't be called.
+    */
+    template<typename Fn>
+    bool access (Fn&& fn) noexcept
+    {
+        if (! positionLock.try_lock())
+            return false;
+
+        const std::lock_guard lock (positionLock, std::adopt_lock);
+        auto scopedAccess = iterator.getScopedAccess();
+
+        if (auto iter = scopedAccess.get(); iter != nullptr && *iter != nullptr)
+        {
+            fn (**iter);
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    LockFreeObject<std::unique_ptr<AutomationIterator>> iterator;
+    RealTimeSpinLock positionLock;
+    std::atomic<bool> active { false };
+
+    JUCE_DECLARE_NON_COPYABLE (AutomationIteratorHandoff)
+};
+
 //==============================================================================
 class AutomationCurveSource : public AutomationSource
 {
@@ -227,7 +285,7 @@ public:
 
     bool isActive() const noexcept
     {
-        return automationActive.load (std::memory_order_relaxed);
+        return parameterStream.isActive();
     }
 
     float getValueAt (TimePosition time) override
@@ -248,10 +306,19 @@ public:
                 if (! plugin->isClipEffectPlugin())
                     return;
 
-        const juce::ScopedLock sl (parameterStreamLock);
+        if (lastTime.exchange (time) == time)
+            return;
 
-        if (lastTime.exchange (time) != time)
-            parameterStream->setPosition (time);
+        if (! parameterStream.access ([this, time] (AutomationIterator& iter)
+                                      {
+                                          iter.setPosition (time);
+                                          currentValue.store (iter.getCurrentValue(), std::memory_order_release);
+                                      }))
+        {
+            // Another thread is already positioning the stream so make sure the
+            // next call evaluates it again rather than assuming it's up to date
+            lastTime.store (-1.0s);
+        }
     }
 
     bool isEnabled() override
@@ -261,8 +328,7 @@ public:
 
     float getCurrentValue() override
     {
-        const juce::ScopedLock sl (parameterStreamLock);
-        return parameterStream->getCurrentValue();
+        return currentValue.load (std::memory_order_acquire);
     }
 
     AutomatableParameter& parameter;
@@ -270,9 +336,8 @@ public:
 
 private:
     LambdaTimer deferredUpdateTimer;
-    juce::CriticalSection parameterStreamLock;
-    std::unique_ptr<AutomationIterator> parameterStream;
-    std::atomic<bool> automationActive { false };
+    AutomationIteratorHandoff parameterStream;
+    std::atomic<float> currentValue { 0.0f };
     std::atomic<TimePosition> lastTime { TimePosition::fromSeconds (-1.0) };
     std::unique_ptr<AutomatableParameter::ScopedActiveParameter> scopedActiveParameter;
 
@@ -295,26 +360,22 @@ private:
                 newStream = std::move (s);
         }
 
-        {
-            const juce::ScopedLock sl (parameterStreamLock);
-            automationActive.store (newStream != nullptr, std::memory_order_relaxed);
-            parameterStream = std::move (newStream);
-
-            if (parameterStream)
-            {
-                auto activeParam = std::make_unique<AutomatableParameter::ScopedActiveParameter> (parameter);
-                std::swap (scopedActiveParameter, activeParam);
-            }
-            else
-            {
-                scopedActiveParameter.reset();
+        parameterStream.push (std::move (newStream));
 
-                if (! editLoading)
-                    parameter.updateToFollowCurve (lastTime);
-            }
+        if (parameterStream.isActive())
+        {
+            auto activeParam = std::make_unique<AutomatableParameter::ScopedActiveParameter> (parameter);
+            std::swap (scopedActiveParameter, activeParam);
+        }
+        else
+        {
+            scopedActiveParameter.reset();
 
-            lastTime = -1.0s;
+            if (! editLoading)
+                parameter.updateToFollowCurve (lastTime);
         }
+
+        lastTime = -1.0s;
     }
 
     static juce::ValueTree getState (AutomatableParameter& ap)
@@ -537,41 +598,42 @@ private:
         AutomatableParameter& parameter;
         AutomationCurveModifier::CurveInfo curveInfo;
         std::shared_ptr<AutomationCurvePlayhead> playhead { curveModifier.getPlayhead (curveInfo.type) };
-        std::unique_ptr<AutomationIterator> parameterStream;
-        juce::CriticalSection parameterStreamLock;
-        std::atomic<bool> automationActive { false };
+        AutomationIteratorHandoff parameterStream;
+        std::atomic<float> currentValue { 0.0f };
+        std::atomic<bool> enabledAtLastPosition { false };
 
         bool isActive() const
         {
-            return automationActive.load (std::memory_order_relaxed);
+            return parameterStream.isActive();
         }
 
         bool setPosition (TimePosition editTime)
         {
-            const juce::ScopedLock sl (parameterStreamLock);
-
-            if (parameterStream)
+            const bool accessed = parameterStream.access ([this, editTime] (AutomationIterator& iter)
             {
                 auto modifiedPos = editPositionToCurvePosition (curveModifier, curveInfo.type, editTime);
                 playhead->position.store (modifiedPos);
 
                 if (modifiedPos)
                 {
-                    parameterStream->setPosition (toTime (*modifiedPos,
-                                                  getTempoSequence (curveModifier).getInternalSequence()));
-                    return true;
+                    iter.setPosition (toTime (*modifiedPos,
+                                              getTempoSequence (curveModifier).getInternalSequence()));
+                    currentValue.store (iter.getCurrentValue(), std::memory_order_release);
                 }
-            }
 
-            return false;
+                enabledAtLastPosition.store (modifiedPos.has_value(), std::memory_order_release);
+            });
+
+            if (! accessed && ! isActive())
+                return false;
+
+            return enabledAtLastPosition.load (std::memory_order_acquire);
         }
 
         float getCurrentValue()
         {
-            const juce::ScopedLock sl (parameterStreamLock);
-
-            if (parameterStream)
-                return parameterStream->getCurrentValue();
+            if (isActive())
+                return currentValue.load (std::memory_order_acquire);
 
             return 0.0f;
         }
@@ -591,11 +653,7 @@ private:
                     newStream = std::move (s);
             }
 
-            {
-                const juce::ScopedLock sl (parameterStreamLock);
-                automationActive.store (newStream != nullptr, std::memory_order_relaxed);
-                parameterStream = std::move (newStream);
-            }
+            parameterStream.push (std::move (newStream));
         }
 
         void processValue (float& baseValue, float& modValue)
@@ -1160,7 +1218,7 @@ std::optional<float> AutomatableParameter::getDefaultValue() const
 
 void AutomatableParameter::updateStream()
 {
-    curveSource->updateIteratorIfNeeded();
+    updateCurveStream();
 
     if (automationSourceList || AutomationSourceList::hasAutomationSources (modifiersState))
         getAutomationSourceList()
@@ -1171,6 +1229,11 @@ void AutomatableParameter::updateStream()
                            });
 }
 
+void AutomatableParameter::updateCurveStream()
+{
+    curveSource->updateIteratorIfNeeded();
+}
+
 void AutomatableParameter::updateFromAutomationSources (TimePosition time)
 {
     if (updateParametersRecursionCheck)
@@ -1716,25 +1779,12 @@ AutomatableParameter* getParameter (AutomatableParameter::ModifierAssignment& as
 }
 
 //==============================================================================
-AutomationIterator::AutomationIterator (Edit& edit, const AutomationCurve& curve)
+AutomationIterator::AutomationIterator (Edit& edit, const AutomationCurve& c)
     : tempoSequence (edit.tempoSequence.getInternalSequence()),
-      timeBase (curve.timeBase)
+      curve (c.getCompiledCurve()),
+      timeBase (c.timeBase)
 {
-    const int numPoints = curve.getNumPoints();
-    jassert (numPoints > 0);
-
-    for (int i = 0; i < numPoints; i++)
-    {
-        auto src = curve.getPoint (i);
-        assert (src.time.isBeats() == (timeBase == AutomationCurve::TimeBase::beats));
-
-        AutoPoint dst;
-        dst.time = toUnderlying (src.time);
-        dst.value = src.value;
-        dst.curve = src.curve;
-
-        points.add (dst);
-    }
+    jassert (curve.getNumPoints() > 0);
 }
 
 AutomationIterator::AutomationIterator (const AutomatableParameter& param)
@@ -1744,7 +1794,7 @@ AutomationIterator::AutomationIterator (const AutomatableParameter& param)
 
 void AutomationIterator::setPosition (EditPosition newTime) noexcept
 {
-    jassert (points.size() > 0);
+    jassert (curve.getNumPoints() > 0);
 
     const double newPostion = [this, &newTime]
                               {
@@ -1754,93 +1804,9 @@ void AutomationIterator::setPosition (EditPosition newTime) noexcept
                                   return toBeats (newTime, tempoSequence).inBeats();
                               }();
 
-    auto newIndex = updateIndex (newPostion);
-
-    if (newPostion < points[0].time)
-    {
-        currentIndex = newIndex;
-        currentValue = points.getReference (0).value;
-        return;
-    }
-
-    if (newIndex == points.size() - 1)
-    {
-        currentIndex = newIndex;
-        currentValue = points.getReference (newIndex).value;
-        return;
-    }
-
-    const auto& p1 = points.getReference (newIndex);
-    const auto& p2 = points.getReference (newIndex + 1);
-
-    const auto t = newPostion;
-
-    const auto t1 = p1.time;
-    const auto t2 = p2.time;
-
-    const auto v1 = p1.value;
-    const auto v2 = p2.value;
-
-    const auto c = p1.curve;
-
-    float v = p2.value;
-
-    if (t2 != t1)
-    {
-        if (c == 0.0f)
-        {
-            v = v1 + (v2 - v1) * (float) ((t - t1) / (t2 - t1));
-        }
-        else if (c >= -0.5 && c <= 0.5)
-        {
-            auto bp = getBezierPoint (p1.time, p1.value, p2.time, p2.value, p1.curve);
-            v = float (getBezierYFromX (t, t1, v1, bp.first, bp.second, t2, v2));
-        }
-        else
-        {
-            double x1end = 0, x2end = 0;
-            double y1end = 0, y2end = 0;
-
-            auto bp = getBezierPoint (p1.time, p1.value, p2.time, p2.value, p1.curve);
-            getBezierEnds (p1.time, p1.value,
-                           p2.time, p2.value,
-                           p1.curve,
-                           x1end, y1end, x2end, y2end);
-
-            if (t >= t1 && t <= x1end)
-                v = v1;
-            else if (t >= x2end && t <= t2)
-                v = v2;
-            else
-                v = float (getBezierYFromX (t, x1end, y1end, bp.first, bp.second, x2end, y2end));
-        }
-    }
-
-    currentIndex = newIndex;
-    currentValue = v;
-}
-
-int AutomationIterator::updateIndex (double newPosition)
-{
-    auto newIndex = currentIndex;
-
-    if (! juce::isPositiveAndBelow (newIndex, points.size()))
-        newIndex = 0;
-
-    if (newIndex > 0 && points.getReference (newIndex).time >= newPosition)
-    {
-        --newIndex;
-
-        while (newIndex > 0 && points.getReference (newIndex).time >= newPosition)
-            --newIndex;
-    }
-    else
-    {
-        while (newIndex < points.size() - 1 && points.getReference (newIndex + 1).time < newPosition)
-            ++newIndex;
-    }
-
-    return newIndex;
+    currentValue = curve.getValueAt (newPostion, currentValue,
+                                     CompiledAutomationCurve::SegmentBias::incoming,
+                                     currentIndex);
 }
 
 
@@ -167,6 +167,13 @@ public:
     /**  Forces the parameter to update its automation stream for reading automation. */
     void updateStream();
 
+    /** Updates the stream for the parameter's own automation curve if it's changed.
+        Whilst the Edit is loading this can be called from any thread, as long as the
+        parameters of the same AutomatableEditItem are updated one at a time.
+        @see updateStream
+    */
+    void updateCurveStream();
+
     /** Updates the parameter and modifier values from its current automation sources. */
     void updateFromAutomationSources (TimePosition);
 
@@ -420,23 +427,14 @@ struct AutomationIterator
     AutomationIterator (Edit&, const AutomationCurve&);
     AutomationIterator (const AutomatableParameter&);
 
-    bool isEmpty() const noexcept               { return points.size() <= 1; }
+    bool isEmpty() const noexcept               { return curve.getNumPoints() <= 1; }
 
     void setPosition (EditPosition) noexcept;
     float getCurrentValue() noexcept            { return currentValue; }
 
 private:
-    int updateIndex (double position);
-
-    struct AutoPoint
-    {
-        double time = 0.0; // Could be time or beats depending on the curve's timeBase
-        float value = 0.0f;
-        float curve = 0.0f;
-    };
-
     const tempo::Sequence& tempoSequence;
-    juce::Array<AutoPoint> points;
+    CompiledAutomationCurve curve;
     int currentIndex = -1;
     float currentValue = 0.0f;
     const AutomationCurve::TimeBase timeBase;
@@ -191,6 +191,34 @@ public:
                         randomAccess (iter, pb);
                     }
                 }
+
+                {
+                    // This is the path the UI takes so includes the initial compilation
+                    PublishingBenchmark pb (getDescription ("AutomationCurve::getValueAt time-based 3min curve with 90 points 10'000 positions, c=mixed"));
+                    [[maybe_unused]] volatile float val = 0.0f;
+
+                    for (int i = 0; i < 10'000; ++i)
+                    {
+                        auto t = end * r.nextDouble();
+
+                        ScopedMeasurement sm (pb.benchmark);
+                        val = mixedCurve.getValueAt (t, 0.0f);
+                    }
+                }
+
+                {
+                    std::vector<double> positions;
+                    std::vector<float> values;
+
+                    for (auto t = 0_tp; t < end; t = t + 3ms)
+                        positions.push_back (t.inSeconds());
+
+                    values.resize (positions.size());
+
+                    PublishingBenchmark pb (getDescription ("Batch evaluate time-based 3min curve with 90 points 3ms interval, c=mixed"));
+                    ScopedMeasurement sm (pb.benchmark);
+                    mixedCurve.getCompiledCurve().getValues (positions.data(), values.data(), (int) positions.size(), 0.0f);
+                }
             }
         }
     }
@@ -211,3 +239,146 @@ static AutomationIteratorBenchmarks automationIteratorBenchmarks;
 } // namespace tracktion::inline engine
 
 #endif //TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_AUTOMATIONITERATOR
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_AUTOMATION
+
+#include "../../../3rd_party/doctest/tracktion_doctest.hpp"
+
+namespace tracktion::inline engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("CompiledAutomationCurve")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto r = juce::Random (42);
+
+        AutomationCurve curve (*edit, AutomationCurve::TimeBase::time);
+
+        for (int i = 0; i < 50; ++i)
+            curve.addPoint (TimePosition::fromSeconds (i * 2.0), r.nextFloat(), r.nextFloat() * 2.0f - 1.0f, nullptr);
+
+        auto checkMatchesRebuild = [&]
+        {
+            const auto& compiled = curve.getCompiledCurve();
+            CompiledAutomationCurve rebuilt (curve);
+            REQUIRE_EQ (compiled.getNumPoints(), curve.getNumPoints());
+
+            for (double t = -1.0; t < 105.0; t += 0.37)
+                CHECK_EQ (compiled.getValueAt (t, 0.0f), rebuilt.getValueAt (t, 0.0f));
+        };
+
+        SUBCASE ("Incremental edits")
+        {
+            checkMatchesRebuild();
+
+            curve.setPointValue (10, 0.5f, nullptr);
+            curve.setCurveValue (11, 0.75f, nullptr);
+            checkMatchesRebuild();
+
+            curve.addPoint (TimePosition::fromSeconds (21.0), 1.0f, 0.0f, nullptr);
+            curve.addPoint (TimePosition::fromSeconds (0.0), 0.0f, -0.25f, nullptr);
+            curve.addPoint (TimePosition::fromSeconds (200.0), 0.0f, 0.0f, nullptr);
+            checkMatchesRebuild();
+
+            curve.removePoint (0, nullptr);
+            curve.removePoint (curve.getNumPoints() - 1, nullptr);
+            curve.removePoint (20, nullptr);
+            checkMatchesRebuild();
+
+            curve.clear (nullptr);
+            CHECK(curve.getCompiledCurve().isEmpty());
+            CHECK_EQ (curve.getValueAt (5_tp, 0.25f), 0.25f);
+        }
+
+        SUBCASE ("Cursor and batch lookups match random access")
+        {
+            const auto& compiled = curve.getCompiledCurve();
+            std::vector<double> positions;
+
+            for (double t = -1.0; t < 105.0; t += 0.01)
+                positions.push_back (t);
+
+            std::vector<float> values (positions.size());
+            compiled.getValues (positions.data(), values.data(), (int) positions.size(), 0.0f);
+
+            int cursor = -1;
+
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                CHECK_EQ (values[i], compiled.getValueAt (positions[i], 0.0f));
+                CHECK_EQ (compiled.getValueAt (positions[i], 0.0f, CompiledAutomationCurve::SegmentBias::incoming, cursor),
+                          compiled.getValueAt (positions[i], 0.0f, CompiledAutomationCurve::SegmentBias::incoming));
+            }
+        }
+    }
+
+    TEST_CASE ("Editing curves whilst rendering")
+    {
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto volPlugin = getAudioTracks (*edit)[0]->getVolumePlugin();
+        REQUIRE(volPlugin != nullptr);
+
+        auto param = volPlugin->volParam;
+        auto& curve = param->getCurve();
+        const auto range = param->getValueRange();
+        auto r = juce::Random (42);
+
+        for (int i = 0; i < 20; ++i)
+            curve.addPoint (TimePosition::fromSeconds (i), range.getStart() + r.nextFloat() * range.getLength(), 0.0f, nullptr);
+
+        param->updateStream();
+        REQUIRE(param->isAutomationActive());
+
+        std::atomic<bool> finished { false };
+        std::atomic<int> numBlocks { 0 }, numOutOfRange { 0 };
+
+        // Mimics the audio thread positioning the parameter every block
+        std::thread renderThread ([&]
+        {
+            for (auto t = 0_tp; ! finished; t = t + 1ms)
+            {
+                if (t > 20_tp)
+                    t = 0_tp;
+
+                param->updateFromAutomationSources (t);
+                const auto value = param->getCurrentValue();
+
+                if (std::isnan (value) || value < range.getStart() || value > range.getEnd())
+                    ++numOutOfRange;
+
+                ++numBlocks;
+            }
+        });
+
+        for (int i = 0; i < 2'000; ++i)
+        {
+            const auto index = r.nextInt (curve.getNumPoints());
+
+            switch (r.nextInt (4))
+            {
+                case 0:  curve.setPointValue (index, range.getStart() + r.nextFloat() * range.getLength(), nullptr);   break;
+                case 1:  curve.setCurveValue (index, r.nextFloat() * 2.0f - 1.0f, nullptr);                             break;
+                case 2:  curve.addPoint (TimePosition::fromSeconds (r.nextFloat() * 20.0f), range.getStart(), 0.0f, nullptr); break;
+                default: if (curve.getNumPoints() > 2) curve.removePoint (index, nullptr);                              break;
+            }
+
+            // Forces the new iterator to be built and handed over now rather than on the timer
+            param->updateStream();
+        }
+
+        finished = true;
+        renderThread.join();
+
+        CHECK(numBlocks.load() > 0);
+        CHECK_EQ (numOutOfRange.load(), 0);
+        CHECK(param->isAutomationActive());
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif //TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_AUTOMATION
@@ -34,6 +34,8 @@ AutomationCurve::AutomationCurve (const AutomationCurve& o)
     bypass.referTo (state, IDs::bypass, nullptr);
 }
 
+AutomationCurve::~AutomationCurve() = default;
+
 void AutomationCurve::setState (const juce::ValueTree& v)
 {
     state = v;
@@ -57,6 +59,101 @@ juce::String AutomationCurve::getParameterID() const
     return state[IDs::paramID];
 }
 
+//==============================================================================
+/** Keeps a CompiledAutomationCurve in sync with the state, patching single points
+    where possible and only rebuilding the whole thing when the order changes.
+*/
+struct AutomationCurve::CompiledCurveCache  : private juce::ValueTree::Listener
+{
+    CompiledCurveCache (const AutomationCurve& c)
+        : curve (c)
+    {
+    }
+
+    ~CompiledCurveCache() override
+    {
+        listenedState.removeListener (this);
+    }
+
+    const CompiledAutomationCurve& get()
+    {
+        // The curve's state may have been swapped out from under us
+        if (listenedState != curve.state)
+        {
+            listenedState.removeListener (this);
+            listenedState = curve.state;
+            listenedState.addListener (this);
+            needsRebuild = true;
+        }
+
+        if (needsRebuild)
+        {
+            compiled.rebuild (curve);
+            needsRebuild = false;
+        }
+
+        return compiled;
+    }
+
+private:
+    const AutomationCurve& curve;
+    juce::ValueTree listenedState;
+    CompiledAutomationCurve compiled;
+    bool needsRebuild = true;
+
+    void updatePoint (const juce::ValueTree& v, int index, bool isNewPoint)
+    {
+        const auto t = static_cast<double> (v[IDs::t]);
+        const auto value = static_cast<float> (v[IDs::v]);
+        const auto c = static_cast<float> (v[IDs::c]);
+
+        if (isNewPoint)
+            compiled.insertPoint (index, t, value, c);
+        else
+            compiled.setPoint (index, t, value, c);
+    }
+
+    void valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& i) override
+    {
+        if (needsRebuild || v.getParent() != listenedState)
+            return;
+
+        if (i == IDs::t || i == IDs::v || i == IDs::c)
+            updatePoint (v, listenedState.indexOf (v), false);
+    }
+
+    void valueTreeChildAdded (juce::ValueTree& p, juce::ValueTree& c) override
+    {
+        if (! needsRebuild && p == listenedState)
+            updatePoint (c, listenedState.indexOf (c), true);
+    }
+
+    void valueTreeChildRemoved (juce::ValueTree& p, juce::ValueTree&, int oldIndex) override
+    {
+        if (! needsRebuild && p == listenedState)
+            compiled.removePoint (oldIndex);
+    }
+
+    void valueTreeChildOrderChanged (juce::ValueTree& p, int, int) override
+    {
+        if (p == listenedState)
+            needsRebuild = true;
+    }
+
+    void valueTreeRedirected (juce::ValueTree&) override
+    {
+        needsRebuild = true;
+    }
+};
+
+const CompiledAutomationCurve& AutomationCurve::getCompiledCurve() const
+{
+    if (! compiledCurveCache)
+        compiledCurveCache = std::make_unique<CompiledCurveCache> (*this);
+
+    return compiledCurveCache->get();
+}
+
 //==============================================================================
 int AutomationCurve::getNumPoints() const noexcept
 {
@@ -109,42 +206,26 @@ float AutomationCurve::getPointCurve (int index) const noexcept
 
 int AutomationCurve::indexBefore (EditPosition p) const
 {
-    for (int i = getNumPoints(); --i >= 0;)
-        if (lessThanOrEqualTo (getPointPosition (i), p, edit.tempoSequence))
-            return i;
-
-    return -1;
+    return getCompiledCurve().findSegment (toUnderlying (convertPositionToBase (p)),
+                                           CompiledAutomationCurve::SegmentBias::outgoing);
 }
 
 int AutomationCurve::indexBefore (TimePosition t) const
 {
-    for (int i = getNumPoints(); --i >= 0;)
-        if (getPointTime (i) <= t)
-            return i;
-
-    return -1;
+    return getCompiledCurve().findSegment (toUnderlying (convertPositionToBase (t)),
+                                           CompiledAutomationCurve::SegmentBias::outgoing);
 }
 
 int AutomationCurve::nextIndexAfter (EditPosition p) const
 {
-    auto num = getNumPoints();
-
-    for (int i = 0; i < num; ++i)
-        if (greater (getPointPosition (i), p, edit.tempoSequence))
-            return i;
-
-    return num;
+    return getCompiledCurve().findSegment (toUnderlying (convertPositionToBase (p)),
+                                           CompiledAutomationCurve::SegmentBias::outgoing) + 1;
 }
 
 int AutomationCurve::nextIndexAfter (TimePosition t) const
 {
-    auto num = getNumPoints();
-
-    for (int i = 0; i < num; ++i)
-        if (getPointTime (i) >= t)
-            return i;
-
-    return num;
+    return getCompiledCurve().findSegment (toUnderlying (convertPositionToBase (t)),
+                                           CompiledAutomationCurve::SegmentBias::incoming) + 1;
 }
 
 TimeDuration AutomationCurve::getLength() const
@@ -156,105 +237,15 @@ TimeDuration AutomationCurve::getLength() const
 float AutomationCurve::getValueAt (EditPosition editPos, float defaultValue) const
 {
     TRACKTION_ASSERT_MESSAGE_THREAD
-    const auto index = nextIndexAfter (editPos);
-    const auto time = toUnderlying (editPos);
-
-    auto numPoints = getNumPoints();
-
-    if (index <= 0)
-        return numPoints > 0 ? getPointValue (0)
-                             : defaultValue;
-
-    if (index >= numPoints)
-        return getPointValue (numPoints - 1);
-
-    auto p1 = state.getChild (index - 1);
-    auto p2 = state.getChild (index);
-
-    const double time1 = p1.getProperty (IDs::t);
-    const float curve1 = p1.getProperty (IDs::c);
-    const float value1 = p1.getProperty (IDs::v);
-
-    const double time2 = p2.getProperty (IDs::t);
-    const float value2 = p2.getProperty (IDs::v);
-
-    if (curve1 == 0.0f)
-    {
-        auto alpha = (float) ((time - time1) / (time2 - time1));
-        return value1 + alpha * (value2 - value1);
-    }
-
-    if (curve1 >= -0.5f && curve1 <= 0.5f)
-    {
-        auto bezierPoint = getBezierPoint (index - 1);
-        return static_cast<float> (getBezierYFromX (time, time1, value1, toUnderlying (bezierPoint.time), bezierPoint.value, time2, value2));
-    }
-
-    double x1, x2;
-    float y1, y2;
-    getBezierEnds (index - 1, x1, y1, x2, y2);
-
-    if (time >= time1 && time <= x1)
-        return value1;
-
-    if (time >= x2 && time <= time2)
-        return value2;
-
-    auto bezierPoint = getBezierPoint (index - 1);
-    return static_cast<float> (getBezierYFromX (time, x1, y1, toUnderlying (bezierPoint.time), bezierPoint.value, x2, y2));
+    return getCompiledCurve().getValueAt (toUnderlying (convertPositionToBase (editPos)), defaultValue,
+                                          CompiledAutomationCurve::SegmentBias::outgoing);
 }
 
 float AutomationCurve::getValueAt (TimePosition timePos, float defaultValue) const
 {
     TRACKTION_ASSERT_MESSAGE_THREAD
-    const auto index = nextIndexAfter (timePos);
-    const auto time = timePos.inSeconds();
-
-    auto numPoints = getNumPoints();
-
-    if (index <= 0)
-        return numPoints > 0 ? getPointValue (0)
-                             : defaultValue;
-
-    if (index >= numPoints)
-        return getPointValue (numPoints - 1);
-
-    auto p1 = state.getChild (index - 1);
-    auto p2 = state.getChild (index);
-
-    const double time1 = p1.getProperty (IDs::t);
-    const float curve1 = p1.getProperty (IDs::c);
-    const float value1 = p1.getProperty (IDs::v);
-
-    const double time2 = p2.getProperty (IDs::t);
-    const float value2 = p2.getProperty (IDs::v);
-
-    auto& ts = getTempoSequence (edit);
-
-    if (curve1 == 0.0f)
-    {
-        auto alpha = (float) ((time - time1) / (time2 - time1));
-        return value1 + alpha * (value2 - value1);
-    }
-
-    if (curve1 >= -0.5f && curve1 <= 0.5f)
-    {
-        auto bezierPoint = getBezierPoint (index - 1);
-        return static_cast<float> (static_cast<float> (getBezierYFromX (time, time1, value1, toTime (bezierPoint.time, ts).inSeconds(), bezierPoint.value, time2, value2)));
-    }
-
-    double x1, x2;
-    float y1, y2;
-    getBezierEnds (index - 1, x1, y1, x2, y2);
-
-    if (time >= time1 && time <= x1)
-        return value1;
-
-    if (time >= x2 && time <= time2)
-        return value2;
-
-    auto bezierPoint = getBezierPoint (index - 1);
-    return static_cast<float> (getBezierYFromX (time, x1, y1, toTime (bezierPoint.time, ts).inSeconds(), bezierPoint.value, x2, y2));
+    return getCompiledCurve().getValueAt (toUnderlying (convertPositionToBase (timePos)), defaultValue,
+                                          CompiledAutomationCurve::SegmentBias::incoming);
 }
 
 static double getDistanceFromLine (double& x, double& y,
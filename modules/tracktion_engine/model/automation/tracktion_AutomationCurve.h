@@ -11,6 +11,8 @@
 namespace tracktion::inline engine
 {
 
+class CompiledAutomationCurve;
+
 class AutomationCurve
 {
 public:
@@ -24,6 +26,7 @@ public:
     AutomationCurve (Edit&, TimeBase,
                      const juce::ValueTree& parent, const juce::ValueTree& state);
     AutomationCurve (const AutomationCurve&);
+    ~AutomationCurve();
 
     void setState (const juce::ValueTree&);
     void setParentState (const juce::ValueTree&);
@@ -82,6 +85,12 @@ public:
     int indexBefore (EditPosition) const;
     int nextIndexAfter (EditPosition) const;
 
+    /** Returns a flattened copy of the points which is kept up to date as the state changes.
+        This is much quicker to query than the state so use it for repeated lookups.
+        Positions in it are in this curve's TimeBase.
+    */
+    const CompiledAutomationCurve& getCompiledCurve() const;
+
     //==============================================================================
     void clear (juce::UndoManager*);
 
@@ -147,6 +156,9 @@ private:
     void addPointAtIndex (int index, TimePosition, float v, float c, juce::UndoManager*);
     void checkParenthoodStatus (juce::UndoManager*);
 
+    struct CompiledCurveCache;
+    mutable std::unique_ptr<CompiledCurveCache> compiledCurveCache;
+
     JUCE_LEAK_DETECTOR (AutomationCurve)
 };
 
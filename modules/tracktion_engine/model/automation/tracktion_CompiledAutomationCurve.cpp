@@ -0,0 +1,296 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+CompiledAutomationCurve::CompiledAutomationCurve (const AutomationCurve& curve)
+{
+    rebuild (curve);
+}
+
+//==============================================================================
+int CompiledAutomationCurve::findSegment (double position, SegmentBias bias, int* cursor) const noexcept
+{
+    const auto numPoints = getNumPoints();
+
+    // Returns true if the point at the given index is at or before the position
+    // in the sense of the bias i.e. if the position is past the start of that point's segment
+    auto isPast = [this, position, bias] (int pointIndex)
+    {
+        const auto t = times[static_cast<size_t> (pointIndex)];
+        return bias == SegmentBias::incoming ? t < position
+                                             : t <= position;
+    };
+
+    if (cursor != nullptr)
+    {
+        // Sequential access will usually be in the same or the next segment so
+        // step forwards a few times before falling back to a search
+        constexpr int maxSteps = 4;
+        auto index = *cursor;
+
+        if (index >= -1 && index < numPoints
+            && (index == -1 || isPast (index)))
+        {
+            for (int step = 0; step < maxSteps; ++step)
+            {
+                if (index + 1 >= numPoints || ! isPast (index + 1))
+                {
+                    *cursor = index;
+                    return index;
+                }
+
+                ++index;
+            }
+        }
+    }
+
+    auto iter = bias == SegmentBias::incoming ? std::lower_bound (times.begin(), times.end(), position)
+                                              : std::upper_bound (times.begin(), times.end(), position);
+    const auto index = static_cast<int> (std::distance (times.begin(), iter)) - 1;
+
+    if (cursor != nullptr)
+        *cursor = index;
+
+    return index;
+}
+
+float CompiledAutomationCurve::getValueAt (double position, float defaultValue, SegmentBias bias) const noexcept
+{
+    if (isEmpty())
+        return defaultValue;
+
+    return evaluate (findSegment (position, bias), position, defaultValue);
+}
+
+float CompiledAutomationCurve::getValueAt (double position, float defaultValue, SegmentBias bias, int& cursor) const noexcept
+{
+    if (isEmpty())
+        return defaultValue;
+
+    return evaluate (findSegment (position, bias, &cursor), position, defaultValue);
+}
+
+void CompiledAutomationCurve::getValues (const double* positions, float* destValues, int numValues,
+                                         float defaultValue, SegmentBias bias) const noexcept
+{
+    if (isEmpty())
+    {
+        std::fill_n (destValues, numValues, defaultValue);
+        return;
+    }
+
+    int cursor = -2;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        jassert (i == 0 || positions[i] >= positions[i - 1]);
+        destValues[i] = evaluate (findSegment (positions[i], bias, &cursor), positions[i], defaultValue);
+    }
+}
+
+float CompiledAutomationCurve::evaluate (int segmentIndex, double position, float defaultValue) const noexcept
+{
+    const auto numPoints = getNumPoints();
+
+    if (numPoints == 0)
+        return defaultValue;
+
+    if (segmentIndex < 0)
+        return values.front();
+
+    if (segmentIndex >= numPoints - 1)
+        return values.back();
+
+    return evaluateSegment (segmentIndex, position);
+}
+
+float CompiledAutomationCurve::evaluateSegment (int index, double t) const noexcept
+{
+    const auto i = static_cast<size_t> (index);
+    const auto t1 = times[i];
+    const auto t2 = times[i + 1];
+    const auto v1 = values[i];
+    const auto v2 = values[i + 1];
+
+    switch (segmentTypes[i])
+    {
+        case SegmentType::flat:
+            return v2;
+
+        case SegmentType::linear:
+            return v1 + (v2 - v1) * (float) ((t - t1) / (t2 - t1));
+
+        case SegmentType::bezier:
+            return static_cast<float> (getBezierYFromX (t, t1, v1, controlX[i], controlY[i], t2, v2));
+
+        case SegmentType::bezierEnds:
+            if (t >= t1 && t <= startX[i])
+                return v1;
+
+            if (t >= endX[i] && t <= t2)
+                return v2;
+
+            return static_cast<float> (getBezierYFromX (t, startX[i], startY[i], controlX[i], controlY[i], endX[i], endY[i]));
+    }
+
+    jassertfalse;
+    return v2;
+}
+
+//==============================================================================
+void CompiledAutomationCurve::rebuild (const AutomationCurve& curve)
+{
+    const auto numPoints = static_cast<size_t> (curve.getNumPoints());
+    times.resize (numPoints);
+    values.resize (numPoints);
+    curves.resize (numPoints);
+
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        auto point = curve.state.getChild (static_cast<int> (i));
+        times[i] = static_cast<double> (point[IDs::t]);
+        values[i] = static_cast<float> (point[IDs::v]);
+        curves[i] = static_cast<float> (point[IDs::c]);
+    }
+
+    resizeSegments();
+
+    for (int i = 0; i < getNumPoints() - 1; ++i)
+        updateSegment (i);
+}
+
+void CompiledAutomationCurve::insertPoint (int index, double position, float value, float curve)
+{
+    jassert (index >= 0 && index <= getNumPoints());
+    const auto offset = static_cast<std::ptrdiff_t> (index);
+    times.insert (times.begin() + offset, position);
+    values.insert (values.begin() + offset, value);
+    curves.insert (curves.begin() + offset, curve);
+
+    if (times.size() < 2)
+        return;
+
+    // Segments after the new point just shift along so only the two either side need recalculating
+    const auto segOffset = static_cast<std::ptrdiff_t> (std::max (0, index - 1));
+    segmentTypes.insert (segmentTypes.begin() + segOffset, SegmentType::flat);
+    controlX.insert (controlX.begin() + segOffset, 0.0);
+    controlY.insert (controlY.begin() + segOffset, 0.0f);
+    startX.insert (startX.begin() + segOffset, 0.0);
+    startY.insert (startY.begin() + segOffset, 0.0f);
+    endX.insert (endX.begin() + segOffset, 0.0);
+    endY.insert (endY.begin() + segOffset, 0.0f);
+
+    updateSegment (index - 1);
+    updateSegment (index);
+}
+
+void CompiledAutomationCurve::setPoint (int index, double position, float value, float curve)
+{
+    jassert (juce::isPositiveAndBelow (index, getNumPoints()));
+    const auto i = static_cast<size_t> (index);
+    times[i] = position;
+    values[i] = value;
+    curves[i] = curve;
+
+    updateSegment (index - 1);
+    updateSegment (index);
+}
+
+void CompiledAutomationCurve::removePoint (int index)
+{
+    jassert (juce::isPositiveAndBelow (index, getNumPoints()));
+    const auto offset = static_cast<std::ptrdiff_t> (index);
+    times.erase (times.begin() + offset);
+    values.erase (values.begin() + offset);
+    curves.erase (curves.begin() + offset);
+
+    if (segmentTypes.empty())
+        return;
+
+    // Remove the segment starting at the point, or the one ending at it if it was the last point
+    const auto segOffset = std::min (offset, static_cast<std::ptrdiff_t> (segmentTypes.size() - 1));
+    segmentTypes.erase (segmentTypes.begin() + segOffset);
+    controlX.erase (controlX.begin() + segOffset);
+    controlY.erase (controlY.begin() + segOffset);
+    startX.erase (startX.begin() + segOffset);
+    startY.erase (startY.begin() + segOffset);
+    endX.erase (endX.begin() + segOffset);
+    endY.erase (endY.begin() + segOffset);
+
+    updateSegment (index - 1);
+}
+
+void CompiledAutomationCurve::clear()
+{
+    times.clear();
+    values.clear();
+    curves.clear();
+    resizeSegments();
+}
+
+//==============================================================================
+void CompiledAutomationCurve::resizeSegments()
+{
+    const auto numSegments = times.empty() ? 0 : times.size() - 1;
+    segmentTypes.resize (numSegments);
+    controlX.resize (numSegments);
+    controlY.resize (numSegments);
+    startX.resize (numSegments);
+    startY.resize (numSegments);
+    endX.resize (numSegments);
+    endY.resize (numSegments);
+}
+
+void CompiledAutomationCurve::updateSegment (int index) noexcept
+{
+    if (index < 0 || index >= getNumPoints() - 1)
+        return;
+
+    // N.B. This mirrors the geometry AutomationCurve uses for drawing (getBezierPoint/getBezierEnds)
+    const auto i = static_cast<size_t> (index);
+    const auto x1 = times[i];
+    const auto x2 = times[i + 1];
+    const auto y1 = values[i];
+    const auto y2 = values[i + 1];
+    const auto c = curves[i];
+
+    if (x1 == x2)
+    {
+        segmentTypes[i] = SegmentType::flat;
+        return;
+    }
+
+    if (c == 0.0f)
+    {
+        segmentTypes[i] = SegmentType::linear;
+        return;
+    }
+
+    auto [bx, by] = core::getBezierPoint (x1, y1, x2, y2, juce::jlimit (-1.0f, 1.0f, c * 2.0f));
+    controlX[i] = bx;
+    controlY[i] = static_cast<float> (by);
+
+    if (c >= -0.5f && c <= 0.5f)
+    {
+        segmentTypes[i] = SegmentType::bezier;
+        return;
+    }
+
+    auto ends = core::getBezierEnds (x1, static_cast<double> (y1), x2, static_cast<double> (y2), static_cast<double> (c));
+    startX[i] = ends.x1;
+    startY[i] = static_cast<float> (ends.y1);
+    endX[i] = ends.x2;
+    endY[i] = static_cast<float> (ends.y2);
+    segmentTypes[i] = SegmentType::bezierEnds;
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,123 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    A flattened, structure-of-arrays copy of an AutomationCurve's points.
+
+    Positions are stored as raw doubles in the curve's TimeBase (i.e. seconds or
+    beats) and the bezier control and end points of each segment are computed
+    once when a point changes rather than on every lookup.
+
+    Lookups are O(log n), or amortised O(1) when a cursor is passed in and the
+    positions move sequentially, as they do during playback.
+
+    This has no thread-safety of its own. AutomationCurve keeps one up to date on
+    the message thread and AutomationIterator takes a copy to use on the audio thread.
+*/
+class CompiledAutomationCurve
+{
+public:
+    /** Creates an empty curve. */
+    CompiledAutomationCurve() = default;
+
+    /** Creates a compiled copy of an AutomationCurve's current points. */
+    explicit CompiledAutomationCurve (const AutomationCurve&);
+
+    //==============================================================================
+    /** Determines which segment is evaluated when a position lands exactly on a point. */
+    enum class SegmentBias
+    {
+        incoming,   /**< Evaluates the segment ending at the point (as the playback graph does). */
+        outgoing    /**< Evaluates the segment starting at the point. */
+    };
+
+    /** Returns the number of points in the curve. */
+    int getNumPoints() const noexcept                   { return static_cast<int> (times.size()); }
+
+    /** Returns true if there are no points. */
+    bool isEmpty() const noexcept                       { return times.empty(); }
+
+    /** Returns the position of a point in the curve's TimeBase. */
+    double getPointPosition (int index) const noexcept  { return times[static_cast<size_t> (index)]; }
+
+    /** Returns the value of a point. */
+    float getPointValue (int index) const noexcept      { return values[static_cast<size_t> (index)]; }
+
+    /** Returns the curve value of a point. */
+    float getPointCurve (int index) const noexcept      { return curves[static_cast<size_t> (index)]; }
+
+    //==============================================================================
+    /** Returns the index of the segment that a position falls in, or -1 if it is before the first point.
+        If a cursor is supplied, it is used as a starting hint and updated with the result.
+    */
+    int findSegment (double position, SegmentBias, int* cursor = nullptr) const noexcept;
+
+    /** Returns the value at a position, or the defaultValue if there are no points. */
+    float getValueAt (double position, float defaultValue,
+                      SegmentBias = SegmentBias::outgoing) const noexcept;
+
+    /** Returns the value at a position, using and updating a cursor.
+        This is the fastest way to evaluate positions that move forwards through the curve.
+    */
+    float getValueAt (double position, float defaultValue,
+                      SegmentBias, int& cursor) const noexcept;
+
+    /** Evaluates a block of ascending positions in one pass.
+        This only searches for the first position, subsequent ones step forwards from there.
+    */
+    void getValues (const double* positions, float* destValues, int numValues,
+                    float defaultValue, SegmentBias = SegmentBias::outgoing) const noexcept;
+
+    //==============================================================================
+    /** Replaces all the points with the ones in the given curve. */
+    void rebuild (const AutomationCurve&);
+
+    /** Adds a point at the given index, updating only the neighbouring segments. */
+    void insertPoint (int index, double position, float value, float curve);
+
+    /** Changes a point, updating only the neighbouring segments. */
+    void setPoint (int index, double position, float value, float curve);
+
+    /** Removes a point, updating only the neighbouring segments. */
+    void removePoint (int index);
+
+    /** Removes all the points. */
+    void clear();
+
+private:
+    //==============================================================================
+    enum class SegmentType : uint8_t
+    {
+        flat,       // The segment has no length, or no change in value
+        linear,
+        bezier,     // A single quadratic between the points
+        bezierEnds  // Holds the start/end values to the handle ends then a quadratic between them
+    };
+
+    // Per-point
+    std::vector<double> times;
+    std::vector<float> values, curves;
+
+    // Per-segment (i.e. the section between point i and i + 1)
+    std::vector<SegmentType> segmentTypes;
+    std::vector<double> controlX, startX, endX;
+    std::vector<float> controlY, startY, endY;
+
+    void updateSegment (int index) noexcept;
+    void resizeSegments();
+    float evaluateSegment (int index, double position) const noexcept;
+    float evaluate (int segmentIndex, double position, float defaultValue) const noexcept;
+};
+
+} // namespace tracktion::inline engine
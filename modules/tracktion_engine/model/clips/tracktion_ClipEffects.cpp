@@ -1181,9 +1181,13 @@ PitchShiftEffect::PitchShiftEffect (const juce::ValueTree& v, ClipEffects& o)
 
 void PitchShiftEffect::initialise()
 {
-    if (plugin != nullptr)
-        for (auto ap : plugin->getAutomatableParameters())
-            ap->updateStream();
+    for (auto ap : getAutomatableParameters())
+        ap->updateStream();
+}
+
+juce::Array<AutomatableParameter*> PitchShiftEffect::getAutomatableParameters()
+{
+    return plugin != nullptr ? plugin->getAutomatableParameters() : juce::Array<AutomatableParameter*>();
 }
 
 juce::ReferenceCountedObjectPtr<ClipEffect::ClipEffectRenderJob> PitchShiftEffect::createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength)
@@ -43,6 +43,9 @@ public:
 
     virtual void initialise() {}
 
+    /** Returns the parameters of the plugin the effect renders with, if it has one. */
+    virtual juce::Array<AutomatableParameter*> getAutomatableParameters()   { return {}; }
+
     static juce::String getTypeDisplayName (EffectType);
     static void addEffectsToMenu (juce::PopupMenu&);
 
@@ -348,9 +351,13 @@ struct VolumeEffect : public ClipEffect,
 
     void initialise() override
     {
-        if (plugin != nullptr)
-            for (auto ap : plugin->getAutomatableParameters())
-                ap->updateStream();
+        for (auto ap : getAutomatableParameters())
+            ap->updateStream();
+    }
+
+    juce::Array<AutomatableParameter*> getAutomatableParameters() override
+    {
+        return plugin != nullptr ? plugin->getAutomatableParameters() : juce::Array<AutomatableParameter*>();
     }
 
     bool hasProperties() override;
@@ -452,6 +459,7 @@ struct PitchShiftEffect  : public ClipEffect,
     PitchShiftEffect (const juce::ValueTree&, ClipEffects&);
 
     void initialise() override;
+    juce::Array<AutomatableParameter*> getAutomatableParameters() override;
 
     juce::ReferenceCountedObjectPtr<ClipEffectRenderJob> createRenderJob (const AudioFile& sourceFile, TimeDuration sourceLength) override;
 
@@ -502,9 +510,13 @@ struct PluginEffect  : public ClipEffect,
 
     void initialise() override
     {
-        if (plugin != nullptr)
-            for (auto ap : plugin->getAutomatableParameters())
-                ap->updateStream();
+        for (auto ap : getAutomatableParameters())
+            ap->updateStream();
+    }
+
+    juce::Array<AutomatableParameter*> getAutomatableParameters() override
+    {
+        return plugin != nullptr ? plugin->getAutomatableParameters() : juce::Array<AutomatableParameter*>();
     }
 
     void flushStateToValueTree() override;
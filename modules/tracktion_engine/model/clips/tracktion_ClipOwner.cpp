@@ -11,11 +11,11 @@
 namespace tracktion { inline namespace engine
 {
 
-struct ClipOwner::ClipList : public ValueTreeObjectList<Clip>,
+struct ClipOwner::ClipList : public IndexedValueTreeObjectList<Clip>,
                              private juce::AsyncUpdater
 {
     ClipList (ClipOwner& co, Edit& e, const juce::ValueTree& parentTree)
-        : ValueTreeObjectList<Clip> (parentTree),
+        : IndexedValueTreeObjectList<Clip> (parentTree),
           edit (e),
           clipOwner (co)
     {
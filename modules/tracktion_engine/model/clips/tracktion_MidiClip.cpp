@@ -146,7 +146,7 @@ void MidiClip::initialise()
             if (! sequence.isValid())
                 continue;
 
-            channelSequence.add (new MidiList (sequence, um));
+            addChannelSequence (sequence, um);
         }
 
         if (state.getChildWithName (IDs::COMPS).isValid())
@@ -157,7 +157,7 @@ void MidiClip::initialise()
         auto list = state.getChildWithName (IDs::SEQUENCE);
 
         if (list.isValid())
-            channelSequence.add (new MidiList (list, um));
+            addChannelSequence (list, um);
         else
             state.addChild (MidiList::createMidiList(), -1, um);
 
@@ -820,8 +820,12 @@ void MidiClip::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Iden
     }
     else if (tree.hasType (IDs::NOTE)
              || tree.hasType (IDs::CONTROL)
-             || tree.hasType (IDs::SYSEX)
-             || tree.hasType (IDs::QUANTISATION)
+             || tree.hasType (IDs::SYSEX))
+    {
+        if (! isSequenceInBulkEdit (tree.getParent()))
+            clearCachedLoopSequence();
+    }
+    else if (tree.hasType (IDs::QUANTISATION)
              || (tree.hasType (IDs::SEQUENCE) && id == IDs::channelNumber)
              || (tree.hasType (IDs::GROOVE) && id == IDs::current))
     {
@@ -836,9 +840,12 @@ void MidiClip::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Iden
 void MidiClip::valueTreeChildAdded (juce::ValueTree& p, juce::ValueTree& c)
 {
     if (p.hasType (IDs::SEQUENCE))
-        clearCachedLoopSequence();
+    {
+        if (! isSequenceInBulkEdit (p))
+            clearCachedLoopSequence();
+    }
     else if ((p == state || p.getParent() == state) && c.hasType (IDs::SEQUENCE))
-        channelSequence.add (new MidiList (c, getUndoManager()));
+        addChannelSequence (c, getUndoManager());
 
     if (c.hasType (IDs::PATTERNGENERATOR))
         patternGenerator = std::make_unique<PatternGenerator> (*this, c);
@@ -848,7 +855,8 @@ void MidiClip::valueTreeChildRemoved (juce::ValueTree& p, juce::ValueTree& c, in
 {
     if (p.hasType (IDs::SEQUENCE))
     {
-        clearCachedLoopSequence();
+        if (! isSequenceInBulkEdit (p))
+            clearCachedLoopSequence();
     }
     else if ((p == state || p.getParent() == state) && c.hasType (IDs::SEQUENCE))
     {
@@ -874,6 +882,24 @@ void MidiClip::clearCachedLoopSequence()
     changed();
 }
 
+MidiList& MidiClip::addChannelSequence (const juce::ValueTree& v, juce::UndoManager* um)
+{
+    auto list = channelSequence.add (new MidiList (v, um));
+
+    // Events changed in a bulk edit are responded to once it's finished
+    list->onBulkEditEnded = [this] { clearCachedLoopSequence(); };
+
+    return *list;
+}
+
+bool MidiClip::isSequenceInBulkEdit (const juce::ValueTree& v)
+{
+    if (auto list = getMidiListForState (v))
+        return list->isInBulkEdit();
+
+    return false;
+}
+
 //==============================================================================
 PatternGenerator* MidiClip::getPatternGenerator()
 {
@@ -207,6 +207,8 @@ private:
 
     //==============================================================================
     MidiList* getMidiListForState (const juce::ValueTree&);
+    MidiList& addChannelSequence (const juce::ValueTree&, juce::UndoManager*);
+    bool isSequenceInBulkEdit (const juce::ValueTree&);
     void clearCachedLoopSequence();
 
     //==============================================================================
@@ -0,0 +1,281 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace binary_edit_file
+{
+    static constexpr char magic[] = { 'T', 'E', 'D', 'B' };
+    static constexpr juce::int64 headerSize = sizeof (magic) + sizeof (int) * 2;
+    static constexpr juce::int64 tocEntrySize = sizeof (juce::int64) * 2;
+
+    static bool shouldBeChunk (const juce::ValueTree& v)
+    {
+        if (v.hasType (IDs::SEQUENCE) || v.hasType (IDs::AUTOMATIONCURVE))
+            return v.getNumChildren() > 0;
+
+        return v.hasType (IDs::PLUGIN) && v.hasProperty (IDs::state);
+    }
+
+    /** Copies the tree, moving the outermost bulky subtrees into the chunk list. */
+    static juce::ValueTree createSkeleton (const juce::ValueTree& v, std::vector<juce::ValueTree>& chunks)
+    {
+        juce::ValueTree skeleton (v.getType());
+        skeleton.copyPropertiesFrom (v, nullptr);
+
+        for (const auto& child : v)
+        {
+            if (shouldBeChunk (child))
+            {
+                chunks.push_back (child);
+                skeleton.appendChild (juce::ValueTree (IDs::EDITCHUNK, { { IDs::chunkIndex, static_cast<int> (chunks.size()) } }),
+                                      nullptr);
+            }
+            else
+            {
+                skeleton.appendChild (createSkeleton (child, chunks), nullptr);
+            }
+        }
+
+        return skeleton;
+    }
+
+    /** The size of a string written with OutputStream::writeString, including its terminator. */
+    static juce::int64 getWrittenSize (const juce::String& s)
+    {
+        return static_cast<juce::int64> (s.getNumBytesAsUTF8()) + 1;
+    }
+
+    static bool hasMagic (juce::InputStream& is)
+    {
+        char header[std::size (magic)] = {};
+        return is.read (header, static_cast<int> (std::size (header))) == static_cast<int> (std::size (header))
+                 && std::equal (std::begin (header), std::end (header), std::begin (magic));
+    }
+}
+
+//==============================================================================
+BinaryEditFile::BinaryEditFile (const juce::File& f)
+    : file (f)
+{
+    CRASH_TRACER
+    using namespace binary_edit_file;
+
+    juce::FileInputStream is (file);
+
+    if (! is.openedOk() || ! hasMagic (is))
+        return;
+
+    const auto version = is.readInt();
+    const auto numChunks = is.readInt();
+    const auto fileSize = is.getTotalLength();
+
+    if (version < 1 || version > currentVersion || numChunks < 1)
+        return;
+
+    if (version >= 2)
+    {
+        appVersion = is.readString();
+        engineVersion = is.readString();
+    }
+
+    const auto dataStart = is.getPosition() + numChunks * tocEntrySize;
+
+    if (dataStart > fileSize)
+        return;
+
+    chunks.resize (static_cast<size_t> (numChunks));
+
+    for (auto& c : chunks)
+    {
+        c.offset = is.readInt64();
+        c.size = is.readInt64();
+
+        if (c.offset < dataStart || c.size < 0 || c.offset + c.size > fileSize)
+        {
+            chunks.clear();
+            return;
+        }
+    }
+
+    skeleton = readChunk (is, 0);
+
+    if (! skeleton.hasType (IDs::EDIT))
+    {
+        skeleton = {};
+        chunks.clear();
+    }
+}
+
+juce::ValueTree BinaryEditFile::readChunk (juce::InputStream& is, int index) const
+{
+    if (! juce::isPositiveAndBelow (index, getNumChunks()))
+    {
+        jassertfalse;
+        return {};
+    }
+
+    const auto& c = chunks[static_cast<size_t> (index)];
+    juce::MemoryBlock data;
+
+    if (! is.setPosition (c.offset)
+        || is.readIntoMemoryBlock (data, static_cast<juce::ssize_t> (c.size)) != static_cast<size_t> (c.size))
+        return {};
+
+    return juce::ValueTree::readFromData (data.getData(), data.getSize());
+}
+
+//==============================================================================
+bool BinaryEditFile::isPlaceholder (const juce::ValueTree& v)
+{
+    return v.hasType (IDs::EDITCHUNK);
+}
+
+juce::ValueTree BinaryEditFile::resolve (const juce::ValueTree& v) const
+{
+    if (! isPlaceholder (v))
+        return v;
+
+    juce::FileInputStream is (file);
+
+    if (! is.openedOk())
+        return {};
+
+    return readChunk (is, v[IDs::chunkIndex]);
+}
+
+bool BinaryEditFile::resolveAll (juce::InputStream& is, juce::ValueTree& v) const
+{
+    for (int i = v.getNumChildren(); --i >= 0;)
+    {
+        auto child = v.getChild (i);
+
+        if (isPlaceholder (child))
+        {
+            auto chunk = readChunk (is, child[IDs::chunkIndex]);
+
+            if (! chunk.isValid())
+                return false;
+
+            v.removeChild (i, nullptr);
+            v.addChild (chunk, i, nullptr);
+        }
+        else if (! resolveAll (is, child))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+juce::ValueTree BinaryEditFile::readEdit() const
+{
+    CRASH_TRACER
+
+    if (! isValid())
+        return {};
+
+    juce::FileInputStream is (file);
+
+    if (! is.openedOk())
+        return {};
+
+    // The skeleton is shared with anyone who has called getSkeleton() so read a fresh copy
+    auto edit = readChunk (is, 0);
+
+    if (! resolveAll (is, edit))
+        return {};
+
+    return edit;
+}
+
+//==============================================================================
+bool BinaryEditFile::write (juce::OutputStream& os, const juce::ValueTree& editState)
+{
+    CRASH_TRACER
+    using namespace binary_edit_file;
+    jassert (editState.hasType (IDs::EDIT));
+
+    std::vector<juce::ValueTree> subtrees;
+    auto skeleton = createSkeleton (editState, subtrees);
+
+    // Each chunk is serialised on its own so the table of contents can be written first
+    std::vector<juce::MemoryBlock> chunkData (subtrees.size() + 1);
+
+    {
+        juce::MemoryOutputStream mo (chunkData[0], false);
+        skeleton.writeToStream (mo);
+    }
+
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+        juce::MemoryOutputStream mo (chunkData[i + 1], false);
+        subtrees[i].writeToStream (mo);
+    }
+
+    const auto numChunks = static_cast<int> (chunkData.size());
+    const auto appVersion = editState[IDs::appVersion].toString();
+    const auto engineVersion = Engine::getVersion();
+
+    if (! os.write (magic, sizeof (magic))
+        || ! os.writeInt (currentVersion)
+        || ! os.writeInt (numChunks)
+        || ! os.writeString (appVersion)
+        || ! os.writeString (engineVersion))
+        return false;
+
+    auto offset = headerSize + getWrittenSize (appVersion) + getWrittenSize (engineVersion)
+                    + numChunks * tocEntrySize;
+
+    for (auto& data : chunkData)
+    {
+        const auto size = static_cast<juce::int64> (data.getSize());
+
+        if (! os.writeInt64 (offset) || ! os.writeInt64 (size))
+            return false;
+
+        offset += size;
+    }
+
+    for (auto& data : chunkData)
+        if (! os.write (data.getData(), data.getSize()))
+            return false;
+
+    return true;
+}
+
+bool BinaryEditFile::write (const juce::File& f, const juce::ValueTree& editState)
+{
+    const juce::TemporaryFile temp (f);
+
+    {
+        juce::FileOutputStream os (temp.getFile());
+
+        if (! os.openedOk() || ! write (os, editState))
+            return false;
+
+        os.flush();
+
+        if (! os.getStatus().wasOk())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+bool BinaryEditFile::isBinaryEditFile (const juce::File& f)
+{
+    juce::FileInputStream is (f);
+    return is.openedOk() && binary_edit_file::hasMagic (is);
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,114 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Reads and writes Edits in a chunked binary format.
+
+    The file starts with a magic number, the format version, the versions of the
+    app and engine that wrote it and a table of contents giving the position of
+    each chunk. Each chunk is a ValueTree written independently with
+    ValueTree::writeToStream.
+
+    The first chunk is the Edit's "skeleton". This is the complete Edit tree except
+    that the bulky subtrees (MIDI sequences, automation curves and plugins with
+    state blobs) are replaced by EDITCHUNK placeholders which hold the index of the
+    chunk containing the real subtree.
+
+    This means code that only looks at the Edit's structure, e.g. EditSnapshot,
+    can read the skeleton without touching the rest of the file and use resolve()
+    to read any other chunks it needs. A live Edit needs every sequence and curve
+    to build its playback graph, so readEdit() always reads every chunk.
+
+    The chunks are still all written together, so saving an Edit rewrites the
+    whole file even if only one chunk has changed.
+*/
+class BinaryEditFile
+{
+public:
+    /** Opens a file and reads its table of contents and skeleton.
+        Check isValid() to see if this succeeded.
+    */
+    explicit BinaryEditFile (const juce::File&);
+
+    /** Returns true if the file was a valid binary Edit file. */
+    bool isValid() const noexcept                       { return skeleton.isValid(); }
+
+    /** Returns the number of chunks in the file, including the skeleton. */
+    int getNumChunks() const noexcept                   { return static_cast<int> (chunks.size()); }
+
+    /** Returns the version of the app that saved the Edit.
+        This is empty for files written before the format stored it.
+    */
+    juce::String getAppVersion() const                  { return appVersion; }
+
+    /** Returns the Engine::getVersion() of the engine that wrote the file.
+        This is empty for files written before the format stored it.
+    */
+    juce::String getEngineVersion() const               { return engineVersion; }
+
+    //==============================================================================
+    /** Returns the Edit tree with placeholders in place of the bulky subtrees.
+        This is read when the file is opened so is cheap to call.
+    */
+    juce::ValueTree getSkeleton() const                 { return skeleton; }
+
+    /** If the tree is a placeholder, this reads the subtree it refers to from disk.
+        Any other tree is returned unchanged. Nothing is cached so each call reads
+        the chunk again, and an invalid tree is returned if it can't be read.
+    */
+    juce::ValueTree resolve (const juce::ValueTree& placeholderOrTree) const;
+
+    /** Reads the whole Edit, with all the placeholders resolved.
+        If any of the chunks can't be read this returns an invalid tree rather than
+        a partial Edit, so the caller can fall back to another copy.
+    */
+    juce::ValueTree readEdit() const;
+
+    //==============================================================================
+    /** Writes an Edit's state to a stream. */
+    static bool write (juce::OutputStream&, const juce::ValueTree& editState);
+
+    /** Writes an Edit's state to a file, via a temporary file. */
+    static bool write (const juce::File&, const juce::ValueTree& editState);
+
+    /** Returns true if the file starts with the binary Edit magic number. */
+    static bool isBinaryEditFile (const juce::File&);
+
+    /** Returns true if this is a placeholder for a chunk. */
+    static bool isPlaceholder (const juce::ValueTree&);
+
+    /** The version of the format that write() produces.
+        Version 2 added the app and engine versions to the header.
+    */
+    static constexpr int currentVersion = 2;
+
+private:
+    //==============================================================================
+    struct ChunkInfo
+    {
+        juce::int64 offset = 0, size = 0;
+    };
+
+    juce::File file;
+    juce::String appVersion, engineVersion;
+    std::vector<ChunkInfo> chunks;
+    juce::ValueTree skeleton;
+
+    juce::ValueTree readChunk (juce::InputStream&, int index) const;
+    bool resolveAll (juce::InputStream&, juce::ValueTree&) const;
+
+    JUCE_DECLARE_NON_COPYABLE (BinaryEditFile)
+};
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,266 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_BINARY_EDIT_FILE) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_BINARY_EDIT_FILE)
+
+namespace tracktion::inline engine
+{
+
+namespace binary_edit_file_test_utilities
+{
+    /** Creates an Edit state with MIDI clips, automation and plugin state to save. */
+    inline juce::ValueTree createEditState (int numTracks, int numClipsPerTrack, int numNotesPerClip)
+    {
+        juce::Random r (42);
+        juce::ValueTree edit (IDs::EDIT, { { IDs::appVersion, "test" } });
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            juce::ValueTree track (IDs::TRACK, { { IDs::id, t + 1 } });
+
+            for (int c = 0; c < numClipsPerTrack; ++c)
+            {
+                juce::ValueTree clip (IDs::MIDICLIP, { { IDs::start, c * 4.0 }, { IDs::length, 4.0 } });
+                juce::ValueTree sequence (IDs::SEQUENCE, { { IDs::ver, 1 } });
+
+                for (int n = 0; n < numNotesPerClip; ++n)
+                    sequence.appendChild (juce::ValueTree (IDs::NOTE, { { IDs::p, r.nextInt (128) },
+                                                                        { IDs::b, n * 0.25 },
+                                                                        { IDs::l, 0.25 },
+                                                                        { IDs::v, r.nextInt (128) } }),
+                                          nullptr);
+
+                clip.appendChild (sequence, nullptr);
+                track.appendChild (clip, nullptr);
+            }
+
+            juce::MemoryBlock pluginState (16 * 1024);
+            r.fillBitsRandomly (pluginState.getData(), pluginState.getSize());
+
+            juce::ValueTree plugin (IDs::PLUGIN, { { IDs::type, "vst" },
+                                                   { IDs::state, pluginState.toBase64Encoding() } });
+            juce::ValueTree curve (IDs::AUTOMATIONCURVE, { { IDs::paramID, "volume" } });
+
+            for (int i = 0; i < 100; ++i)
+                curve.appendChild (juce::ValueTree (IDs::POINT, { { IDs::t, i * 1.0 }, { IDs::v, r.nextFloat() } }), nullptr);
+
+            plugin.appendChild (curve, nullptr);
+            track.appendChild (plugin, nullptr);
+            edit.appendChild (track, nullptr);
+        }
+
+        return edit;
+    }
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_BINARY_EDIT_FILE
+
+//==============================================================================
+//==============================================================================
+class BinaryEditFileTests  : public juce::UnitTest
+{
+public:
+    BinaryEditFileTests()
+        : juce::UnitTest ("BinaryEditFile", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using namespace binary_edit_file_test_utilities;
+
+        beginTest ("Round trip");
+        {
+            auto editState = createEditState (4, 8, 100);
+            juce::TemporaryFile temp;
+
+            expect (BinaryEditFile::write (temp.getFile(), editState));
+            expect (BinaryEditFile::isBinaryEditFile (temp.getFile()));
+
+            BinaryEditFile file (temp.getFile());
+            expect (file.isValid());
+
+            // Skeleton + (sequences + plugins) per track
+            expectEquals (file.getNumChunks(), 1 + 4 * (8 + 1));
+            expect (file.readEdit().isEquivalentTo (editState));
+        }
+
+        beginTest ("Reading the skeleton");
+        {
+            auto editState = createEditState (2, 2, 10);
+            juce::TemporaryFile temp;
+            expect (BinaryEditFile::write (temp.getFile(), editState));
+
+            BinaryEditFile file (temp.getFile());
+            auto clip = file.getSkeleton().getChild (1).getChild (0);
+            expect (clip.hasType (IDs::MIDICLIP));
+            expect (BinaryEditFile::isPlaceholder (clip.getChild (0)));
+
+            // Placeholders can be read on their own, anything else is passed through
+            expect (file.resolve (clip.getChild (0)).isEquivalentTo (editState.getChild (1).getChild (0).getChild (0)));
+            expect (file.resolve (clip) == clip);
+        }
+
+        beginTest ("Versions");
+        {
+            auto& engine = *Engine::getEngines()[0];
+            juce::TemporaryFile temp;
+
+            // Edits saved by other versions go through updateLegacyEdit, which moves the old VIEWSTATE video properties
+            auto editState = createEditState (1, 1, 1);
+            editState.appendChild (juce::ValueTree ("VIEWSTATE", { { IDs::videoOffset, 1.0 } }), nullptr);
+            expect (BinaryEditFile::write (temp.getFile(), editState));
+
+            BinaryEditFile file (temp.getFile());
+            expectEquals (file.getAppVersion(), juce::String ("test"));
+            expectEquals (file.getEngineVersion(), Engine::getVersion());
+            expect (file.readEdit().isEquivalentTo (editState));
+
+            auto loaded = loadEditFromFile (engine, temp.getFile(), ProjectItemID());
+            expect (loaded.getChildWithName (IDs::VIDEO).hasProperty (IDs::videoOffset));
+
+            // Ones saved by this build are already up to date so are loaded as they are
+            editState.setProperty (IDs::appVersion, engine.getPropertyStorage().getApplicationVersion(), nullptr);
+            expect (BinaryEditFile::write (temp.getFile(), editState));
+
+            loaded = loadEditFromFile (engine, temp.getFile(), ProjectItemID());
+            expect (! loaded.getChildWithName (IDs::VIDEO).isValid());
+            expect (loaded.getChildWithName ("VIEWSTATE").hasProperty (IDs::videoOffset));
+        }
+
+        beginTest ("Chunks that can't be read");
+        {
+            auto& engine = *Engine::getEngines()[0];
+            juce::TemporaryFile temp;
+            expect (BinaryEditFile::write (temp.getFile(), createEditState (2, 2, 10)));
+
+            // Zero the last chunk, leaving the header, table of contents and skeleton intact
+            juce::MemoryBlock data;
+            expect (temp.getFile().loadFileAsData (data));
+
+            juce::MemoryInputStream is (data, false);
+            is.skipNextBytes (4);
+            is.readInt();
+            const auto numChunks = is.readInt();
+            is.readString();
+            is.readString();
+            is.skipNextBytes ((numChunks - 1) * 16);
+            const auto lastChunkOffset = is.readInt64();
+            const auto lastChunkSize = is.readInt64();
+
+            std::memset (static_cast<char*> (data.getData()) + lastChunkOffset, 0, static_cast<size_t> (lastChunkSize));
+            expect (temp.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            // The structure can still be read but the Edit can't, so callers can fall back to another copy
+            BinaryEditFile file (temp.getFile());
+            expect (file.isValid());
+            expect (! file.readEdit().isValid());
+            expect (! loadEditFromFile (engine, temp.getFile(), ProjectItemID()).isValid());
+        }
+
+        beginTest ("Invalid files");
+        {
+            juce::TemporaryFile temp;
+            expect (! BinaryEditFile (temp.getFile()).isValid());
+
+            expect (temp.getFile().replaceWithText ("<EDIT/>"));
+            expect (! BinaryEditFile::isBinaryEditFile (temp.getFile()));
+            expect (! BinaryEditFile (temp.getFile()).isValid());
+
+            // Truncate the file part way through the table of contents
+            expect (BinaryEditFile::write (temp.getFile(), createEditState (1, 1, 1)));
+            juce::MemoryBlock data;
+            expect (temp.getFile().loadFileAsData (data));
+            data.setSize (20);
+            expect (temp.getFile().replaceWithData (data.getData(), data.getSize()));
+            expect (! BinaryEditFile (temp.getFile()).isValid());
+        }
+    }
+};
+
+static BinaryEditFileTests binaryEditFileTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_BINARY_EDIT_FILE
+
+//==============================================================================
+//==============================================================================
+class BinaryEditFileBenchmarks  : public juce::UnitTest
+{
+public:
+    BinaryEditFileBenchmarks()
+        : juce::UnitTest ("BinaryEditFile", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        using namespace binary_edit_file_test_utilities;
+
+        beginTest ("Benchmark: BinaryEditFile");
+        {
+            auto& engine = *Engine::getEngines()[0];
+
+            // Roughly 500k notes, in the region of 50MB as XML
+            auto editState = createEditState (50, 20, 500);
+
+            // Saved by this build so loading doesn't go through updateLegacyEdit
+            editState.setProperty (IDs::appVersion, engine.getPropertyStorage().getApplicationVersion(), nullptr);
+            juce::TemporaryFile xmlFile, binaryFile;
+
+            {
+                ScopedBenchmark sb (getDescription ("Save XML"));
+
+                if (auto xml = editState.createXml())
+                    expect (xml->writeTo (xmlFile.getFile()));
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Save binary"));
+                expect (BinaryEditFile::write (binaryFile.getFile(), editState));
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Load XML"));
+                expect (loadEditFromFile (engine, xmlFile.getFile(), ProjectItemID()).hasType (IDs::EDIT));
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Load binary"));
+                expect (loadEditFromFile (engine, binaryFile.getFile(), ProjectItemID()).hasType (IDs::EDIT));
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Load binary skeleton"));
+                expect (BinaryEditFile (binaryFile.getFile()).getSkeleton().hasType (IDs::EDIT));
+            }
+
+            logMessage ("XML size: " + juce::File::descriptionOfSizeInBytes (xmlFile.getFile().getSize()));
+            logMessage ("Binary size: " + juce::File::descriptionOfSizeInBytes (binaryFile.getFile().getSize()));
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName + " (50 tracks, 1000 MIDI clips, 500k notes)";
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+};
+
+static BinaryEditFileBenchmarks binaryEditFileBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif
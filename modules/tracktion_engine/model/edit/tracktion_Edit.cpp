@@ -570,6 +570,125 @@ struct Edit::MirroredPluginUpdateTimer  : private juce::Timer
     juce::Array<SafeSelectable<Plugin>> changedPlugins;
 };
 
+//==============================================================================
+namespace edit_loading
+{
+    static void findAudioFileSources (const juce::ValueTree& v, juce::StringArray& sources)
+    {
+        if ((v.hasType (IDs::AUDIOCLIP) || v.hasType (IDs::TAKE)) && v.hasProperty (IDs::source))
+            sources.add (v[IDs::source].toString());
+
+        for (const auto& child : v)
+            findAudioFileSources (child, sources);
+    }
+
+    /** Starts some threads which share out the indexes up to numItems between them,
+        calling the function with each. They stop early if shouldExit is set.
+    */
+    template<typename Function>
+    std::vector<std::thread> startWorkers (size_t numItems, const std::atomic<bool>* shouldExit, Function fn)
+    {
+        const auto numThreads = std::min (static_cast<size_t> (std::clamp (juce::SystemStats::getNumCpus() - 1, 1, 8)),
+                                          numItems);
+        auto nextIndex = std::make_shared<std::atomic<size_t>> (0);
+        std::vector<std::thread> threads;
+
+        for (size_t i = 0; i < numThreads; ++i)
+            threads.emplace_back ([nextIndex, numItems, shouldExit, fn]
+                                  {
+                                      for (auto index = (*nextIndex)++; index < numItems; index = (*nextIndex)++)
+                                      {
+                                          if (shouldExit != nullptr && shouldExit->load())
+                                              return;
+
+                                          fn (index);
+                                      }
+                                  });
+
+        return threads;
+    }
+
+    /** Reads the info for an Edit's audio files on some background threads so it's
+        already cached by the time the clips ask for it.
+    */
+    class AudioFileInfoPrefetcher
+    {
+    public:
+        AudioFileInfoPrefetcher (Edit& edit, const std::atomic<bool>* shouldExit)
+        {
+            CRASH_TRACER
+            juce::StringArray sources;
+            findAudioFileSources (edit.state, sources);
+            sources.removeDuplicates (false);
+
+            for (auto& source : sources)
+                if (auto f = SourceFileReference::findFileFromString (edit, source); f.existsAsFile())
+                    files.emplace_back (edit.engine, f);
+
+            threads = startWorkers (files.size(), shouldExit,
+                                    [this, &afm = edit.engine.getAudioFileManager()] (size_t index)
+                                    {
+                                        afm.getInfo (files[index]);
+                                    });
+        }
+
+        ~AudioFileInfoPrefetcher()
+        {
+            waitForCompletion();
+        }
+
+        void waitForCompletion()
+        {
+            for (auto& t : threads)
+                if (t.joinable())
+                    t.join();
+        }
+
+    private:
+        std::vector<AudioFile> files;
+        std::vector<std::thread> threads;
+    };
+
+    /** Builds the streams for the automation curves of the Edit's parameters and its
+        clip effects' plugins on some worker threads.
+        The parameters of each AutomatableEditItem are built on the same thread as they
+        share the item's list of active parameters. This must be called whilst the Edit
+        is loading and with the message thread blocked, so a parameter's deferred update
+        can't run at the same time as it's built here.
+    */
+    static void updateCurveStreams (Edit& edit, const std::atomic<bool>* shouldExit)
+    {
+        CRASH_TRACER
+        auto params = edit.getAllAutomatableParams (true);
+
+        for (auto effect : getAllClipEffects (edit))
+            params.addArray (effect->getAutomatableParameters());
+
+        std::map<AutomatableEditItem*, std::vector<AutomatableParameter*>> paramsForItems;
+
+        for (auto param : params)
+        {
+            auto& itemParams = paramsForItems[&param->automatableEditElement];
+
+            if (std::find (itemParams.begin(), itemParams.end(), param) == itemParams.end())
+                itemParams.push_back (param);
+        }
+
+        std::vector<std::vector<AutomatableParameter*>> groups;
+
+        for (auto& [item, itemParams] : paramsForItems)
+            groups.push_back (std::move (itemParams));
+
+        for (auto& t : startWorkers (groups.size(), shouldExit,
+                                     [&groups] (size_t index)
+                                     {
+                                         for (auto param : groups[index])
+                                             param->updateCurveStream();
+                                     }))
+            t.join();
+    }
+}
+
 //==============================================================================
 static int getNextInstanceId() noexcept
 {
@@ -806,6 +925,18 @@ void Edit::initialise (const Options& options)
     if (loadContext != nullptr)
         loadContext->progress = 0.0f;
 
+    auto timePhase = [this] (const char* phaseName, auto&& phase)
+    {
+        const StopwatchTimer phaseTimer;
+        phase();
+
+        if (loadContext != nullptr)
+            loadContext->phaseTimings.push_back ({ phaseName, phaseTimer.getSeconds() });
+    };
+
+    // The audio file headers are read in the background while the tracks and plugins are created
+    edit_loading::AudioFileInfoPrefetcher audioFilePrefetcher (*this, loadContext != nullptr ? &loadContext->shouldExit : nullptr);
+
     treeWatcher = std::make_unique<TreeWatcher> (*this, state);
 
     isLoadInProgress = true;
@@ -819,16 +950,23 @@ void Edit::initialise (const Options& options)
     lastSignificantChange.referTo (state, IDs::lastSignificantChange, nullptr,
                                    juce::String::toHexString (juce::Time::getCurrentTime().toMilliseconds()));
 
-    globalMacros = std::make_unique<GlobalMacros> (*this);
-    initialiseTempoAndPitch();
-    initialiseTransport();
-    initialiseVideo();
-    initialiseClickTrack();
-    initialiseMasterVolume (options);
-    initialiseRacks();
-    initialiseMasterPlugins();
-    initialiseAudioDevices();
-    loadTracks();
+    timePhase ("Global state", [&]
+               {
+                   globalMacros = std::make_unique<GlobalMacros> (*this);
+                   initialiseTempoAndPitch();
+                   initialiseTransport();
+                   initialiseVideo();
+                   initialiseClickTrack();
+                   initialiseMasterVolume (options);
+                   initialiseRacks();
+                   initialiseMasterPlugins();
+                   initialiseAudioDevices();
+               });
+
+    // Plugins are created and restored serially as their tracks load. They register
+    // themselves with the Edit's shared plugin lists as they're created and external
+    // plugins have to be created and have their state restored on the message thread.
+    timePhase ("Load tracks", [this] { loadTracks(); });
 
     if (loadContext != nullptr)
     {
@@ -836,45 +974,62 @@ void Edit::initialise (const Options& options)
         loadContext->progress = 1.0f;
     }
 
-    initialiseTracks (options);
-    initialiseARA();
-    updateMuteSoloStatuses();
-    readFrozenTracksFiles();
+    timePhase ("Audio file info", [&audioFilePrefetcher] { audioFilePrefetcher.waitForCompletion(); });
 
-    getLength(); // forcibly update the length before the isLoadInProgress is disabled.
+    timePhase ("Initialise tracks", [&]
+               {
+                   initialiseTracks (options);
+                   initialiseARA();
+                   updateMuteSoloStatuses();
+                   readFrozenTracksFiles();
 
-    for (auto t : getAllTracks (*this))
-        t->cancelAnyPendingUpdates();
-
-    initialiseControllerMappings();
+                   getLength(); // forcibly update the length before the isLoadInProgress is disabled.
 
-    callBlocking ([this]
-                  {
-                      TemporaryFileManager::purgeOrphanFreezeAndProxyFiles (*this);
+                   for (auto t : getAllTracks (*this))
+                       t->cancelAnyPendingUpdates();
 
-                      // Must be set to false before curve updates
-                      // but set inside here to give the message loop some time to dispatch async updates
-                      isLoadInProgress = false;
-                      auto cursorPos = getTransport().getPosition();
+                   initialiseControllerMappings();
+               });
 
-                      for (auto mpl : getAllMacroParameterLists (*this))
-                          for (auto mp : mpl->getMacroParameters())
-                              mp->initialise();
+    timePhase ("Automation streams", [this]
+               {
+                   callBlocking ([this]
+                      {
+                          edit_loading::updateCurveStreams (*this, loadContext != nullptr ? &loadContext->shouldExit : nullptr);
+                      });
+               });
 
-                      for (auto ap : getAllAutomatableParams (true))
+    timePhase ("Message thread attach", [this]
+               {
+                   callBlocking ([this]
                       {
-                          ap->updateStream();
+                          TemporaryFileManager::purgeOrphanFreezeAndProxyFiles (*this);
+
+                          // Must be set to false before curve updates
+                          // but set inside here to give the message loop some time to dispatch async updates
+                          isLoadInProgress = false;
+                          auto cursorPos = getTransport().getPosition();
+
+                          for (auto mpl : getAllMacroParameterLists (*this))
+                              for (auto mp : mpl->getMacroParameters())
+                                  mp->initialise();
+
+                          // The curve streams are already built so this only updates the modifier streams
+                          for (auto ap : getAllAutomatableParams (true))
+                          {
+                              ap->updateStream();
 
-                          if (ap->isAutomationActive())
-                              ap->updateFromAutomationSources (cursorPos);
-                      }
+                              if (ap->isAutomationActive())
+                                  ap->updateFromAutomationSources (cursorPos);
+                          }
 
-                      for (auto effect : getAllClipEffects (*this))
-                          effect->initialise();
+                          for (auto effect : getAllClipEffects (*this))
+                              effect->initialise();
 
-                      for (auto p : getAllPlugins (*this, true))
-                          p->trackPropertiesChanged();
-                  });
+                          for (auto p : getAllPlugins (*this, true))
+                              p->trackPropertiesChanged();
+                      });
+               });
 
     cancelAnyPendingUpdates();
 
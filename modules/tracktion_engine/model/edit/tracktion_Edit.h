@@ -93,6 +93,16 @@ public:
         std::atomic<bool> completed  { false }; /**< Set to true once the Edit has loaded. */
         std::atomic<bool> shouldExit { false }; /**< Can be set to true to cancel loading the Edit. */
 
+        /** The time taken by one phase of loading the Edit. */
+        struct PhaseTiming
+        {
+            juce::String name;
+            double seconds = 0.0;
+        };
+
+        /** The phases of loading in the order they ran. Only read this once completed is true. */
+        std::vector<PhaseTiming> phaseTimings;
+
     private:
         friend Edit;
         std::atomic<int> totalNumTracks { 0 };
@@ -41,6 +41,8 @@ public:
     void runTest() override
     {
         testFilePreviewing();
+        testLoadTimings();
+        testFindingItemsByID();
     }
 
 private:
@@ -60,6 +62,74 @@ private:
         expect (edit != nullptr);
         expect (! couldMatchTempo);
     }
+
+    void testLoadTimings()
+    {
+        beginTest ("Load phase timings");
+
+        auto& engine = *tracktion::engine::Engine::getEngines()[0];
+        auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (44100.0, 1.0);
+
+        auto editState = createEmptyEdit (engine);
+
+        {
+            Edit edit ({ engine, editState, ProjectItemID::createNewID (0) });
+
+            for (int i = 0; i < 8; ++i)
+                if (auto at = getAudioTracks (edit)[0])
+                    at->insertWaveClip ("Sin", sinFile->getFile(), { .time = { TimePosition::fromSeconds (i), TimeDuration::fromSeconds (1.0) } }, false);
+
+            auto& curve = getAudioTracks (edit)[0]->getVolumePlugin()->volParam->getCurve();
+            curve.addPoint (TimePosition(), 0.2f, 0.0f, nullptr);
+            curve.addPoint (TimePosition::fromSeconds (8.0), 0.8f, 0.0f, nullptr);
+
+            editState = edit.state.createCopy();
+        }
+
+        engine.getAudioFileManager().clearFiles();
+
+        Edit::LoadContext loadContext;
+        Edit edit ({ .engine = engine, .editState = editState, .editProjectItemID = ProjectItemID::createNewID (0), .loadContext = &loadContext });
+
+        expect (loadContext.completed);
+        expectEquals (static_cast<int> (loadContext.phaseTimings.size()), 6);
+
+        for (auto& phase : loadContext.phaseTimings)
+            expect (phase.name.isNotEmpty() && phase.seconds >= 0.0);
+
+        // The clip's audio file info should have been read by the time the Edit has loaded
+        expectEquals (getAudioTracks (edit)[0]->getClips().size(), 8);
+        expect (AudioFile (engine, sinFile->getFile()).isValid());
+
+        // The automation stream should have been built so the volume follows its curve
+        expectWithinAbsoluteError (getAudioTracks (edit)[0]->getVolumePlugin()->volParam->getCurrentValue(), 0.2f, 0.001f);
+    }
+
+    void testFindingItemsByID()
+    {
+        beginTest ("Finding items by ID");
+
+        auto& engine = *tracktion::engine::Engine::getEngines()[0];
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto track = getAudioTracks (*edit)[0];
+        auto clip = track->insertMIDIClip ({ 0.0s, TimePosition (1.0s) }, nullptr);
+        const auto clipID = clip->itemID;
+
+        expect (findTrackForID (*edit, track->itemID) == track);
+        expect (findClipForID (*edit, clipID) == clip.get());
+        expect (findClipForID (*edit, track->itemID) == nullptr);
+
+        for (auto p : track->pluginList)
+            expect (findPluginForID (*edit, p->itemID) == p);
+
+        // The clip object is kept alive here but it's no longer in the Edit
+        edit->getUndoManager().beginNewTransaction();
+        clip->removeFromParent();
+        expect (findClipForID (*edit, clipID) == nullptr);
+
+        edit->undo();
+        expect (findClipForID (*edit, clipID) != nullptr);
+    }
 };
 
 static EditTests editTests;
@@ -182,6 +252,40 @@ public:
            #endif
         }
 
+        {
+            std::vector<EditItemID> clipIDs, trackIDs;
+
+            for (auto at : getAudioTracks (*edit))
+            {
+                trackIDs.push_back (at->itemID);
+
+                for (auto c : at->getClips())
+                    clipIDs.push_back (c->itemID);
+            }
+
+            expectEquals (static_cast<int> (clipIDs.size()), 10'000);
+            int numFound = 0;
+
+            {
+                ScopedBenchmark sb (getDescription ("Find all 10,000 clips by ID"));
+
+                for (auto id : clipIDs)
+                    if (findClipForID (*edit, id) != nullptr)
+                        ++numFound;
+            }
+
+            {
+                ScopedBenchmark sb (getDescription ("Find all 100 tracks by ID 100 times"));
+
+                for (int i = 0; i < 100; ++i)
+                    for (auto id : trackIDs)
+                        if (findTrackForID (*edit, id) != nullptr)
+                            ++numFound;
+            }
+
+            expectEquals (numFound, 20'000);
+        }
+
         {
             auto editStateCopy = edit->state.createCopy();
 
@@ -23,10 +23,23 @@ struct ThreadedEditFileWriter   : private juce::Thread
         jassert (pending.isEmpty());
     }
 
-    void writeTreeToFile (juce::ValueTree&& v, const juce::File& f)
+    /** Writes a tree to a file, then calls onWritten with whether it succeeded. */
+    void writeTreeToFile (juce::ValueTree&& v, const juce::File& f, std::function<void (bool)> onWritten)
+    {
+        addJob ([tree = std::move (v), f, onWritten = std::move (onWritten)]
+                {
+                    const bool ok = BinaryEditFile::write (f, tree);
+
+                    if (onWritten)
+                        onWritten (ok);
+                });
+    }
+
+    /** Adds a job to be run in order with the file writes. */
+    void addJob (std::function<void()> job)
     {
         TRACKTION_ASSERT_MESSAGE_THREAD
-        pending.add (std::pair<juce::ValueTree, juce::File> (v, f));
+        pending.add (std::move (job));
         waiter.signal();
         startThread();
     }
@@ -46,21 +59,18 @@ private:
     {
         while (! threadShouldExit())
         {
+            // Jobs are only removed once they've finished so flushAllFiles waits for the last one
             while (! pending.isEmpty())
-                writeToFile (pending.removeAndReturn (0));
+            {
+                pending.getFirst()();
+                pending.remove (0);
+            }
 
             waiter.wait (1000);
         }
     }
 
-    void writeToFile (std::pair<juce::ValueTree, juce::File> item)
-    {
-        item.second.deleteFile();
-        juce::FileOutputStream os (item.second);
-        item.first.writeToStream (os);
-    }
-
-    juce::Array<std::pair<juce::ValueTree, juce::File>, juce::CriticalSection> pending;
+    juce::Array<std::function<void()>, juce::CriticalSection> pending;
     juce::WaitableEvent waiter;
 };
 
@@ -81,7 +91,10 @@ struct SharedEditFileDataCache
 
             // If we managed to shutdown cleanly (i.e. without crashing) then delete the temp file
             if (auto item = getProjectItemForEdit (edit))
+            {
                 EditFileOperations::getTempVersionOfEditFile (item->getSourceFile()).deleteFile();
+                EditFileOperations::getTempJournalOfEditFile (item->getSourceFile()).deleteFile();
+            }
         }
 
         void refresh()
@@ -92,6 +105,7 @@ struct SharedEditFileDataCache
         Edit& edit;
         juce::Time timeOfLastSave { juce::Time::getCurrentTime() };
         EditSnapshot::Ptr editSnapshot { EditSnapshot::getEditSnapshot (edit.engine, edit.getProjectItemID()) };
+        EditJournal journal { edit.state };
     };
 
     SharedEditFileDataCache() = default;
@@ -140,9 +154,9 @@ struct EditFileOperations::SharedDataPimpl
         cache->cleanUp();
     }
 
-    void writeValueTreeToDisk (juce::ValueTree&& v, const juce::File& f)
+    void writeValueTreeToDisk (juce::ValueTree&& v, const juce::File& f, std::function<void (bool)> onWritten = {})
     {
-        editFileWriter->writeTreeToFile (std::move (v), f);
+        editFileWriter->writeTreeToFile (std::move (v), f, std::move (onWritten));
     }
 
     juce::SharedResourcePointer<SharedEditFileDataCache> cache;
@@ -195,7 +209,9 @@ bool EditFileOperations::writeToFile (const juce::File& file, bool writeQuickBin
             if (editSnapshot != nullptr)
                 editSnapshot->setState (edit.state, edit.getLength());
 
-            if (auto xml = edit.state.createXml())
+            if (edit.engine.getEngineBehaviour().saveEditsAsBinary())
+                ok = BinaryEditFile::write (file, edit.state);
+            else if (auto xml = edit.state.createXml())
                 ok = xml->writeTo (file);
 
             jassert (ok);
@@ -399,7 +415,68 @@ bool EditFileOperations::saveTempVersion (bool forceSaveEvenIfUnchanged)
     if (! (forceSaveEvenIfUnchanged || edit.hasChangedSinceSaved()))
         return true;
 
-    return writeToFile (getTempVersionFile(), ! forceSaveEvenIfUnchanged);
+    auto& journal = sharedDataPimpl->data->journal;
+    auto tempFile = getTempVersionFile();
+    auto journalFile = getTempJournalOfEditFile (getEditFile());
+
+    if (forceSaveEvenIfUnchanged)
+    {
+        // This writes the full Edit to the temp file which is about to become the Edit
+        // file, so any existing journal no longer applies to it
+        const bool ok = writeToFile (tempFile, false);
+        journal.reset();
+        journalFile.deleteFile();
+        return ok;
+    }
+
+    if (tempFile == juce::File())
+        return false;
+
+    // Compact to a new snapshot once the journal is half the size of the last one
+    constexpr juce::int64 minJournalSize = 1024 * 1024;
+
+    if (journal.needsSnapshot (tempFile, std::max (minJournalSize, tempFile.getSize() / 2)))
+    {
+        // If the snapshot can't be written, the old one is left as it was so its journal
+        // is still valid and gets the changes that would have been in the new snapshot
+        auto changes = journal.takePendingChanges();
+        journal.snapshotTaken (tempFile);
+
+        sharedDataPimpl->writeValueTreeToDisk (edit.state.createCopy(), tempFile,
+                                               [tempFile, journalFile, changes = std::move (changes)] (bool snapshotWritten)
+                                               {
+                                                   if (snapshotWritten)
+                                                       EditJournal::startJournal (journalFile, tempFile);
+                                                   else if (changes.getSize() > 0)
+                                                       EditJournal::appendToJournal (journalFile, changes);
+                                               });
+    }
+    else if (journal.hasPendingChanges())
+    {
+        sharedDataPimpl->editFileWriter->addJob ([journalFile, changes = journal.takePendingChanges()]
+                                                 { EditJournal::appendToJournal (journalFile, changes); });
+    }
+
+    return true;
+}
+
+juce::File EditFileOperations::getTempJournalOfEditFile (const juce::File& f)
+{
+    return f != juce::File() ? getTempVersionOfEditFile (f).withFileExtension ("journal")
+                             : juce::File();
+}
+
+juce::ValueTree EditFileOperations::loadTempVersionOfEditFile (const juce::File& f)
+{
+    CRASH_TRACER
+    auto tempFile = getTempVersionOfEditFile (f);
+    auto state = BinaryEditFile::isBinaryEditFile (tempFile) ? BinaryEditFile (tempFile).readEdit()
+                                                             : loadValueTree (tempFile, IDs::EDIT);
+
+    if (state.isValid())
+        EditJournal::replayJournal (getTempJournalOfEditFile (f), tempFile, state);
+
+    return state;
 }
 
 juce::File EditFileOperations::getTempVersionOfEditFile (const juce::File& f)
@@ -416,6 +493,8 @@ juce::File EditFileOperations::getTempVersionFile() const
 void EditFileOperations::deleteTempVersion()
 {
     getTempVersionFile().deleteFile();
+    getTempJournalOfEditFile (getEditFile()).deleteFile();
+    sharedDataPimpl->data->journal.reset();
 }
 
 //==============================================================================
@@ -443,7 +522,21 @@ juce::ValueTree loadEditFromFile (Engine& e, const juce::File& f, ProjectItemID
     CRASH_TRACER
     juce::ValueTree state;
 
-    if (auto xml = juce::parseXML (f))
+    if (BinaryEditFile::isBinaryEditFile (f))
+    {
+        if (BinaryEditFile binaryFile (f); binaryFile.isValid())
+        {
+            state = binaryFile.readEdit();
+
+            // Files saved by this build already have the current structure so can skip the XML round-trip
+            const bool writtenByThisBuild = binaryFile.getAppVersion() == e.getPropertyStorage().getApplicationVersion()
+                                              && binaryFile.getEngineVersion() == Engine::getVersion();
+
+            if (state.isValid() && ! writtenByThisBuild)
+                state = updateLegacyEdit (state);
+        }
+    }
+    else if (auto xml = juce::parseXML (f))
     {
         updateLegacyEdit (*xml);
         state = juce::ValueTree::fromXml (*xml);
@@ -29,10 +29,30 @@ public:
 
     bool writeToFile (const juce::File&, bool writeQuickBinaryVersion);
 
+    /** Saves a temporary copy of the Edit alongside the Edit file.
+        When forceSaveEvenIfUnchanged is false (i.e. for autosaves) this only appends the
+        changes since the last call to a journal, periodically compacting it to a full
+        snapshot. Use loadTempVersionOfEditFile to recover the state from these.
+    */
     bool saveTempVersion (bool forceSaveEvenIfUnchanged);
     void deleteTempVersion();
     juce::File getTempVersionFile() const;
+
+    /** Returns the file the temporary version of an Edit is saved to.
+        N.B. Since autosaves append to a journal, this file on its own is only the state
+        at the last snapshot and is missing any changes made since. To recover an Edit,
+        use loadTempVersionOfEditFile rather than opening this file directly.
+        @see getTempJournalOfEditFile
+    */
     static juce::File getTempVersionOfEditFile (const juce::File&);
+
+    /** Returns the journal of changes made since the temporary version was written. */
+    static juce::File getTempJournalOfEditFile (const juce::File&);
+
+    /** Loads the temporary version of an Edit file and replays its journal on top of it.
+        This can be used to recover an Edit after a crash.
+    */
+    static juce::ValueTree loadTempVersionOfEditFile (const juce::File&);
     static void updateEditFiles();
 
     juce::Time getTimeOfLastSave() const    { return timeOfLastSave; }
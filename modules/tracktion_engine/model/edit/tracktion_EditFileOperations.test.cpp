@@ -0,0 +1,93 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_EDIT_FILE_OPERATIONS
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class EditFileOperationsTests  : public juce::UnitTest
+{
+public:
+    EditFileOperationsTests()
+        : juce::UnitTest ("EditFileOperations", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Recovering autosaved changes");
+        {
+            auto& engine = *Engine::getEngines()[0];
+            juce::TemporaryFile editFile (".tracktionedit");
+            juce::SharedResourcePointer<ThreadedEditFileWriter> editFileWriter;
+
+            auto edit = createEmptyEdit (engine, editFile.getFile());
+            EditFileOperations fileOperations (*edit);
+
+            const auto tempFile = EditFileOperations::getTempVersionOfEditFile (editFile.getFile());
+            const auto journalFile = EditFileOperations::getTempJournalOfEditFile (editFile.getFile());
+
+            // The first autosave writes a snapshot
+            edit->ensureNumberOfAudioTracks (1);
+            getAudioTracks (*edit)[0]->setName ("First");
+            autosave (*edit, fileOperations, *editFileWriter);
+
+            expect (tempFile.existsAsFile());
+            expect (journalFile.existsAsFile());
+
+            // Later ones only append to the journal
+            const auto snapshotSize = tempFile.getSize();
+
+            for (int i = 0; i < 3; ++i)
+            {
+                edit->ensureNumberOfAudioTracks (i + 2);
+                getAudioTracks (*edit)[0]->setName ("Change " + juce::String (i));
+                autosave (*edit, fileOperations, *editFileWriter);
+            }
+
+            const auto stateAtLastAutosave = edit->state.createCopy();
+            expectEquals (tempFile.getSize(), snapshotSize);
+            expect (! BinaryEditFile (tempFile).readEdit().isEquivalentTo (stateAtLastAutosave));
+
+            // Nothing else is saved, as if the app crashed here
+            getAudioTracks (*edit)[0]->setName ("Lost");
+
+            auto recovered = EditFileOperations::loadTempVersionOfEditFile (editFile.getFile());
+            expect (recovered.isEquivalentTo (stateAtLastAutosave));
+
+            auto recoveredEdit = loadEditFromState (engine, recovered);
+            expectEquals (getAudioTracks (*recoveredEdit).size(), 4);
+            expectEquals (getAudioTracks (*recoveredEdit)[0]->getName(), juce::String ("Change 2"));
+
+            // A full save replaces the snapshot and its journal
+            expect (fileOperations.saveTempVersion (true));
+            expect (! journalFile.existsAsFile());
+            expect (EditFileOperations::loadTempVersionOfEditFile (editFile.getFile()).isEquivalentTo (edit->state));
+
+            fileOperations.deleteTempVersion();
+        }
+    }
+
+private:
+    void autosave (Edit& edit, EditFileOperations& fileOperations, ThreadedEditFileWriter& editFileWriter)
+    {
+        edit.markAsChanged();
+        expect (fileOperations.saveTempVersion (false));
+        editFileWriter.flushAllFiles();
+    }
+};
+
+static EditFileOperationsTests editFileOperationsTests;
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -104,7 +104,14 @@ private:
 
 
 //==============================================================================
-/** */
+/**
+    A registry of the EditItems of a given type that currently exist, keyed by
+    their EditItemID. Items add and remove themselves as they are created and
+    destroyed so looking one up doesn't need to walk the Edit.
+
+    Note that an item can outlive its place in the Edit (e.g. while it's held by
+    the undo history) so callers should check it's still part of the Edit.
+*/
 template<typename EditItemType>
 struct EditItemCache
 {
@@ -121,6 +128,7 @@ struct EditItemCache
         return {};
     }
 
+    /** Visits the items in no particular order. */
     template<typename Visitor>
     void visitItems (Visitor&& visitor) const
     {
@@ -138,12 +146,16 @@ struct EditItemCache
 
     void removeItem (EditItemType& item)
     {
-        if (item.itemID.isValid())
-            knownEditItems.erase (item.itemID);
+        if (! item.itemID.isValid())
+            return;
+
+        // Don't remove a different item that has been registered with the same ID
+        if (auto o = knownEditItems.find (item.itemID); o != knownEditItems.end() && o->second == &item)
+            knownEditItems.erase (o);
     }
 
 private:
-    std::map<EditItemID, EditItemType*> knownEditItems;
+    std::unordered_map<EditItemID, EditItemType*> knownEditItems;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EditItemCache)
 };
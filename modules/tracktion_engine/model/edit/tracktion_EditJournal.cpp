@@ -0,0 +1,419 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace edit_journal
+{
+    static constexpr char magic[] = { 'T', 'E', 'D', 'J' };
+    static constexpr int currentVersion = 1;
+
+    enum class Change : uint8_t
+    {
+        propertyChanged = 1,
+        propertyRemoved,
+        childAdded,
+        childRemoved,
+        childMoved,
+        subtreeReplaced
+    };
+
+    static bool isCoalesced (const juce::ValueTree& v)
+    {
+        return v.hasType (IDs::SEQUENCE) || v.hasType (IDs::AUTOMATIONCURVE);
+    }
+
+    /** Returns the child indexes leading from the root to a tree, or an empty optional if it isn't in the root. */
+    static std::optional<std::vector<int>> getPath (const juce::ValueTree& root, juce::ValueTree v)
+    {
+        std::vector<int> path;
+
+        while (v != root)
+        {
+            auto parent = v.getParent();
+
+            if (! parent.isValid())
+                return {};
+
+            path.push_back (parent.indexOf (v));
+            v = parent;
+        }
+
+        std::reverse (path.begin(), path.end());
+        return path;
+    }
+
+    static void writePath (juce::OutputStream& os, const std::vector<int>& path)
+    {
+        os.writeCompressedInt (static_cast<int> (path.size()));
+
+        for (auto index : path)
+            os.writeCompressedInt (index);
+    }
+
+    static juce::ValueTree readPath (juce::InputStream& is, juce::ValueTree v)
+    {
+        const auto depth = is.readCompressedInt();
+
+        for (int i = 0; i < depth && v.isValid(); ++i)
+        {
+            const auto index = is.readCompressedInt();
+            v = juce::isPositiveAndBelow (index, v.getNumChildren()) ? v.getChild (index) : juce::ValueTree();
+        }
+
+        return depth >= 0 ? v : juce::ValueTree();
+    }
+
+    static bool readHeader (juce::InputStream& is, juce::int64& snapshotSize, juce::int64& snapshotTime)
+    {
+        char header[std::size (magic)] = {};
+
+        if (is.read (header, static_cast<int> (std::size (header))) != static_cast<int> (std::size (header))
+            || ! std::equal (std::begin (header), std::end (header), std::begin (magic))
+            || is.readInt() != currentVersion)
+            return false;
+
+        snapshotSize = is.readInt64();
+        snapshotTime = is.readInt64();
+        return true;
+    }
+}
+
+//==============================================================================
+EditJournal::EditJournal (const juce::ValueTree& editState)
+    : state (editState)
+{
+    state.addListener (this);
+}
+
+EditJournal::~EditJournal()
+{
+    state.removeListener (this);
+}
+
+//==============================================================================
+bool EditJournal::hasPendingChanges() const noexcept
+{
+    return pendingChanges.getDataSize() > 0 || ! changedSubtrees.empty();
+}
+
+juce::MemoryBlock EditJournal::takePendingChanges()
+{
+    CRASH_TRACER
+    using namespace edit_journal;
+
+    // Subtrees are written with their current paths, after any structural changes that moved them
+    for (auto& v : changedSubtrees)
+    {
+        if (auto path = getPath (state, v))
+        {
+            pendingChanges.writeByte (static_cast<char> (Change::subtreeReplaced));
+            writePath (pendingChanges, *path);
+            v.writeToStream (pendingChanges);
+        }
+    }
+
+    changedSubtrees.clear();
+
+    auto changes = pendingChanges.getMemoryBlock();
+    pendingChanges.reset();
+    journalSize += static_cast<juce::int64> (changes.getSize() + sizeof (juce::int64));
+
+    return changes;
+}
+
+bool EditJournal::needsSnapshot (const juce::File& file, juce::int64 maxJournalSize) const
+{
+    return file != snapshotFile || journalSize > maxJournalSize;
+}
+
+void EditJournal::snapshotTaken (const juce::File& file)
+{
+    reset();
+    snapshotFile = file;
+}
+
+void EditJournal::reset()
+{
+    pendingChanges.reset();
+    changedSubtrees.clear();
+    snapshotFile = {};
+    journalSize = 0;
+}
+
+//==============================================================================
+juce::ValueTree EditJournal::getCoalescedSubtree (const juce::ValueTree& v) const
+{
+    juce::ValueTree subtree;
+
+    for (auto p = v; p.isValid() && p != state; p = p.getParent())
+        if (edit_journal::isCoalesced (p))
+            subtree = p;
+
+    return subtree;
+}
+
+bool EditJournal::addChangedSubtree (const juce::ValueTree& v)
+{
+    auto subtree = getCoalescedSubtree (v);
+
+    if (! subtree.isValid())
+        return false;
+
+    // There are usually only a handful of these between saves so a linear search is fine
+    if (std::find (changedSubtrees.begin(), changedSubtrees.end(), subtree) == changedSubtrees.end())
+        changedSubtrees.push_back (subtree);
+
+    return true;
+}
+
+void EditJournal::valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& id)
+{
+    using namespace edit_journal;
+
+    if (addChangedSubtree (v))
+        return;
+
+    if (auto path = getPath (state, v))
+    {
+        const bool removed = ! v.hasProperty (id);
+        pendingChanges.writeByte (static_cast<char> (removed ? Change::propertyRemoved : Change::propertyChanged));
+        writePath (pendingChanges, *path);
+        pendingChanges.writeString (id.toString());
+
+        if (! removed)
+            v[id].writeToStream (pendingChanges);
+    }
+}
+
+void EditJournal::valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child)
+{
+    using namespace edit_journal;
+
+    if (addChangedSubtree (parent))
+        return;
+
+    if (auto path = getPath (state, parent))
+    {
+        pendingChanges.writeByte (static_cast<char> (Change::childAdded));
+        writePath (pendingChanges, *path);
+        pendingChanges.writeCompressedInt (parent.indexOf (child));
+        child.writeToStream (pendingChanges);
+    }
+}
+
+void EditJournal::valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree&, int index)
+{
+    using namespace edit_journal;
+
+    if (addChangedSubtree (parent))
+        return;
+
+    if (auto path = getPath (state, parent))
+    {
+        pendingChanges.writeByte (static_cast<char> (Change::childRemoved));
+        writePath (pendingChanges, *path);
+        pendingChanges.writeCompressedInt (index);
+    }
+}
+
+void EditJournal::valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex)
+{
+    using namespace edit_journal;
+
+    if (addChangedSubtree (parent))
+        return;
+
+    if (auto path = getPath (state, parent))
+    {
+        // Sorting a tree doesn't say which children moved so the whole parent has to be written
+        if (oldIndex == newIndex)
+        {
+            pendingChanges.writeByte (static_cast<char> (Change::subtreeReplaced));
+            writePath (pendingChanges, *path);
+            parent.writeToStream (pendingChanges);
+            return;
+        }
+
+        pendingChanges.writeByte (static_cast<char> (Change::childMoved));
+        writePath (pendingChanges, *path);
+        pendingChanges.writeCompressedInt (oldIndex);
+        pendingChanges.writeCompressedInt (newIndex);
+    }
+}
+
+//==============================================================================
+bool EditJournal::applyChanges (juce::ValueTree& root, const juce::MemoryBlock& changes)
+{
+    using namespace edit_journal;
+    juce::MemoryInputStream is (changes, false);
+
+    while (! is.isExhausted())
+    {
+        const auto change = static_cast<Change> (is.readByte());
+        auto v = readPath (is, root);
+
+        if (! v.isValid())
+            return false;
+
+        switch (change)
+        {
+            case Change::propertyChanged:
+            {
+                const juce::Identifier id (is.readString());
+                v.setProperty (id, juce::var::readFromStream (is), nullptr);
+                break;
+            }
+
+            case Change::propertyRemoved:
+            {
+                v.removeProperty (juce::Identifier (is.readString()), nullptr);
+                break;
+            }
+
+            case Change::childAdded:
+            {
+                const auto index = is.readCompressedInt();
+                auto child = juce::ValueTree::readFromStream (is);
+
+                if (! child.isValid() || index < 0 || index > v.getNumChildren())
+                    return false;
+
+                v.addChild (child, index, nullptr);
+                break;
+            }
+
+            case Change::childRemoved:
+            {
+                const auto index = is.readCompressedInt();
+
+                if (! juce::isPositiveAndBelow (index, v.getNumChildren()))
+                    return false;
+
+                v.removeChild (index, nullptr);
+                break;
+            }
+
+            case Change::childMoved:
+            {
+                const auto oldIndex = is.readCompressedInt();
+                const auto newIndex = is.readCompressedInt();
+
+                if (! juce::isPositiveAndBelow (oldIndex, v.getNumChildren())
+                    || ! juce::isPositiveAndBelow (newIndex, v.getNumChildren()))
+                    return false;
+
+                v.moveChild (oldIndex, newIndex, nullptr);
+                break;
+            }
+
+            case Change::subtreeReplaced:
+            {
+                auto parent = v.getParent();
+                auto replacement = juce::ValueTree::readFromStream (is);
+
+                if (! replacement.isValid())
+                    return false;
+
+                if (! parent.isValid())
+                {
+                    v.copyPropertiesAndChildrenFrom (replacement, nullptr);
+                    break;
+                }
+
+                const auto index = parent.indexOf (v);
+                parent.removeChild (index, nullptr);
+                parent.addChild (replacement, index, nullptr);
+                break;
+            }
+
+            default:
+                jassertfalse;
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+bool EditJournal::startJournal (const juce::File& journalFile, const juce::File& snapshotFile)
+{
+    using namespace edit_journal;
+
+    if (! journalFile.deleteFile())
+        return false;
+
+    juce::FileOutputStream os (journalFile);
+
+    if (! os.openedOk())
+        return false;
+
+    os.write (magic, sizeof (magic));
+    os.writeInt (currentVersion);
+    os.writeInt64 (snapshotFile.getSize());
+    os.writeInt64 (snapshotFile.getLastModificationTime().toMilliseconds());
+    os.flush();
+
+    return os.getStatus().wasOk();
+}
+
+bool EditJournal::appendToJournal (const juce::File& journalFile, const juce::MemoryBlock& changes)
+{
+    if (! journalFile.existsAsFile())
+        return false;
+
+    juce::FileOutputStream os (journalFile);
+
+    if (! os.openedOk())
+        return false;
+
+    os.writeInt64 (static_cast<juce::int64> (changes.getSize()));
+    os.write (changes.getData(), changes.getSize());
+    os.flush();
+
+    return os.getStatus().wasOk();
+}
+
+bool EditJournal::replayJournal (const juce::File& journalFile, const juce::File& snapshotFile, juce::ValueTree& editState)
+{
+    CRASH_TRACER
+    juce::FileInputStream is (journalFile);
+    juce::int64 snapshotSize = 0, snapshotTime = 0;
+
+    if (! is.openedOk()
+        || ! edit_journal::readHeader (is, snapshotSize, snapshotTime)
+        || snapshotSize != snapshotFile.getSize()
+        || snapshotTime != snapshotFile.getLastModificationTime().toMilliseconds())
+        return false;
+
+    for (;;)
+    {
+        if (is.getNumBytesRemaining() < static_cast<juce::int64> (sizeof (juce::int64)))
+            break;
+
+        const auto size = is.readInt64();
+
+        // The last transaction may have been cut short by a crash
+        if (size < 0 || size > is.getNumBytesRemaining())
+            break;
+
+        juce::MemoryBlock changes;
+        is.readIntoMemoryBlock (changes, static_cast<juce::ssize_t> (size));
+
+        if (! applyChanges (editState, changes))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,105 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Records the changes made to an Edit's state so they can be appended to a
+    journal file rather than rewriting the whole Edit.
+
+    Changes are recorded by path (i.e. the child indexes from the root) so
+    replaying them in order on a snapshot of the state taken when the journal
+    was started recreates the current state.
+
+    MIDI sequences and automation curves tend to change in bursts of many small
+    edits, so changes inside them aren't recorded individually. Instead the
+    subtree is marked as changed and written out whole when the pending changes
+    are taken.
+
+    The journal file starts with a header identifying the snapshot it applies to,
+    followed by a number of transactions, each holding the changes from one call
+    to takePendingChanges(). A partially written transaction at the end of the
+    file is ignored when the journal is replayed.
+
+    EditFileOperations uses this for the temporary version of an Edit so that
+    autosaves only need to write what has changed since the last one.
+*/
+class EditJournal  : private juce::ValueTree::Listener
+{
+public:
+    /** Starts recording the changes made to the given Edit state. */
+    EditJournal (const juce::ValueTree& editState);
+
+    /** Destructor. */
+    ~EditJournal() override;
+
+    //==============================================================================
+    /** Returns true if there are changes that haven't been taken yet. */
+    bool hasPendingChanges() const noexcept;
+
+    /** Returns the changes since the last call, as a block to be appended to a journal
+        file, and clears them.
+    */
+    juce::MemoryBlock takePendingChanges();
+
+    /** Returns true if the state should be written out as a new snapshot.
+        This is the case if no snapshot has been taken for the given file or the
+        journal has grown larger than the given size.
+    */
+    bool needsSnapshot (const juce::File& snapshotFile, juce::int64 maxJournalSize) const;
+
+    /** Call this when a full copy of the state has been taken to write as a snapshot.
+        This discards any pending changes as they'll be included in the snapshot.
+    */
+    void snapshotTaken (const juce::File& snapshotFile);
+
+    /** Discards any pending changes so the next save will need a new snapshot. */
+    void reset();
+
+    //==============================================================================
+    /** Starts a new journal file for a snapshot file that has just been written. */
+    static bool startJournal (const juce::File& journalFile, const juce::File& snapshotFile);
+
+    /** Appends a block returned from takePendingChanges() to a journal file.
+        This does nothing if the journal hasn't been started.
+    */
+    static bool appendToJournal (const juce::File& journalFile, const juce::MemoryBlock& changes);
+
+    /** Applies the changes in a journal file to the state loaded from the snapshot file.
+        Returns false if the journal doesn't exist or doesn't belong to the snapshot.
+    */
+    static bool replayJournal (const juce::File& journalFile, const juce::File& snapshotFile, juce::ValueTree& state);
+
+    /** Applies the changes in a block returned from takePendingChanges() to a state. */
+    static bool applyChanges (juce::ValueTree& state, const juce::MemoryBlock& changes);
+
+private:
+    //==============================================================================
+    juce::ValueTree state;
+    juce::MemoryOutputStream pendingChanges;
+    std::vector<juce::ValueTree> changedSubtrees;
+    juce::File snapshotFile;
+    juce::int64 journalSize = 0;
+
+    juce::ValueTree getCoalescedSubtree (const juce::ValueTree&) const;
+    bool addChangedSubtree (const juce::ValueTree&);
+    bool writePath (const juce::ValueTree&);
+
+    void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
+    void valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) override;
+    void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override;
+    void valueTreeChildOrderChanged (juce::ValueTree&, int, int) override;
+
+    JUCE_DECLARE_NON_COPYABLE (EditJournal)
+};
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,163 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_EDIT_JOURNAL
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class EditJournalTests  : public juce::UnitTest
+{
+public:
+    EditJournalTests()
+        : juce::UnitTest ("EditJournal", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Replaying changes");
+        {
+            juce::Random r (42);
+            auto state = createState();
+            auto replayed = state.createCopy();
+            EditJournal journal (state);
+
+            for (int round = 0; round < 20; ++round)
+            {
+                for (int i = 0; i < 50; ++i)
+                    makeRandomChange (r, state);
+
+                expect (EditJournal::applyChanges (replayed, journal.takePendingChanges()));
+                expect (replayed.isEquivalentTo (state));
+            }
+
+            // Sorting doesn't say which children moved, this also replaces the root
+            struct Sorter
+            {
+                int compareElements (const juce::ValueTree& first, const juce::ValueTree& second) const
+                {
+                    return static_cast<int> (first[IDs::id]) - static_cast<int> (second[IDs::id]);
+                }
+            };
+
+            Sorter sorter;
+            state.sort (sorter, nullptr, false);
+
+            expect (EditJournal::applyChanges (replayed, journal.takePendingChanges()));
+            expect (replayed.isEquivalentTo (state));
+            expect (! journal.hasPendingChanges());
+        }
+
+        beginTest ("Journal files");
+        {
+            juce::Random r (42);
+            auto state = createState();
+            EditJournal journal (state);
+            juce::TemporaryFile snapshotFile, journalFile;
+
+            expect (journal.needsSnapshot (snapshotFile.getFile(), 1024 * 1024));
+            journal.snapshotTaken (snapshotFile.getFile());
+            expect (BinaryEditFile::write (snapshotFile.getFile(), state));
+            expect (EditJournal::startJournal (journalFile.getFile(), snapshotFile.getFile()));
+            expect (! journal.needsSnapshot (snapshotFile.getFile(), 1024 * 1024));
+
+            for (int i = 0; i < 5; ++i)
+            {
+                for (int j = 0; j < 20; ++j)
+                    makeRandomChange (r, state);
+
+                expect (EditJournal::appendToJournal (journalFile.getFile(), journal.takePendingChanges()));
+            }
+
+            // Simulate a crash part way through writing a transaction
+            {
+                auto expectedState = state.createCopy();
+                state.setProperty (IDs::name, "Unsaved", nullptr);
+
+                auto changes = journal.takePendingChanges();
+                juce::FileOutputStream os (journalFile.getFile());
+                os.writeInt64 (static_cast<juce::int64> (changes.getSize()));
+                os.write (changes.getData(), changes.getSize() / 2);
+                os.flush();
+
+                auto recovered = BinaryEditFile (snapshotFile.getFile()).readEdit();
+                expect (EditJournal::replayJournal (journalFile.getFile(), snapshotFile.getFile(), recovered));
+                expect (recovered.isEquivalentTo (expectedState));
+            }
+
+            // A journal for a different snapshot is ignored
+            expect (BinaryEditFile::write (snapshotFile.getFile(), state));
+            auto recovered = BinaryEditFile (snapshotFile.getFile()).readEdit();
+            expect (! EditJournal::replayJournal (journalFile.getFile(), snapshotFile.getFile(), recovered));
+        }
+    }
+
+private:
+    static juce::ValueTree createState()
+    {
+        juce::ValueTree edit (IDs::EDIT);
+
+        for (int t = 0; t < 4; ++t)
+        {
+            juce::ValueTree track (IDs::TRACK, { { IDs::id, t } });
+
+            for (int c = 0; c < 4; ++c)
+            {
+                juce::ValueTree clip (IDs::MIDICLIP, { { IDs::id, c } });
+                juce::ValueTree sequence (IDs::SEQUENCE);
+
+                for (int n = 0; n < 10; ++n)
+                    sequence.appendChild (juce::ValueTree (IDs::NOTE, { { IDs::p, n }, { IDs::b, n * 0.5 } }), nullptr);
+
+                clip.appendChild (sequence, nullptr);
+                track.appendChild (clip, nullptr);
+            }
+
+            edit.appendChild (track, nullptr);
+        }
+
+        return edit;
+    }
+
+    static void getAllTrees (const juce::ValueTree& v, juce::Array<juce::ValueTree>& trees)
+    {
+        trees.add (v);
+
+        for (auto child : v)
+            getAllTrees (child, trees);
+    }
+
+    static void makeRandomChange (juce::Random& r, juce::ValueTree root)
+    {
+        juce::Array<juce::ValueTree> trees;
+        getAllTrees (root, trees);
+
+        auto v = trees[r.nextInt (trees.size())];
+        const auto numChildren = v.getNumChildren();
+
+        switch (r.nextInt (5))
+        {
+            case 0:     v.setProperty (IDs::id, r.nextInt (100), nullptr); break;
+            case 1:     v.removeProperty (IDs::id, nullptr); break;
+            case 2:     v.addChild (juce::ValueTree (r.nextBool() ? IDs::NOTE : IDs::CLIP, { { IDs::id, r.nextInt (100) } }),
+                                    r.nextInt (numChildren + 1), nullptr); break;
+            case 3:     if (numChildren > 0) v.removeChild (r.nextInt (numChildren), nullptr); break;
+            default:    if (numChildren > 0) v.moveChild (r.nextInt (numChildren), r.nextInt (numChildren), nullptr); break;
+        }
+    }
+};
+
+static EditJournalTests editJournalTests;
+
+} // namespace tracktion::inline engine
+
+#endif
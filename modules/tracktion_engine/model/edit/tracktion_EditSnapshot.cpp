@@ -92,6 +92,15 @@ void EditSnapshot::setState (juce::ValueTree newState, TimeDuration editLength)
         state = newState.createCopy();
 
     length = editLength.inSeconds();
+    binaryFile.reset();
+}
+
+juce::ValueTree EditSnapshot::resolve (const juce::ValueTree& v) const
+{
+    if (auto file = binaryFile; file != nullptr && BinaryEditFile::isPlaceholder (v))
+        return file->resolve (v);
+
+    return v;
 }
 
 bool EditSnapshot::isValid() const
@@ -221,13 +230,26 @@ void EditSnapshot::refreshFromProjectItem (ProjectItem::Ptr pi)
         return;
 
     sourceFile = pi->getSourceFile();
-    auto newState = loadValueTree (sourceFile, true);
+    juce::ValueTree newState;
+    std::shared_ptr<BinaryEditFile> newBinaryFile;
+
+    // The snapshot doesn't look at MIDI, automation or plugin state so those chunks stay on disk until they're resolved
+    if (BinaryEditFile::isBinaryEditFile (sourceFile))
+    {
+        newBinaryFile = std::make_shared<BinaryEditFile> (sourceFile);
+        newState = newBinaryFile->getSkeleton();
+    }
+    else
+    {
+        newState = loadValueTree (sourceFile, true);
+    }
 
     if (! newState.hasType (IDs::EDIT))
         return;
 
     name = pi->getName();
     setState (newState, TimeDuration::fromSeconds (pi->getLength()));
+    binaryFile = std::move (newBinaryFile);
     refreshFromState();
 }
 
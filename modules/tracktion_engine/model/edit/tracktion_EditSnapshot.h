@@ -40,9 +40,18 @@ public:
     /** Returns the File if this was created from one. */
     juce::File getFile() const                          { return sourceFile; }
 
-    /** Returns the source Xml. */
+    /** Returns the source Xml.
+        If this was read from a binary Edit file, MIDI sequences, automation curves and
+        plugins with state are left on disk as placeholders. Use resolve() to read them.
+    */
     juce::ValueTree getState() noexcept                 { return state; }
 
+    /** If the tree is a placeholder in a state read from a binary Edit file, this
+        reads the subtree it refers to from the file. Any other tree is returned unchanged.
+        @see BinaryEditFile::resolve
+    */
+    juce::ValueTree resolve (const juce::ValueTree&) const;
+
     /** Sets the Edit XML that the XmlEdit should refer to.
         This will take ownership of the XmlElement so don't hang on to it.
         Once this is set you can retrieve the Xml for saving etc. using getXml().
@@ -117,6 +126,7 @@ private:
     ProjectItemID itemID;
     juce::File sourceFile;
     juce::ValueTree state;
+    std::shared_ptr<BinaryEditFile> binaryFile;
     juce::Time lastSaveTime;
 
     juce::String name;
@@ -39,6 +39,12 @@ bool referencesProjectItem (Edit& edit, ProjectItemID itemID)
     return false;
 }
 
+/** Items stay in the Edit's caches until they're deleted so this checks one hasn't been removed. */
+static bool isPartOfEdit (const Edit& edit, const juce::ValueTree& itemState)
+{
+    return itemState.isAChildOf (edit.state);
+}
+
 //==============================================================================
 //==============================================================================
 void insertSpaceIntoEdit (Edit& edit, TimeRange timeRange)
@@ -127,7 +133,11 @@ int getTotalNumTracks (const Edit& edit)
 
 Track* findTrackForID (const Edit& edit, EditItemID id)
 {
-    return findTrackForPredicate (edit, [id] (Track& t) { return t.itemID == id; });
+    if (auto t = edit.trackCache.findItem (id))
+        if (isPartOfEdit (edit, t->state))
+            return t;
+
+    return {};
 }
 
 AudioTrack* findAudioTrackForID (const Edit& edit, EditItemID id)
@@ -657,26 +667,11 @@ ClipOwner* findClipOwnerForID (const Edit& edit, EditItemID id)
 //==============================================================================
 ClipSlot* findClipSlotForID (const Edit& edit, EditItemID id)
 {
-    ClipSlot* result = nullptr;
+    if (auto cs = edit.clipSlotCache.findItem (id))
+        if (isPartOfEdit (edit, cs->state))
+            return cs;
 
-    edit.visitAllTracksRecursive ([&] (Track& t)
-                                  {
-                                      if (auto at = dynamic_cast<AudioTrack*> (&t))
-                                      {
-                                          for (auto cs : at->getClipSlotList().getClipSlots())
-                                          {
-                                              if (cs->itemID == id)
-                                              {
-                                                  result = cs;
-                                                  return false;
-                                              }
-                                          }
-                                      }
-
-                                      return true;
-                                  });
-
-    return result;
+    return {};
 }
 
 int findClipSlotIndex (ClipSlot& slot)
@@ -692,29 +687,11 @@ int findClipSlotIndex (ClipSlot& slot)
 //==============================================================================
 Clip* findClipForID (const Edit& edit, EditItemID clipID)
 {
-    Clip* result = nullptr;
-
-    edit.visitAllTracksRecursive ([&] (Track& t)
-                                  {
-                                      if (auto c = t.findClipForID (clipID))
-                                      {
-                                          result = c;
-                                          return false;
-                                      }
-
-                                      for (auto cc : getTrackItemsOfType<ContainerClip> (t))
-                                      {
-                                          if (auto c = findClipForID (*cc, clipID))
-                                          {
-                                              result = c;
-                                              return false;
-                                          }
-                                      }
-
-                                      return true;
-                                  });
+    if (auto c = edit.clipCache.findItem (clipID))
+        if (isPartOfEdit (edit, c->state))
+            return c;
 
-    return result;
+    return {};
 }
 
 Clip* findClipForState (const Edit& edit, const juce::ValueTree& v)
@@ -984,8 +961,8 @@ Plugin::Ptr findPluginForState (const Edit& edit, const juce::ValueTree& v)
 
 Plugin::Ptr findPluginForID (const Edit& edit, EditItemID id)
 {
-    for (auto p : getAllPlugins (edit, true))
-        if (p->itemID == id)
+    if (auto p = dynamic_cast<Plugin*> (edit.automatableEditItemCache.findItem (id)))
+        if (isPartOfEdit (edit, p->state))
             return p;
 
     return {};
@@ -1131,11 +1108,19 @@ juce::Array<AutomatableParameter::ModifierSource*> getAllModifierSources (const
     for (auto mpe : getAllMacroParameterElements (edit))
         sources.addArray (mpe->getMacroParameters());
 
-    edit.automationCurveModifierEditItemCache.visitItems ([&sources] (auto acm)
+    juce::Array<AutomationCurveModifier*> curveModifiers;
+    edit.automationCurveModifierEditItemCache.visitItems ([&curveModifiers] (auto acm)
                                                           {
-                                                             sources.add (acm);
+                                                             curveModifiers.add (acm);
                                                           });
 
+    // The cache isn't ordered so sort these to keep the list stable
+    std::sort (curveModifiers.begin(), curveModifiers.end(),
+               [] (auto a, auto b) { return a->itemID < b->itemID; });
+
+    for (auto acm : curveModifiers)
+        sources.add (acm);
+
     return sources;
 }
 
@@ -23,7 +23,7 @@ public:
     NoteDispatcher (MidiInputDevice& o) : owner (o)
     {
         startTimer (1);
-        items.reserve (20);
+        items.reserve (128 * 16); // One for each note so enqueue doesn't usually allocate
     }
 
     ~NoteDispatcher() override
@@ -329,6 +329,139 @@ struct RetrospectiveMidiBuffer
     RealTimeSpinLock lock;
 };
 
+//==============================================================================
+/**
+    Collects the MIDI recorded into a take.
+
+    Messages can be pushed from any thread without locking or allocating (apart
+    from sysex longer than a MidiMessage can hold inline) into a preallocated FIFO.
+    A shared background thread regularly moves them into the take's sequence so
+    the MIDI callback doesn't have to insert into a growing MidiMessageSequence.
+*/
+class MidiRecordingQueue
+{
+public:
+    /** The number of messages that can be waiting to be added to the sequence.
+        This is enough for about 150ms of 100,000 events per second.
+    */
+    static constexpr size_t maxNumPendingMessages = 16384;
+
+    MidiRecordingQueue (juce::MidiMessageSequence& dest)
+        : sequence (dest)
+    {
+        pending.reset (maxNumPendingMessages);
+        drainThread->addQueue (*this);
+    }
+
+    ~MidiRecordingQueue()
+    {
+        drainThread->removeQueue (*this);
+    }
+
+    /** Adds a message to the queue. This can be called from any thread.
+        Returns false if the queue is full and the message was dropped.
+    */
+    bool push (const juce::MidiMessage& m) noexcept
+    {
+        if (pending.push (m))
+            return true;
+
+        numDropped.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /** Stops the background thread draining the queue and adds any remaining
+        messages to the sequence. Call this once nothing else is pushing messages
+        and before using the sequence.
+    */
+    void flush()
+    {
+        drainThread->removeQueue (*this);
+        drain();
+    }
+
+    /** Returns the number of messages dropped because the queue was full. */
+    uint32_t getNumDropped() const noexcept     { return numDropped.load (std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    class DrainThread
+    {
+    public:
+        DrainThread()
+        {
+            thread = std::thread ([this] { run(); });
+        }
+
+        ~DrainThread()
+        {
+            waitingToExitFlag.test_and_set();
+            event.signal();
+            thread.join();
+        }
+
+        void addQueue (MidiRecordingQueue& queue)
+        {
+            {
+                const std::unique_lock sl (queuesMutex);
+                queues.push_back (&queue);
+            }
+
+            event.signal();
+        }
+
+        void removeQueue (MidiRecordingQueue& queue)
+        {
+            const std::unique_lock sl (queuesMutex);
+            std::erase (queues, &queue);
+        }
+
+    private:
+        std::vector<MidiRecordingQueue*> queues;
+        std::mutex queuesMutex;
+
+        std::thread thread;
+        juce::WaitableEvent event;
+        std::atomic_flag waitingToExitFlag = ATOMIC_FLAG_INIT;
+
+        void run()
+        {
+            juce::Thread::setCurrentThreadName ("MIDI recording");
+
+            while (! waitingToExitFlag.test (std::memory_order_acquire))
+            {
+                bool isIdle;
+
+                {
+                    const std::unique_lock sl (queuesMutex);
+                    isIdle = queues.empty();
+
+                    for (auto queue : queues)
+                        queue->drain();
+                }
+
+                event.wait (isIdle ? -1.0 : 2.0);
+            }
+        }
+    };
+
+    juce::MidiMessageSequence& sequence;
+    choc::fifo::SingleReaderMultipleWriterFIFO<juce::MidiMessage> pending;
+    std::atomic<uint32_t> numDropped { 0 };
+    juce::SharedResourcePointer<DrainThread> drainThread;
+
+    void drain()
+    {
+        juce::MidiMessage m;
+
+        // Messages mostly arrive in order so adding them is usually an append
+        while (pending.pop (m))
+            sequence.addEvent (m);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (MidiRecordingQueue)
+};
+
 //==============================================================================
 MidiInputDevice::MidiInputDevice (Engine& e, juce::String deviceType, juce::String deviceName, juce::String deviceIDToUse)
    : InputDevice (e, std::move (deviceType), std::move (deviceName), std::move (deviceIDToUse))
@@ -840,6 +973,7 @@ public:
         detail::ScopedActiveRecordingDevice scopedActiveRecordingDevice;
         const TimeRange punchRange;
         juce::MidiMessageSequence recorded;
+        MidiRecordingQueue recordingQueue { recorded };
         TimePosition unloopedStopTime;
 
         std::shared_ptr<choc::fifo::SingleReaderSingleWriterFIFO<juce::MidiMessage>> liveNotes;
@@ -1048,13 +1182,15 @@ public:
             auto m1 = juce::MidiMessage (message, context.globalStreamTimeToEditTime (message.getTimeStamp()).inSeconds());
             auto m2 = juce::MidiMessage (message, context.globalStreamTimeToEditTimeUnlooped (message.getTimeStamp()).inSeconds());
 
-            for (auto& recContext : recordingContexts)
-                recContext->liveNotes->push (m1);
-
             const std::shared_lock sl (contextLock);
 
             for (auto& recContext : recordingContexts)
-                recContext->recorded.addEvent (m2);
+            {
+                recContext->liveNotes->push (m1);
+
+                [[maybe_unused]] const bool added = recContext->recordingQueue.push (m2);
+                jassert (added); // The recording thread can't keep up!
+            }
         }
 
         juce::ScopedLock sl (consumerLock);
@@ -1108,6 +1244,8 @@ public:
             return {};
         }
 
+        recContext->recordingQueue.flush();
+
         if (recContext->recorded.getNumEvents() == 0)
             return {};
 
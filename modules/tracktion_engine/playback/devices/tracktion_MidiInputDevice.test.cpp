@@ -0,0 +1,95 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_MIDI_INPUT_DEVICE
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+
+namespace tracktion { inline namespace engine
+{
+
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("MidiRecordingQueue: 100,000 events per second")
+    {
+        // Several MPE channels send dense expression data at the same time
+        constexpr int numProducers = 4, numMilliseconds = 1000, numEventsPerMillisecond = 100 / numProducers;
+        juce::MidiMessageSequence recorded;
+
+        {
+            MidiRecordingQueue queue (recorded);
+            std::vector<std::thread> producers;
+
+            for (int p = 0; p < numProducers; ++p)
+            {
+                producers.emplace_back ([&queue, p]
+                {
+                    const auto channel = p + 2;
+                    auto nextTime = std::chrono::steady_clock::now();
+
+                    for (int ms = 0; ms < numMilliseconds; ++ms)
+                    {
+                        for (int i = 0; i < numEventsPerMillisecond; ++i)
+                        {
+                            const auto time = (ms + i / double (numEventsPerMillisecond)) * 0.001;
+                            const auto value = (ms * numEventsPerMillisecond + i) % 128;
+
+                            auto m = i % 3 == 0 ? juce::MidiMessage::channelPressureChange (channel, value)
+                                   : i % 3 == 1 ? juce::MidiMessage::pitchWheel (channel, value * 128)
+                                                : juce::MidiMessage::controllerEvent (channel, 74, value);
+                            m.setTimeStamp (time);
+                            queue.push (m);
+                        }
+
+                        nextTime += std::chrono::milliseconds (1);
+                        std::this_thread::sleep_until (nextTime);
+                    }
+                });
+            }
+
+            for (auto& t : producers)
+                t.join();
+
+            queue.flush();
+            CHECK_EQ (queue.getNumDropped(), 0u);
+        }
+
+        REQUIRE_EQ (recorded.getNumEvents(), numProducers * numMilliseconds * numEventsPerMillisecond);
+
+        std::array<int, 17> numEventsPerChannel {};
+        std::array<double, 17> lastTimePerChannel {};
+        bool isSorted = true, isInOrderPerChannel = true;
+
+        for (int i = 0; i < recorded.getNumEvents(); ++i)
+        {
+            auto& m = recorded.getEventPointer (i)->message;
+            const auto channel = static_cast<size_t> (m.getChannel());
+
+            if (i > 0 && m.getTimeStamp() < recorded.getEventTime (i - 1))
+                isSorted = false;
+
+            if (m.getTimeStamp() < lastTimePerChannel[channel])
+                isInOrderPerChannel = false;
+
+            lastTimePerChannel[channel] = m.getTimeStamp();
+            ++numEventsPerChannel[channel];
+        }
+
+        CHECK (isSorted);
+        CHECK (isInOrderPerChannel);
+
+        for (int p = 0; p < numProducers; ++p)
+            CHECK_EQ (numEventsPerChannel[static_cast<size_t> (p + 2)], numMilliseconds * numEventsPerMillisecond);
+    }
+}
+
+}} // namespace tracktion { inline namespace engine
+
+#endif
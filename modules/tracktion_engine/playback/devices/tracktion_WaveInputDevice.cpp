@@ -135,11 +135,19 @@ static juce::String expandPatterns (Edit& ed, juce::String s, Track* track, int
 
 
 //==============================================================================
-struct RetrospectiveRecordBuffer
+struct RetrospectiveRecordBuffer  : private juce::Timer
 {
     RetrospectiveRecordBuffer (Engine& e)
     {
         lengthInSeconds = e.getPropertyStorage().getProperty (SettingID::retrospectiveRecord, 30);
+
+        // The ring starts small and grows as the encoded audio needs more space
+        startTimer (100);
+    }
+
+    ~RetrospectiveRecordBuffer() override
+    {
+        stopTimer();
     }
 
     void updateSizeIfNeeded (int newNumChannels, double newSampleRate)
@@ -152,8 +160,11 @@ struct RetrospectiveRecordBuffer
             numSamples  = newNumSamples;
             sampleRate  = newSampleRate;
 
-            fifo.setSize (numChannels, std::max (1, numSamples));
-            fifo.reset();
+            ChunkedAudioRing::Options options;
+            options.numChannels = numChannels;
+            options.sampleRate = sampleRate;
+            options.lengthInSeconds = lengthInSeconds;
+            ring.prepare (options);
         }
     }
 
@@ -162,9 +173,7 @@ struct RetrospectiveRecordBuffer
         if (numSamplesIn < numSamples)
         {
             lastStreamTime = streamTime;
-
-            fifo.ensureFreeSpace (numSamplesIn);
-            fifo.write (inputBuffer);
+            ring.write (inputBuffer, 0, numSamplesIn);
         }
     }
 
@@ -203,7 +212,7 @@ struct RetrospectiveRecordBuffer
 
     double lengthInSeconds = 30.0;
 
-    AudioFifo fifo { 1, 1 };
+    ChunkedAudioRing ring;
     double lastStreamTime = 0;
 
     int numChannels = 0;
@@ -219,6 +228,11 @@ struct RetrospectiveRecordBuffer
     std::map<ProjectItemID, PerEditInfo> editInfo;
     juce::SpinLock editInfoLock;
 
+    void timerCallback() override
+    {
+        ring.allocateMoreIfNeeded();
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RetrospectiveRecordBuffer)
 };
 
@@ -1020,14 +1034,22 @@ public:
     juce::Array<Clip*> applyRetrospectiveRecord (bool armedOnly) override
     {
         juce::Array<Clip*> clips;
+        auto& wi = getWaveInput();
+
+        // Every target track gets the same audio and the buffer is cleared afterwards
+        // so it doesn't get applied twice
+        const juce::ScopeGuard clearBuffer { [&]
+        {
+            if (! clips.isEmpty())
+                if (auto recordBuffer = wi.getRetrospectiveRecordBuffer())
+                    recordBuffer->ring.reset();
+        }};
 
         for (auto dstTrack : getTargetTracks (*this))
         {
             if (armedOnly && ! isRecordingActive (dstTrack->itemID))
                 continue;
 
-            auto& wi = getWaveInput();
-
             auto recordBuffer = wi.getRetrospectiveRecordBuffer();
 
             if (recordBuffer == nullptr)
@@ -1049,19 +1071,8 @@ public:
                                         wi.bitDepth, metadata, 0);
 
                 if (writer.isOpen())
-                {
-                    int numReady;
-                    juce::AudioBuffer<float> scratchBuffer (recordBuffer->numChannels, 1000);
-
-                    while ((numReady = recordBuffer->fifo.getNumReady()) > 0)
-                    {
-                        auto toRead = std::min (numReady, scratchBuffer.getNumSamples());
-
-                        if (! recordBuffer->fifo.read (scratchBuffer, 0, toRead)
-                             || ! writer.appendBuffer (scratchBuffer, toRead))
-                            return nullptr;
-                    }
-                }
+                    if (! recordBuffer->ring.writeTo (writer, recordBuffer->ring.getAvailableRange()))
+                        return nullptr;
             }
 
             auto proj = getProjectForEdit (edit);
@@ -1703,20 +1714,29 @@ void WaveInputDevice::updateRetrospectiveBufferLength (double length)
 //==============================================================================
 struct WaveInputRecordingThread::BlockQueue
 {
+    /** The most blocks there can be. The FIFOs are this big so pushing never fails or allocates. */
+    static constexpr size_t maxNumBlocks = 1 << 15;
+
     BlockQueue()
     {
-        for (int i = 32; --i >= 0;)
-            addToFreeQueue (new QueuedBlock());
+        freeBlocks.reset (maxNumBlocks);
     }
 
     struct QueuedBlock
     {
-        QueuedBlock() = default;
+        QueuedBlock (int numChannels, int numSamples)
+            : maxNumChannels (numChannels), maxNumSamples (numSamples),
+              buffer (numChannels, numSamples)
+        {
+        }
 
         void load (AudioFileWriter& w, const juce::AudioBuffer<float>& newBuffer,
                    int start, int numSamples, const RecordingThumbnailManager::Thumbnail::Ptr& thumb)
         {
-            buffer.setSize (newBuffer.getNumChannels(), numSamples);
+            jassert (newBuffer.getNumChannels() <= maxNumChannels && numSamples <= maxNumSamples);
+
+            // This always fits in the space allocated up front so won't reallocate
+            buffer.setSize (newBuffer.getNumChannels(), numSamples, false, false, true);
 
             for (int i = buffer.getNumChannels(); --i >= 0;)
                 buffer.copyFrom (i, 0, newBuffer, i, start, numSamples);
@@ -1725,112 +1745,247 @@ struct WaveInputRecordingThread::BlockQueue
             thumbnail = thumb;
         }
 
-        std::atomic<AudioFileWriter*> writer { nullptr };
-        QueuedBlock* next = nullptr;
-        juce::AudioBuffer<float> buffer { 2, 512 };
+        const int maxNumChannels, maxNumSamples;
+        AudioFileWriter* writer = nullptr;
+        juce::AudioBuffer<float> buffer;
         RecordingThumbnailManager::Thumbnail::Ptr thumbnail;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (QueuedBlock)
     };
 
-    juce::CriticalSection freeQueueLock, pendingQueueLock;
-    QueuedBlock* firstPending = nullptr;
-    QueuedBlock* lastPending = nullptr;
-    QueuedBlock* firstFree = nullptr;
-    std::atomic<int> numPending { 0 };
+    // Blocks are taken from the free queue by the audio threads and returned by the writer threads
+    choc::fifo::MultipleReaderMultipleWriterFIFO<QueuedBlock*> freeBlocks;
+    std::vector<std::unique_ptr<QueuedBlock>> allBlocks;
+    std::atomic<size_t> numBlocks { 0 };
+
+    std::atomic<uint64_t> numBlocksDropped { 0 }, numSamplesDropped { 0 };
+
+    /** Allocates more blocks if there are fewer than the given number. Call this on the message thread. */
+    void ensureNumBlocks (size_t numBlocksNeeded, int numChannels, int numSamples)
+    {
+        numBlocksNeeded = std::min (numBlocksNeeded, maxNumBlocks);
+
+        while (allBlocks.size() < numBlocksNeeded)
+        {
+            allBlocks.push_back (std::make_unique<QueuedBlock> (numChannels, numSamples));
+            freeBlocks.push (allBlocks.back().get());
+        }
+
+        numBlocks = allBlocks.size();
+    }
 
-    QueuedBlock* findFreeBlock()
+    QueuedBlock* findFreeBlock (int numChannels) noexcept
     {
-        const juce::ScopedLock sl (freeQueueLock);
+        QueuedBlock* b = nullptr;
 
-        if (firstFree == nullptr)
-            return new QueuedBlock();
+        if (! freeBlocks.pop (b))
+            return {};
+
+        if (numChannels > b->maxNumChannels)
+        {
+            jassertfalse; // The blocks should be big enough for any input device
+            freeBlocks.push (b);
+            return {};
+        }
 
-        auto* b = firstFree;
-        firstFree = b->next;
-        b->next = nullptr;
         return b;
     }
 
     void addToFreeQueue (QueuedBlock* b) noexcept
     {
         jassert (b != nullptr);
-        const juce::ScopedLock sl (freeQueueLock);
         b->writer = nullptr;
-        b->next = firstFree;
-        firstFree = b;
+        b->thumbnail = nullptr;
+        freeBlocks.push (b);
     }
 
-    void addToPendingQueue (QueuedBlock* b) noexcept
+    void samplesDropped (int numSamples) noexcept
     {
-        jassert (b != nullptr);
-        b->next = nullptr;
-        const juce::ScopedLock sl (pendingQueueLock);
+        ++numBlocksDropped;
+        numSamplesDropped += static_cast<uint64_t> (numSamples);
+    }
+};
 
-        if (lastPending != nullptr)
-            lastPending->next = b;
-        else
-            firstPending = b;
+//==============================================================================
+/**
+    Writes the blocks for a subset of the writers. Each writer always goes to
+    the same thread so its blocks are written in order.
+*/
+struct WaveInputRecordingThread::WriterThread  : public juce::Thread
+{
+    WriterThread (WaveInputRecordingThread& o, int index)
+        : juce::Thread ("WaveInputRecordingThread " + juce::String (index + 1)),
+          owner (o)
+    {
+        pendingBlocks.reset (BlockQueue::maxNumBlocks);
+    }
 
-        lastPending = b;
-        ++numPending;
+    ~WriterThread() override
+    {
+        stop();
     }
 
-    QueuedBlock* removeFirstPending() noexcept
+    void addBlock (BlockQueue::QueuedBlock* b) noexcept
     {
-        const juce::ScopedLock sl (pendingQueueLock);
+        // This is incremented before pushing so waitForBlocksQueuedSoFar can't miss a block
+        ++numBlocksQueued;
+        [[maybe_unused]] const bool pushed = pendingBlocks.push (b);
+        jassert (pushed);
+        notify();
+    }
 
-        if (auto b = firstPending)
-        {
-            firstPending = b->next;
+    /** Waits until all the blocks queued before this was called have been written. */
+    void waitForBlocksQueuedSoFar()
+    {
+        const auto numQueued = numBlocksQueued.load();
+        std::unique_lock lock (finishedMutex);
 
-            if (firstPending == nullptr)
-                lastPending = nullptr;
+        while (numBlocksFinished.load() < numQueued && isThreadRunning())
+            blocksFinished.wait_for (lock, std::chrono::milliseconds (100));
+    }
+
+    void stop()
+    {
+        stopThread (30000);
 
-            --numPending;
-            return b;
+        // Anything left can't be written now so is returned to the free queue
+        for (BlockQueue::QueuedBlock* b = nullptr; pendingBlocks.pop (b);)
+        {
+            owner.queue->addToFreeQueue (b);
+            ++numBlocksFinished;
         }
 
-        return {};
+        signalBlocksFinished();
     }
 
-    void moveAnyPendingBlocksToFree() noexcept
+    void run() override
     {
-        while (auto b = removeFirstPending())
-            addToFreeQueue (b);
+        CRASH_TRACER
+        juce::FloatVectorOperations::disableDenormalisedNumberSupport();
 
-        jassert (numPending == 0);
-        numPending = 0;
+        for (;;)
+        {
+            if (! owner.hasWarned && (owner.queue->numBlocksDropped > 0
+                                       || pendingBlocks.getUsedSlots() > owner.queue->numBlocks.load() * 3 / 4))
+            {
+                owner.hasWarned = true;
+                TRACKTION_LOG_ERROR ("Audio recording can't keep up!");
+            }
+
+            batch.clear();
+
+            for (BlockQueue::QueuedBlock* b = nullptr; pendingBlocks.pop (b);)
+                batch.push_back (b);
+
+            if (batch.empty())
+            {
+                if (threadShouldExit())
+                    break;
+
+                wait (401);
+                continue;
+            }
+
+            writeBatch();
+
+            for (auto b : batch)
+                owner.queue->addToFreeQueue (b);
+
+            numBlocksFinished += batch.size();
+            signalBlocksFinished();
+        }
     }
 
-    bool isWriterInQueue (AudioFileWriter& writer) const
-    {
-        const juce::ScopedLock sl (pendingQueueLock);
+private:
+    WaveInputRecordingThread& owner;
+    choc::fifo::SingleReaderMultipleWriterFIFO<BlockQueue::QueuedBlock*> pendingBlocks;
+    std::atomic<uint64_t> numBlocksQueued { 0 }, numBlocksFinished { 0 };
+    std::mutex finishedMutex;
+    std::condition_variable blocksFinished;
 
-        for (auto b = firstPending; b != nullptr; b = b->next)
-            if (b->writer == &writer)
-                return true;
+    std::vector<BlockQueue::QueuedBlock*> batch;
+    juce::AudioBuffer<float> coalescedBuffer;
 
-        return false;
+    /** The most samples that will be combined into a single write. */
+    static constexpr int maxNumCoalescedSamples = 65536;
+
+    void signalBlocksFinished()
+    {
+        {
+            const std::scoped_lock lock (finishedMutex);
+        }
+
+        blocksFinished.notify_all();
     }
 
-    void deleteFreeQueue() noexcept
+    /** Writes the batch, combining each writer's consecutive blocks into a single larger write. */
+    void writeBatch()
     {
-        auto b = firstFree;
-        firstFree = nullptr;
+        // A stable sort keeps each writer's blocks in the order they were recorded
+        std::stable_sort (batch.begin(), batch.end(),
+                          [] (auto a, auto b) { return std::less<AudioFileWriter*>() (a->writer, b->writer); });
 
-        while (b != nullptr)
+        for (auto start = batch.begin(); start != batch.end();)
         {
-            std::unique_ptr<QueuedBlock> toDelete (b);
-            b = b->next;
+            auto& first = (*start)->buffer;
+            const auto numChannels = first.getNumChannels();
+            int numSamples = 0;
+            auto end = start;
+
+            for (; end != batch.end(); ++end)
+            {
+                auto& buffer = (*end)->buffer;
+
+                if ((*end)->writer != (*start)->writer
+                    || buffer.getNumChannels() != numChannels
+                    || (end != start && numSamples + buffer.getNumSamples() > maxNumCoalescedSamples))
+                    break;
+
+                numSamples += buffer.getNumSamples();
+            }
+
+            bool ok = true;
+
+            if (std::distance (start, end) == 1)
+            {
+                ok = (*start)->writer->appendBuffer (first, first.getNumSamples());
+            }
+            else
+            {
+                coalescedBuffer.setSize (numChannels, numSamples, false, false, true);
+                int pos = 0;
+
+                for (auto b = start; b != end; ++b)
+                {
+                    auto& buffer = (*b)->buffer;
+
+                    for (int chan = 0; chan < numChannels; ++chan)
+                        coalescedBuffer.copyFrom (chan, pos, buffer, chan, 0, buffer.getNumSamples());
+
+                    pos += buffer.getNumSamples();
+                }
+
+                ok = (*start)->writer->appendBuffer (coalescedBuffer, numSamples);
+            }
+
+            if (! ok && ! owner.hasSentStop.exchange (true))
+            {
+                TRACKTION_LOG_ERROR ("Audio recording failed to write to disk!");
+                owner.startTimer (1);
+            }
+
+            for (auto b = start; b != end; ++b)
+                if ((*b)->thumbnail != nullptr)
+                    (*b)->thumbnail->addBlock ((*b)->buffer, 0, (*b)->buffer.getNumSamples());
+
+            start = end;
         }
     }
 };
 
 //==============================================================================
 WaveInputRecordingThread::WaveInputRecordingThread (Engine& e)
-    : Thread ("WaveInputRecordingThread"),
-      engine (e),
+    : engine (e),
       queue (new BlockQueue())
 {
 }
@@ -1838,7 +1993,7 @@ WaveInputRecordingThread::WaveInputRecordingThread (Engine& e)
 WaveInputRecordingThread::~WaveInputRecordingThread()
 {
     flushAndStop();
-    queue->deleteFreeQueue();
+    writerThreads.clear();
     queue.reset();
 }
 
@@ -1846,6 +2001,8 @@ void WaveInputRecordingThread::addUser()
 {
     if (activeUsers++ == 0)
         prepareToStart();
+
+    allocateBlocks();
 }
 
 void WaveInputRecordingThread::removeUser()
@@ -1854,88 +2011,124 @@ void WaveInputRecordingThread::removeUser()
         flushAndStop();
 }
 
-//==============================================================================
-void WaveInputRecordingThread::addBlockToRecord (AudioFileWriter& writer, const juce::AudioBuffer<float>& buffer,
-                                                 int start, int numSamples, const RecordingThumbnailManager::Thumbnail::Ptr& thumbnail)
+int WaveInputRecordingThread::getNumWriterThreads() const noexcept
 {
-    if (! threadShouldExit())
-    {
-        auto block = queue->findFreeBlock();
-        block->load (writer, buffer, start, numSamples, thumbnail);
-        queue->addToPendingQueue (block);
-        notify();
-    }
+    return static_cast<int> (writerThreads.size());
 }
 
-void WaveInputRecordingThread::waitForWriterToFinish (AudioFileWriter& writer)
+uint64_t WaveInputRecordingThread::getNumBlocksDropped() const noexcept
 {
-    while (queue->isWriterInQueue (writer) && isThreadRunning())
-        Thread::sleep (2);
+    return queue->numBlocksDropped;
 }
 
-void WaveInputRecordingThread::run()
+uint64_t WaveInputRecordingThread::getNumSamplesDropped() const noexcept
 {
-    CRASH_TRACER
-    juce::FloatVectorOperations::disableDenormalisedNumberSupport();
+    return queue->numSamplesDropped;
+}
 
-    for (;;)
-    {
-        if (queue->numPending > 500 && ! hasWarned)
-        {
-            hasWarned = true;
-            TRACKTION_LOG_ERROR ("Audio recording can't keep up!");
-        }
+//==============================================================================
+WaveInputRecordingThread::WriterThread* WaveInputRecordingThread::getThreadForWriter (const AudioFileWriter& writer) const noexcept
+{
+    if (writerThreads.empty())
+        return {};
 
-        if (auto block = queue->removeFirstPending())
-        {
-            if (! block->writer.load()->appendBuffer (block->buffer, block->buffer.getNumSamples()))
-            {
-                if (! hasSentStop)
-                {
-                    hasSentStop = true;
-                    TRACKTION_LOG_ERROR ("Audio recording failed to write to disk!");
-                    startTimer (1);
-                }
-            }
+    // Mix the address bits as allocations are aligned
+    auto hash = static_cast<uint64_t> (reinterpret_cast<uintptr_t> (&writer));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
 
-            if (block->thumbnail != nullptr)
-            {
-                block->thumbnail->addBlock (block->buffer, 0, block->buffer.getNumSamples());
-                block->thumbnail = nullptr;
-            }
+    return writerThreads[static_cast<size_t> (hash % writerThreads.size())].get();
+}
 
-            queue->addToFreeQueue (block);
-        }
-        else
-        {
-            if (threadShouldExit())
-                break;
+void WaveInputRecordingThread::addBlockToRecord (AudioFileWriter& writer, const juce::AudioBuffer<float>& buffer,
+                                                 int start, int numSamples, const RecordingThumbnailManager::Thumbnail::Ptr& thumbnail)
+{
+    auto thread = getThreadForWriter (writer);
 
-            wait (401);
+    if (thread == nullptr || thread->threadShouldExit())
+        return;
+
+    while (numSamples > 0)
+    {
+        auto block = queue->findFreeBlock (buffer.getNumChannels());
+
+        if (block == nullptr)
+        {
+            queue->samplesDropped (numSamples);
+            return;
         }
+
+        const auto numThisTime = std::min (numSamples, block->maxNumSamples);
+        block->load (writer, buffer, start, numThisTime, thumbnail);
+        thread->addBlock (block);
+
+        start += numThisTime;
+        numSamples -= numThisTime;
     }
 }
 
+void WaveInputRecordingThread::waitForWriterToFinish (AudioFileWriter& writer)
+{
+    if (auto thread = getThreadForWriter (writer))
+        thread->waitForBlocksQueuedSoFar();
+}
+
 void WaveInputRecordingThread::timerCallback()
 {
     stopTimer();
     TransportControl::stopAllTransports (engine, false, false);
 }
 
+void WaveInputRecordingThread::allocateBlocks()
+{
+    CRASH_TRACER
+    auto& dm = engine.getDeviceManager();
+    const auto blockSize = std::max (dm.getBlockSize(), 32);
+    const auto sampleRate = dm.getSampleRate() > 0.0 ? dm.getSampleRate() : 44100.0;
+    int numChannels = 2;
+
+    for (int i = 0; i < dm.getNumWaveInDevices(); ++i)
+        if (auto wi = dm.getWaveInDevice (i))
+            numChannels = std::max (numChannels, wi->getChannelSet().size());
+
+    // Enough blocks for each input to get a second or so behind before any audio is dropped
+    const auto numBlocksPerUser = std::max (32, juce::roundToInt (sampleRate / blockSize));
+    queue->ensureNumBlocks (static_cast<size_t> (activeUsers * numBlocksPerUser), numChannels, blockSize);
+}
+
 void WaveInputRecordingThread::prepareToStart()
 {
     flushAndStop();
-    sleep (2);
-    jassert (! isThreadRunning());
-    startThread (juce::Thread::Priority::normal);
+
+    const auto numThreads = std::max (1, engine.getEngineBehaviour().getNumberOfRecordingWriterThreads());
+
+    if (getNumWriterThreads() != numThreads)
+    {
+        writerThreads.clear();
+
+        for (int i = 0; i < numThreads; ++i)
+            writerThreads.push_back (std::make_unique<WriterThread> (*this, i));
+    }
+
+    queue->numBlocksDropped = 0;
+    queue->numSamplesDropped = 0;
+
+    for (auto& t : writerThreads)
+        t->startThread (juce::Thread::Priority::normal);
 }
 
 void WaveInputRecordingThread::flushAndStop()
 {
-    signalThreadShouldExit();
-    notify();
-    stopThread (30000);
-    queue->moveAnyPendingBlocksToFree();
+    for (auto& t : writerThreads)
+    {
+        t->signalThreadShouldExit();
+        t->notify();
+    }
+
+    for (auto& t : writerThreads)
+        t->stop();
+
     hasSentStop = false;
     hasWarned = false;
 }
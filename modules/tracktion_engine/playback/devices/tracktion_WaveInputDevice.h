@@ -107,8 +107,14 @@ private:
 
 
 //==============================================================================
-class WaveInputRecordingThread  : public juce::Thread,
-                                  private juce::Timer
+/**
+    Writes the blocks recorded from wave inputs to their files.
+
+    The writers are shared between a number of threads, set by
+    EngineBehaviour::getNumberOfRecordingWriterThreads(), so that many inputs
+    can be recorded at once without a single thread becoming the bottleneck.
+*/
+class WaveInputRecordingThread  : private juce::Timer
 {
 public:
     //==============================================================================
@@ -128,21 +134,43 @@ public:
     void removeUser();
 
     //==============================================================================
+    /** Queues a block to be written to the writer on the recording thread.
+        This is realtime safe as it uses blocks allocated when users are added. If
+        the recording thread falls too far behind and there are no free blocks, the
+        samples are dropped and counted instead.
+    */
     void addBlockToRecord (AudioFileWriter&, const juce::AudioBuffer<float>&,
                            int start, int numSamples, const RecordingThumbnailManager::Thumbnail::Ptr&);
+
+    /** Blocks until all the blocks queued for a writer have been written.
+        No more blocks should be added for the writer once this has been called.
+    */
     void waitForWriterToFinish (AudioFileWriter&);
-    void run() override;
-    void timerCallback() override;
+
+    /** Returns the number of blocks that have had samples dropped since recording started. */
+    uint64_t getNumBlocksDropped() const noexcept;
+
+    /** Returns the number of samples that have been dropped since recording started. */
+    uint64_t getNumSamplesDropped() const noexcept;
+
+    /** Returns the number of threads writing blocks to disk. */
+    int getNumWriterThreads() const noexcept;
 
     Engine& engine;
 
 private:
     int activeUsers = 0;
-    bool hasWarned = false, hasSentStop = false;
+    std::atomic<bool> hasWarned { false }, hasSentStop { false };
 
     struct BlockQueue;
     std::unique_ptr<BlockQueue> queue;
 
+    struct WriterThread;
+    std::vector<std::unique_ptr<WriterThread>> writerThreads;
+
+    WriterThread* getThreadForWriter (const AudioFileWriter&) const noexcept;
+    void timerCallback() override;
+    void allocateBlocks();
     void prepareToStart();
     void flushAndStop();
 
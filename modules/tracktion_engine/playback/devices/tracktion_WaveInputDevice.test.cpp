@@ -406,6 +406,91 @@ namespace tracktion::inline engine
                                                            toBufferView (squareBuffer).getStart (recordedFileView.getNumFrames()- blockNumFrames),
                                                            juce::Decibels::decibelsToGain (-99.0f)));
         }
+
+        TEST_CASE ("WaveInputRecordingThread: 64 inputs")
+        {
+            constexpr int numInputs = 64, numProducers = 4, numBlocks = 200, blockSize = 512;
+            constexpr double sampleRate = 44100.0;
+            auto& engine = *Engine::getEngines()[0];
+            auto& recordingThread = engine.getWaveInputRecordingThread();
+
+            // Each block is filled with a value unique to its input and position so the files can be checked
+            auto getBlockValue = [] (int input, int block) { return ((input * numBlocks + block) % 1000) / 1000.0f - 0.5f; };
+
+            test_utilities::TempCurrentWorkingDirectory tempDir;
+            juce::WavAudioFormat format;
+            std::vector<std::unique_ptr<juce::TemporaryFile>> files;
+            std::vector<std::unique_ptr<AudioFileWriter>> writers;
+            std::vector<std::unique_ptr<WaveInputRecordingThread::ScopedInitialiser>> users;
+
+            for (int i = 0; i < numInputs; ++i)
+            {
+                files.push_back (std::make_unique<juce::TemporaryFile> (".wav"));
+                writers.push_back (std::make_unique<AudioFileWriter> (AudioFile (engine, files.back()->getFile()), &format,
+                                                                      1, sampleRate, 24, juce::StringPairArray(), 0));
+                REQUIRE (writers.back()->isOpen());
+                users.push_back (std::make_unique<WaveInputRecordingThread::ScopedInitialiser> (recordingThread));
+            }
+
+            CHECK_EQ (recordingThread.getNumWriterThreads(), engine.getEngineBehaviour().getNumberOfRecordingWriterThreads());
+
+            // Several threads add blocks at the same time, a little faster than real time
+            std::vector<std::thread> producers;
+
+            for (int p = 0; p < numProducers; ++p)
+            {
+                producers.emplace_back ([&, p]
+                                        {
+                                            juce::AudioBuffer<float> buffer (1, blockSize);
+
+                                            for (int block = 0; block < numBlocks; ++block)
+                                            {
+                                                for (int input = p; input < numInputs; input += numProducers)
+                                                {
+                                                    juce::FloatVectorOperations::fill (buffer.getWritePointer (0), getBlockValue (input, block), blockSize);
+                                                    recordingThread.addBlockToRecord (*writers[(size_t) input], buffer, 0, blockSize, {});
+                                                }
+
+                                                std::this_thread::sleep_for (std::chrono::milliseconds (2));
+                                            }
+                                        });
+            }
+
+            for (auto& t : producers)
+                t.join();
+
+            for (auto& w : writers)
+            {
+                recordingThread.waitForWriterToFinish (*w);
+                w->closeForWriting();
+            }
+
+            const auto numSamplesDropped = recordingThread.getNumSamplesDropped();
+            WARN_EQ (numSamplesDropped, uint64_t (0));
+
+            juce::int64 numSamplesWritten = 0;
+
+            for (int input = 0; input < numInputs; ++input)
+            {
+                auto recorded = *engine::test_utilities::loadFileInToBuffer (engine, files[(size_t) input]->getFile());
+                numSamplesWritten += recorded.getNumSamples();
+
+                if (recorded.getNumSamples() != numBlocks * blockSize)
+                    continue;
+
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    auto range = juce::FloatVectorOperations::findMinAndMax (recorded.getReadPointer (0, block * blockSize), blockSize);
+                    CHECK (std::abs (range.getStart() - getBlockValue (input, block)) < 1.0e-5f);
+                    CHECK (std::abs (range.getEnd() - getBlockValue (input, block)) < 1.0e-5f);
+                }
+            }
+
+            // Every sample is either written or counted as dropped
+            CHECK_EQ (numSamplesWritten + static_cast<juce::int64> (numSamplesDropped), juce::int64 (numInputs) * numBlocks * blockSize);
+
+            users.clear();
+        }
     }
 #endif
 
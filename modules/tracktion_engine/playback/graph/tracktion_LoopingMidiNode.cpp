@@ -364,9 +364,19 @@ namespace MidiHelpers
         return dest;
     }
 
+    /** Pairs each note-on index with the index of the next note-off with the same channel and note number.
+        The map is ordered by note-on index.
+    */
     inline void createNoteOffMap (std::vector<std::pair<size_t, size_t>>& noteOffMap,
                                   const choc::midi::Sequence& seq)
     {
+        // Whilst scanning, note-ons waiting for a note-off are chained together per
+        // channel/note through the second member of their entry. This keeps it to a
+        // single pass that doesn't allocate beyond the map's capacity
+        constexpr auto unmatched = std::numeric_limits<size_t>::max();
+        std::array<size_t, 16 * 128> lastUnmatched;
+        lastUnmatched.fill (unmatched);
+
         noteOffMap.clear();
         const auto seqLen = seq.events.size();
 
@@ -377,39 +387,52 @@ namespace MidiHelpers
             if (! m.isShortMessage())
                 continue;
 
-            if (m.isNoteOn())
-            {
-                const auto note = m.getNoteNumber();
-                const auto chan = m.getChannel0to15();
+            const bool isNoteOn = m.isNoteOn();
 
-                for (size_t j = i + 1; j < seqLen; ++j)
-                {
-                    const auto& m2 = seq.events[j].message;
+            if (! isNoteOn && ! m.isNoteOff())
+                continue;
 
-                    if (! m2.isShortMessage())
-                        continue;
+            auto& chainStart = lastUnmatched[(size_t) m.getChannel0to15() * 128 + m.getNoteNumber()];
 
-                    if (m2.getNoteNumber() == note
-                         && m2.getChannel0to15() == chan
-                         && m2.isNoteOff())
-                    {
-                        noteOffMap.emplace_back (std::make_pair (i, j));
-                        break;
-                    }
-                }
+            if (isNoteOn)
+            {
+                noteOffMap.emplace_back (i, chainStart);
+                chainStart = noteOffMap.size() - 1;
+                continue;
             }
+
+            for (auto entry = chainStart; entry != unmatched;)
+                entry = std::exchange (noteOffMap[entry].second, i);
+
+            chainStart = unmatched;
         }
+
+        // Any note-ons left have no note-off so are removed
+        for (auto entry : lastUnmatched)
+            while (entry != unmatched)
+                entry = std::exchange (noteOffMap[entry].second, unmatched);
+
+        std::erase_if (noteOffMap, [] (const auto& m) { return m.second == unmatched; });
+    }
+
+    inline std::optional<size_t> getNoteOffIndex (size_t noteOnIndex,
+                                                  const std::vector<std::pair<size_t, size_t>>& noteOffMap)
+    {
+        auto found = std::lower_bound (noteOffMap.begin(), noteOffMap.end(), noteOnIndex,
+                                       [] (const auto& m, size_t index) { return m.first < index; });
+
+        if (found != noteOffMap.end() && found->first == noteOnIndex)
+            return found->second;
+
+        return {};
     }
 
     inline choc::midi::Sequence::Event* getNoteOff (size_t noteOnIndex,
                                                     choc::midi::Sequence& ms,
                                                     const std::vector<std::pair<size_t, size_t>>& noteOffMap)
     {
-        auto found = std::find_if (noteOffMap.begin(), noteOffMap.end(),
-                                   [noteOnIndex] (const auto& m) { return m.first == noteOnIndex; });
-
-        if (found != noteOffMap.end())
-            return &ms.events[found->second];
+        if (auto index = getNoteOffIndex (noteOnIndex, noteOffMap))
+            return &ms.events[*index];
 
         return {};
     }
@@ -418,28 +441,21 @@ namespace MidiHelpers
                                                           const choc::midi::Sequence& ms,
                                                           const std::vector<std::pair<size_t, size_t>>& noteOffMap)
     {
-        auto found = std::find_if (noteOffMap.begin(), noteOffMap.end(),
-                                   [noteOnIndex] (const auto& m) { return m.first == noteOnIndex; });
-
-        if (found != noteOffMap.end())
-            return &ms.events[found->second];
+        if (auto index = getNoteOffIndex (noteOnIndex, noteOffMap))
+            return &ms.events[*index];
 
         return {};
     }
 
-    inline std::optional<size_t> getNoteOffIndex (size_t noteOnIndex,
-                                                  const std::vector<std::pair<size_t, size_t>>& noteOffMap)
+    /** Returns the index of the first event at or after the given time. */
+    inline size_t getIndexOfFirstEventAtOrAfter (const choc::midi::Sequence& seq, double time)
     {
-        auto found = std::find_if (noteOffMap.begin(), noteOffMap.end(),
-                                   [noteOnIndex] (const auto& m) { return m.first == noteOnIndex; });
+        auto found = std::lower_bound (seq.events.begin(), seq.events.end(), time,
+                                       [] (const auto& e, double t) { return e.timeStamp < t; });
 
-        if (found != noteOffMap.end())
-            return found->second;
-
-        return {};
+        return static_cast<size_t> (std::distance (seq.events.begin(), found));
     }
 
-
     inline void applyQuantisationToSequence (const QuantisationType& q, bool canQuantiseNoteOffs,
                                              choc::midi::Sequence& ms, const std::vector<std::pair<size_t, size_t>>& noteOffMap)
     {
@@ -512,11 +528,9 @@ namespace MidiHelpers
         {
             const auto indexOfTime = [&]() -> size_t
                                      {
-                                         const auto numEvents = sourceSequence.events.size();
-
-                                         for (size_t i = 0; i < numEvents; ++i)
-                                             if (sourceSequence.events[i].timeStamp >= time)
-                                                 return i;
+                                         if (auto index = getIndexOfFirstEventAtOrAfter (sourceSequence, time);
+                                             index < sourceSequence.events.size())
+                                             return index;
 
                                          return {};
                                      }();
@@ -761,24 +775,8 @@ struct EventGenerator   : public MidiGenerator
 
     void setTime (SequenceBeatPosition pos) override
     {
-        auto numEvents = sequence.events.size();
-
         // Set the index to the start of the range
-        if (numEvents != 0)
-        {
-            currentIndex = std::clamp<size_t> (currentIndex, 0, numEvents - 1);
-
-            if (sequence.events[currentIndex].timeStamp >= pos)
-            {
-                while (currentIndex > 0 && sequence.events[currentIndex - 1].timeStamp >= pos)
-                    --currentIndex;
-            }
-            else
-            {
-                while (currentIndex < numEvents && sequence.events[currentIndex].timeStamp < pos)
-                    ++currentIndex;
-            }
-        }
+        currentIndex = MidiHelpers::getIndexOfFirstEventAtOrAfter (sequence, pos);
     }
 
     juce::MidiMessage getEvent() override
@@ -808,41 +806,78 @@ struct EventGenerator   : public MidiGenerator
 
 //==============================================================================
 //==============================================================================
-class CachingMidiEventGenerator : public MidiGenerator
+/**
+    The sorted events of each of a clip's sequences, cut to the loop range, along
+    with their note-off maps.
+
+    These only depend on the source sequences and loop range so are built once
+    and then shared with the nodes of subsequent graph rebuilds if those haven't
+    changed. That way only the per-loop offset, quantisation and groove need to
+    be applied whilst playing.
+*/
+struct PreparedMidiSequences
 {
-public:
-    CachingMidiEventGenerator (std::vector<juce::MidiMessageSequence> seq,
-                               QuantisationType qt,
-                               const GrooveTemplate& grooveTemplate, float grooveStrength_)
-        : sequences (std::move (seq)),
-          quantisation (std::move (qt)),
-          groove (grooveTemplate),
-          grooveStrength (grooveStrength_)
+    PreparedMidiSequences (std::vector<juce::MidiMessageSequence> sourceSequences,
+                           juce::Range<double> loopRange, size_t hashToUse)
+        : hash (hashToUse)
     {
-        // Cache the sequence at 0.0 time to reserve the required storage
-        cacheSequence (0.0, {});
+        if (! loopRange.isEmpty())
+            sourceSequences = MidiHelpers::createLoopSection (sourceSequences, loopRange);
 
-        // Reserve the scratch space for the note on/off map
-        size_t maxNumEvents = 0, maxNumNoteOns = 0;
+        sequences.resize (sourceSequences.size());
 
-        for (auto& sequence : sequences)
+        for (size_t i = 0; i < sourceSequences.size(); ++i)
         {
-            size_t squenceNumEvents = 0, squenceNumNoteOns = 0;
+            auto& dest = sequences[i];
+            dest.sequence.events.reserve ((size_t) sourceSequences[i].getNumEvents());
+            MidiHelpers::addSequence (dest.sequence, sourceSequences[i], 0.0);
+            MidiHelpers::createNoteOffMap (dest.noteOffMap, dest.sequence);
 
-            for (auto meh : sequence)
+            if (! loopRange.isEmpty())
             {
-                ++squenceNumEvents;
-
-                if (meh->message.isNoteOn())
-                    ++squenceNumNoteOns;
+                // Remove any notes that would end up with no length
+                MidiHelpers::clipSequenceToRange (dest.sequence, loopRange, dest.noteOffMap);
+                MidiHelpers::createNoteOffMap (dest.noteOffMap, dest.sequence);
             }
 
-            maxNumEvents = std::max (squenceNumEvents, maxNumEvents);
-            maxNumNoteOns = std::max (squenceNumNoteOns, maxNumNoteOns);
+            maxNumEvents = std::max (maxNumEvents, dest.sequence.events.size());
+            maxNumNoteOns = std::max (maxNumNoteOns, (size_t) std::count_if (dest.sequence.begin(), dest.sequence.end(),
+                                                                              [] (auto& e) { return e.message.isNoteOn(); }));
         }
+    }
+
+    struct Sequence
+    {
+        choc::midi::Sequence sequence;
+        std::vector<std::pair<size_t, size_t>> noteOffMap;
+    };
+
+    std::vector<Sequence> sequences;
+    size_t maxNumEvents = 0, maxNumNoteOns = 0;
+    const size_t hash;
+};
+
+//==============================================================================
+//==============================================================================
+class CachingMidiEventGenerator : public MidiGenerator
+{
+public:
+    CachingMidiEventGenerator (std::shared_ptr<const PreparedMidiSequences> preparedSequences,
+                               QuantisationType qt,
+                               const GrooveTemplate& grooveTemplate, float grooveStrength_)
+        : prepared (std::move (preparedSequences)),
+          quantisation (std::move (qt)),
+          groove (grooveTemplate),
+          grooveStrength (grooveStrength_)
+    {
+        assert (prepared);
+
+        // Reserve the scratch space for the sequence and note on/off map
+        noteOffMap.reserve (prepared->maxNumNoteOns);
+        currentSequence.events.reserve (prepared->maxNumEvents);
 
-        noteOffMap.reserve (maxNumNoteOns);
-        currentSequence.events.reserve (maxNumEvents);
+        // Cache the sequence at 0.0 time
+        cacheSequence (0.0, {});
     }
 
     void createMessagesForTime (MidiMessageArray& destBuffer,
@@ -886,18 +921,34 @@ public:
         // - Setting the sequence to be iterated
         // - Updating the offset used
 
+        const auto& sequences = prepared->sequences;
+
         if (sequences.size() > 0)
             if (++currentSequenceIndex >= sequences.size())
                 currentSequenceIndex = 0;
 
         // Create the cached sequence (without allocating)
         currentSequence.events.clear();
+        noteOffMap.clear();
 
         if (currentSequenceIndex < sequences.size())
-            MidiHelpers::addSequence (currentSequence, sequences[currentSequenceIndex], offsetBeats);
+        {
+            const auto& source = sequences[currentSequenceIndex];
+            currentSequence.events.insert (currentSequence.events.end(), source.sequence.begin(), source.sequence.end());
+            noteOffMap.insert (noteOffMap.end(), source.noteOffMap.begin(), source.noteOffMap.end());
+
+            for (auto& e : currentSequence.events)
+                e.timeStamp += offsetBeats;
+        }
 
         jassert (std::is_sorted (currentSequence.begin(), currentSequence.end()));
-        MidiHelpers::createNoteOffMap (noteOffMap, currentSequence);
+        cachedSequenceOffset = offsetBeats;
+
+        // The prepared sequences are already cut to the loop range so unless
+        // they get moved around, there's nothing else to do
+        if (! quantisation.isEnabled() && groove.isEmpty())
+            return;
+
         MidiHelpers::applyQuantisationToSequence (quantisation, false, currentSequence, noteOffMap);
 
         if (! groove.isEmpty())
@@ -912,8 +963,6 @@ public:
         }
 
         MidiHelpers::createNoteOffMap (noteOffMap, currentSequence);
-
-        cachedSequenceOffset = offsetBeats;
     }
 
     juce::MidiMessage getEvent() override
@@ -934,7 +983,7 @@ public:
     }
 
 private:
-    std::vector<juce::MidiMessageSequence> sequences;
+    std::shared_ptr<const PreparedMidiSequences> prepared;
 
     choc::midi::Sequence currentSequence;
     std::vector<std::pair<size_t, size_t>> noteOffMap;
@@ -1163,7 +1212,8 @@ public:
     }
 
     void initialise (std::shared_ptr<ActiveNoteList> noteListToUse,
-                     bool clipPropertiesHaveChanged, size_t lastSequencesHash,
+                     bool clipPropertiesHaveChanged,
+                     std::shared_ptr<const PreparedMidiSequences> lastPreparedSequences,
                      std::shared_ptr<BeatDuration> dynamicOffsetBeatsToUse)
     {
         if (isInitialised())
@@ -1178,15 +1228,24 @@ public:
         const EditBeatRange clipRangeRaw { editRange.getStart().inBeats(), editRange.getEnd().inBeats() };
         const ClipBeatRange loopRangeRaw { loopRange.getStart().inBeats(), loopRange.getEnd().inBeats() };
 
-        if (! loopRangeRaw.isEmpty())
-            sequences = MidiHelpers::createLoopSection (std::move (sequences), loopRangeRaw);
+        // If the content hasn't changed since the last graph, share its prepared sequences
+        auto sequencesHash = std::hash<std::vector<juce::MidiMessageSequence>>{} (sequences);
+        hash_combine (sequencesHash, loopRangeRaw.getStart());
+        hash_combine (sequencesHash, loopRangeRaw.getEnd());
+
+        const bool sequencesHaveChanged = lastPreparedSequences == nullptr || lastPreparedSequences->hash != sequencesHash;
+
+        if (sequencesHaveChanged)
+            preparedSequences = std::make_shared<const PreparedMidiSequences> (std::move (sequences), loopRangeRaw, sequencesHash);
+        else
+            preparedSequences = std::move (lastPreparedSequences);
 
-        sequencesHash = std::hash<std::vector<juce::MidiMessageSequence>>{} (sequences);
+        sequences = {};
 
-        if (sequencesHash != lastSequencesHash || clipPropertiesHaveChanged)
+        if (sequencesHaveChanged || clipPropertiesHaveChanged)
             shouldSendNoteOffsForNotesNoLongerPlaying = true;
 
-        auto cachingGenerator = std::make_unique<CachingMidiEventGenerator> (std::move (sequences),
+        auto cachingGenerator = std::make_unique<CachingMidiEventGenerator> (preparedSequences,
                                                                              std::move (quantisation), std::move (groove), grooveStrength);
         auto loopedGenerator = std::make_unique<LoopedMidiEventGenerator> (std::move (cachingGenerator),
                                                                            activeNoteList, clipRangeRaw, loopRangeRaw);
@@ -1357,9 +1416,9 @@ public:
                 && grooveStrength == o.grooveStrength;
     }
 
-    size_t getSequencesHash() const
+    const std::shared_ptr<const PreparedMidiSequences>& getPreparedSequences() const
     {
-        return sequencesHash;
+        return preparedSequences;
     }
 
     bool isInitialised() const
@@ -1373,7 +1432,7 @@ private:
     std::shared_ptr<BeatDuration> dynamicOffsetBeats;
 
     std::vector<juce::MidiMessageSequence> sequences;
-    size_t sequencesHash = 0;
+    std::shared_ptr<const PreparedMidiSequences> preparedSequences;
     const BeatRange editRange, loopRange;
     const BeatDuration offset;
     QuantisationType quantisation;
@@ -1468,18 +1527,18 @@ void LoopingMidiNode::prepareToPlay (const tracktion::graph::PlaybackInitialisat
 
     std::shared_ptr<ActiveNoteList> activeNoteList;
     bool clipPropertiesHaveChanged = false;
-    size_t lastSequencesHash = 0;
+    std::shared_ptr<const PreparedMidiSequences> lastPreparedSequences;
 
     if (auto oldNode = findNodeWithIDIfNonZero<LoopingMidiNode> (info.nodeGraphToReplace, getNodeProperties().nodeID))
     {
         midiSourceID = oldNode->midiSourceID;
         activeNoteList = oldNode->generatorAndNoteList->getActiveNoteList();
         clipPropertiesHaveChanged = ! generatorAndNoteList->hasSameContentAs (*oldNode->generatorAndNoteList);
-        lastSequencesHash = oldNode->generatorAndNoteList->getSequencesHash();
+        lastPreparedSequences = oldNode->generatorAndNoteList->getPreparedSequences();
         dynamicOffsetBeats = oldNode->dynamicOffsetBeats;
     }
 
-    generatorAndNoteList->initialise (activeNoteList, clipPropertiesHaveChanged, lastSequencesHash, dynamicOffsetBeats);
+    generatorAndNoteList->initialise (activeNoteList, clipPropertiesHaveChanged, std::move (lastPreparedSequences), dynamicOffsetBeats);
 }
 
 bool LoopingMidiNode::isReadyToProcess()
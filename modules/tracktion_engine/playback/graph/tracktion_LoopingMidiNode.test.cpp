@@ -47,6 +47,7 @@ public:
         runProgramChangeTests (true);
 
         runSequenceClippingTests();
+        runNoteOffMapTests();
     }
 
 private:
@@ -321,6 +322,54 @@ private:
 
     }
 
+    void runNoteOffMapTests()
+    {
+        beginTest ("Note-off map");
+
+        // Compare against a brute force search for the next matching note-off,
+        // including overlapping notes with the same number and unterminated notes
+        auto r = getRandom();
+
+        for (int i = 0; i < 100; ++i)
+        {
+            choc::midi::Sequence seq;
+
+            for (int j = 0; j < 500; ++j)
+            {
+                const auto status = (uint8_t) ((r.nextBool() ? 0x90 : 0x80) | r.nextInt (2));
+                seq.events.push_back ({ (double) j, choc::midi::ShortMessage (status, (uint8_t) (60 + r.nextInt (4)),
+                                                                              (uint8_t) (r.nextInt (5) == 0 ? 0 : 100)) });
+            }
+
+            std::vector<std::pair<size_t, size_t>> expected, noteOffMap;
+
+            for (size_t on = 0; on < seq.events.size(); ++on)
+            {
+                const auto& m = seq.events[on].message;
+
+                if (! m.isNoteOn())
+                    continue;
+
+                for (size_t off = on + 1; off < seq.events.size(); ++off)
+                {
+                    const auto& m2 = seq.events[off].message;
+
+                    if (m2.isNoteOff() && m2.getNoteNumber() == m.getNoteNumber() && m2.getChannel0to15() == m.getChannel0to15())
+                    {
+                        expected.emplace_back (on, off);
+                        break;
+                    }
+                }
+            }
+
+            MidiHelpers::createNoteOffMap (noteOffMap, seq);
+            expect (noteOffMap == expected);
+
+            for (auto [on, off] : expected)
+                expectEquals (MidiHelpers::getNoteOffIndex (on, noteOffMap).value_or (0), off);
+        }
+    }
+
     void runSequenceClippingTest (std::vector<BytesAndTimeStamp> data, juce::Range<double> clipRange, size_t numEventsExpected)
     {
         choc::midi::Sequence seq;
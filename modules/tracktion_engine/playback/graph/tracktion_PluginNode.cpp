@@ -25,6 +25,16 @@ namespace
 
         return true;
     }
+
+    static bool isSilent (const choc::buffer::ChannelArrayView<float>& view)
+    {
+        constexpr float silenceThreshold = 1.0e-5f; // -100dB
+
+        if (view.getNumChannels() == 0 || view.getNumFrames() == 0)
+            return true;
+
+        return toAudioBuffer (view).getMagnitude (0, (int) view.getNumFrames()) < silenceThreshold;
+    }
 }
 
 //==============================================================================
@@ -99,11 +109,11 @@ void PluginNode::prepareToPlay (const tracktion::graph::PlaybackInitialisationIn
     if (shouldUseFineGrainAutomation (*plugin))
         subBlockSizeToUse = std::max (128, 128 * juce::roundToInt (info.sampleRate / 44100.0));
 
-    canProcessBypassed = balanceLatency
-                            && dynamic_cast<ExternalPlugin*> (plugin.get()) != nullptr
-                            && latencyNumSamples > 0;
+    const bool isExternalPlugin = dynamic_cast<ExternalPlugin*> (plugin.get()) != nullptr;
+    canProcessBypassed = balanceLatency && isExternalPlugin && latencyNumSamples > 0;
 
-    if (canProcessBypassed)
+    // The delayed dry signal is used for any bypassed plugin with latency so the latency doesn't change
+    if (balanceLatency && latencyNumSamples > 0)
     {
         replaceLatencyProcessorIfPossible (info.nodeGraphToReplace);
 
@@ -115,6 +125,20 @@ void PluginNode::prepareToPlay (const tracktion::graph::PlaybackInitialisationIn
         }
     }
 
+    // External plugins are reset when they're bypassed so there's no tail to play out,
+    // they just need to carry on being called until their latency has passed.
+    // Internal plugins are fed silence until their tail has finished. As the tail
+    // can change with the plugin's parameters it's only measured when it's bypassed.
+    canFlushTail = ! isExternalPlugin;
+
+    if (canFlushTail)
+        tailBuffer.setSize (props.numberOfChannels, info.blockSize);
+
+    bypassState = plugin->isEnabled() ? BypassState::active : BypassState::suspended;
+
+    canSleep = plugin->canSleepWhenSilent()
+                && plugin->engine.getEngineBehaviour().shouldPluginsSleepWhenSilent();
+
     isPrepared = true;
 
     if (info.enableNodeMemorySharing && input->numOutputNodes == 1)
@@ -176,7 +200,27 @@ void PluginNode::process (ProcessContext& pc)
     choc::buffer::FrameCount numSamplesDone = 0;
     auto numSamplesLeft = blockNumSamples;
 
-    bool shouldProcessPlugin = canProcessBypassed || plugin->isEnabled();
+    const bool isPluginEnabled = plugin->isEnabled();
+    updateBypassState (isPluginEnabled);
+
+    const bool isFlushingTail = bypassState == BypassState::flushingTail;
+    const bool isFlushingTailWithSilence = isFlushingTail && canFlushTail;
+    const bool hasTailJustStarted = isFlushingTail && numTailSamplesRemaining == tailNumSamples;
+    jassert (! isFlushingTailWithSilence || (int) blockNumSamples <= tailBuffer.getNumSamples());
+
+    // Sleeping plugins are woken up by any MIDI or audio, as the whole block is processed
+    // the plugin sees these at the right sample
+    const bool canSleepThisBlock = canSleep && bypassState == BypassState::active;
+    const bool hasInput = canSleepThisBlock && (! inputBuffers.midi.isEmpty() || ! isSilent (inputAudioBlock));
+
+    if (hasInput)
+    {
+        isAsleep = false;
+        numSilentSamples = 0;
+    }
+
+    const bool isSleepingThisBlock = canSleepThisBlock && isAsleep;
+    bool shouldProcessPlugin = (isPluginEnabled && ! isSleepingThisBlock) || isFlushingTail;
     bool isAllNotesOff = inputBuffers.midi.isAllNotesOff;
 
     if (playHeadState.didPlayheadJump())
@@ -227,9 +271,28 @@ void PluginNode::process (ProcessContext& pc)
 
         // Process the plugin
         if (shouldProcessPlugin)
-            plugin->applyToBufferWithAutomation (getPluginRenderContext ({ blockTimeRange.getStart() + toDuration (subBlockTimeRange.getStart()),
-                                                                           blockTimeRange.getStart() + toDuration (subBlockTimeRange.getEnd()) },
-                                                                         outputAudioBuffer));
+        {
+            const TimeRange subBlockEditTimeRange (blockTimeRange.getStart() + toDuration (subBlockTimeRange.getStart()),
+                                                   blockTimeRange.getStart() + toDuration (subBlockTimeRange.getEnd()));
+
+            if (isFlushingTailWithSilence)
+            {
+                // Bypassed plugins don't get any input, the tail is added to the dry signal below
+                juce::AudioBuffer<float> tailAudioBuffer (tailBuffer.getArrayOfWritePointers(),
+                                                          std::min (tailBuffer.getNumChannels(), outputAudioBuffer.getNumChannels()),
+                                                          (int) numSamplesDone, (int) numSamplesThisBlock);
+                tailAudioBuffer.clear();
+
+                tailMidiMessageArray.clear();
+                tailMidiMessageArray.isAllNotesOff = hasTailJustStarted && subBlockNum == 0;
+
+                plugin->applyToBufferWithAutomation (getPluginRenderContext (subBlockEditTimeRange, tailAudioBuffer, tailMidiMessageArray));
+            }
+            else
+            {
+                plugin->applyToBufferWithAutomation (getPluginRenderContext (subBlockEditTimeRange, outputAudioBuffer, midiMessageArray));
+            }
+        }
 
         // Then copy the buffers to the outputs
         if (subBlockNum == 0)
@@ -250,7 +313,7 @@ void PluginNode::process (ProcessContext& pc)
     if (latencyProcessor)
     {
         // A slightly better approach would be to crossfade between the processed and latency block to minimise any discrepancies
-        if (plugin->isEnabled())
+        if (isPluginEnabled)
         {
             auto numSamples = (int) blockNumSamples;
             latencyProcessor->clearAudio (numSamples);
@@ -268,6 +331,27 @@ void PluginNode::process (ProcessContext& pc)
         }
     }
 
+    if (isFlushingTail)
+    {
+        if (isFlushingTailWithSilence && shouldProcessPlugin)
+        {
+            const auto numChannels = std::min ((choc::buffer::ChannelCount) tailBuffer.getNumChannels(), outputAudioView.getNumChannels());
+            choc::buffer::add (outputAudioView.getFirstChannels (numChannels),
+                               toBufferView (tailBuffer).getFirstChannels (numChannels).getStart (blockNumSamples));
+        }
+
+        numTailSamplesRemaining -= (int64_t) blockNumSamples;
+
+        if (numTailSamplesRemaining <= 0)
+            bypassState = BypassState::suspended;
+    }
+
+    if (canSleepThisBlock && ! isSleepingThisBlock)
+        updateSleepState (hasInput || ! isSilent (outputAudioView), blockNumSamples);
+
+    if (canSleep)
+        plugin->updateSleepStatistics (isSleepingThisBlock, (int) blockNumSamples);
+
     // Some plugins flake and add NaNs so zero these out to avoid killing all the audio downstream
     sanitise (outputAudioView);
 }
@@ -282,17 +366,96 @@ void PluginNode::initialisePlugin (double sampleRateToUse, int blockSizeToUse)
     latencyNumSamples = juce::roundToInt (plugin->getLatencySeconds() * sampleRate);
 }
 
-PluginRenderContext PluginNode::getPluginRenderContext (TimeRange editTime, juce::AudioBuffer<float>& destBuffer)
+PluginRenderContext PluginNode::getPluginRenderContext (TimeRange editTime, juce::AudioBuffer<float>& destBuffer,
+                                                       MidiMessageArray& midiBuffer)
 {
     return { &destBuffer,
              juce::AudioChannelSet::canonicalChannelSet (destBuffer.getNumChannels()),
              0, destBuffer.getNumSamples(),
-             &midiMessageArray, 0.0,
+             &midiBuffer, 0.0,
              editTime + automationAdjustmentTime,
              playHeadState.playHead.isPlaying(), playHeadState.playHead.isUserDragging(),
              isRendering, canProcessBypassed };
 }
 
+void PluginNode::updateBypassState (bool isPluginEnabled)
+{
+    if (isPluginEnabled)
+    {
+        if (bypassState != BypassState::active)
+        {
+            isAsleep = false;
+            numSilentSamples = 0;
+        }
+
+        bypassState = BypassState::active;
+        return;
+    }
+
+    if (bypassState == BypassState::active)
+    {
+        // A sleeping plugin has no tail left to play
+        if (isAsleep)
+        {
+            bypassState = BypassState::suspended;
+            return;
+        }
+
+        tailNumSamples = getTailNumSamples();
+        numTailSamplesRemaining = tailNumSamples;
+        bypassState = tailNumSamples > 0 ? BypassState::flushingTail
+                                         : BypassState::suspended;
+    }
+}
+
+int64_t PluginNode::getTailNumSamples() const
+{
+    if (! canFlushTail)
+        return canProcessBypassed ? latencyNumSamples : 0;
+
+    const auto tailSeconds = plugin->getTailLength();
+    auto numSamples = (int64_t) latencyNumSamples;
+
+    // Tails that never end, e.g. delays with full feedback, keep the plugin running
+    if (! std::isfinite (tailSeconds))
+        return std::numeric_limits<int64_t>::max();
+
+    if (tailSeconds > 0.0)
+        numSamples += (int64_t) std::ceil (tailSeconds * sampleRate);
+
+    return numSamples;
+}
+
+int64_t PluginNode::getNumSilentSamplesBeforeSleeping() const
+{
+    const auto tailSeconds = plugin->getTailLength();
+
+    if (! std::isfinite (tailSeconds))
+        return std::numeric_limits<int64_t>::max();
+
+    // Some plugins under-report their tails so they're always given at least a second
+    return latencyNumSamples + (int64_t) std::ceil (std::max (1.0, tailSeconds) * sampleRate);
+}
+
+void PluginNode::updateSleepState (bool hasSignal, choc::buffer::FrameCount numSamples)
+{
+    if (hasSignal)
+    {
+        numSilentSamples = 0;
+        return;
+    }
+
+    // As with bypassing, the tail can change with the plugin's parameters so it's
+    // measured each time the plugin starts being silent
+    if (numSilentSamples == 0)
+        numSilentSamplesBeforeSleeping = getNumSilentSamplesBeforeSleeping();
+
+    numSilentSamples += (int64_t) numSamples;
+
+    if (numSilentSamples >= numSilentSamplesBeforeSleeping)
+        isAsleep = true;
+}
+
 void PluginNode::replaceLatencyProcessorIfPossible (NodeGraph* nodeGraphToReplace)
 {
     if (nodeGraphToReplace == nullptr)
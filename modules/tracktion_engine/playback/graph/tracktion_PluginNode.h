@@ -78,9 +78,35 @@ private:
     std::optional<NodeProperties> cachedNodeProperties;
     bool isPrepared = false, canUseSourceBuffers = false;
 
+    //==============================================================================
+    /** When a plugin is bypassed it's only called until its tail has finished.
+        After that it's suspended which costs nothing and, as the Node stays in
+        the graph, re-enabling it doesn't need the graph to be rebuilt.
+    */
+    enum class BypassState
+    {
+        active,         ///< The plugin is enabled and processed as normal
+        flushingTail,   ///< The plugin is bypassed but its tail is still playing out
+        suspended       ///< The plugin is bypassed and no longer called
+    };
+
+    BypassState bypassState = BypassState::active;
+    bool canFlushTail = false;
+    int64_t tailNumSamples = 0, numTailSamplesRemaining = 0;
+    juce::AudioBuffer<float> tailBuffer;
+    tracktion::engine::MidiMessageArray tailMidiMessageArray;
+
+    // Plugins that support it are put to sleep when they've been silent for longer than their tail
+    bool canSleep = false, isAsleep = false;
+    int64_t numSilentSamples = 0, numSilentSamplesBeforeSleeping = 0;
+
     //==============================================================================
     void initialisePlugin (double sampleRateToUse, int blockSizeToUse);
-    PluginRenderContext getPluginRenderContext (TimeRange, juce::AudioBuffer<float>&);
+    PluginRenderContext getPluginRenderContext (TimeRange, juce::AudioBuffer<float>&, MidiMessageArray&);
+    void updateBypassState (bool isPluginEnabled);
+    int64_t getTailNumSamples() const;
+    int64_t getNumSilentSamplesBeforeSleeping() const;
+    void updateSleepState (bool hasSignal, choc::buffer::FrameCount numSamples);
     void replaceLatencyProcessorIfPossible (NodeGraph*);
 };
 
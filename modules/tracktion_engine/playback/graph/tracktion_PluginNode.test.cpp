@@ -0,0 +1,352 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_PLUGIN_NODE
+
+#include <tracktion_engine/../3rd_party/doctest/tracktion_doctest.hpp>
+#include <tracktion_engine/testing/tracktion_EnginePlayer.h>
+#include <tracktion_engine/utilities/tracktion_TestUtilities.h>
+
+namespace tracktion::inline engine
+{
+
+namespace plugin_node_test_utilities
+{
+    //==============================================================================
+    /** Delays its input by its latency and, after each non-zero input sample or MIDI
+        note-on, adds a constant level for the length of its tail so the tail is easy to find.
+        The tail can also be a single short echo at its end, with silence before it.
+    */
+    class TailTestPlugin  : public Plugin
+    {
+    public:
+        TailTestPlugin (PluginCreationInfo info)
+            : Plugin (info)
+        {
+        }
+
+        ~TailTestPlugin() override
+        {
+            notifyListenersOfDeletion();
+        }
+
+        static const char* getPluginName()                      { return "Tail Tester"; }
+        static inline const char* xmlTypeName = "tailTester";
+
+        juce::String getName() const override                   { return getPluginName(); }
+        juce::String getPluginType() override                   { return xmlTypeName; }
+        juce::String getSelectableDescription() override        { return getName(); }
+
+        double getLatencySeconds() override                     { return latencySeconds; }
+        double getTailLength() const override                   { return tailSeconds.load(); }
+        bool takesMidiInput() override                          { return true; }
+        bool canSleepWhenSilent() override                      { return sleepsWhenSilent; }
+
+        void initialise (const PluginInitialisationInfo& info) override
+        {
+            sampleRate = info.sampleRate;
+            delayLine.assign ((size_t) juce::roundToInt (latencySeconds * sampleRate) + 1, 0.0f);
+            delayPos = 0;
+            numTailSamplesLeft = 0;
+        }
+
+        void deinitialise() override {}
+
+        void applyToBuffer (const PluginRenderContext& fc) override
+        {
+            ++numBlocksProcessed;
+
+            if (fc.destBuffer == nullptr)
+                return;
+
+            auto& buffer = *fc.destBuffer;
+            std::vector<int> noteOnSamples;
+
+            if (fc.bufferForMidiMessages != nullptr)
+                for (auto& m : *fc.bufferForMidiMessages)
+                    if (m.isNoteOn())
+                        noteOnSamples.push_back (fc.bufferStartSample + juce::roundToInt (m.getTimeStamp() * sampleRate));
+
+            numNoteOnsSeen += (int) noteOnSamples.size();
+
+            for (int i = fc.bufferStartSample; i < fc.bufferStartSample + fc.bufferNumSamples; ++i)
+            {
+                delayLine[delayPos] = buffer.getSample (0, i);
+                delayPos = (delayPos + 1) % delayLine.size();
+                const auto delayed = delayLine[delayPos];
+
+                if (delayed != 0.0f || std::find (noteOnSamples.begin(), noteOnSamples.end(), i) != noteOnSamples.end())
+                    numTailSamplesLeft = (int64_t) std::ceil (tailSeconds.load() * sampleRate);
+
+                const bool isPlayingTail = numTailSamplesLeft > 0
+                                            && (! tailIsAnEcho || numTailSamplesLeft <= (int64_t) std::ceil (echoSeconds * sampleRate));
+                const auto out = delayed + (isPlayingTail ? tailLevel : 0.0f);
+                numTailSamplesLeft = std::max<int64_t> (0, numTailSamplesLeft - 1);
+
+                for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+                    buffer.setSample (chan, i, out);
+            }
+        }
+
+        static constexpr float tailLevel = 0.25f;
+        static constexpr double echoSeconds = 0.01;
+
+        double latencySeconds = 0.0;            // Set before playback starts
+        bool sleepsWhenSilent = false;          // Set before playback starts
+        bool tailIsAnEcho = false;              // Only plays the last echoSeconds of the tail, like a delay's repeat
+        std::atomic<double> tailSeconds { 0.0 };
+        std::atomic<int> numBlocksProcessed { 0 }, numNoteOnsSeen { 0 };
+
+    private:
+        double sampleRate = 44100.0;
+        std::vector<float> delayLine;
+        size_t delayPos = 0;
+        int64_t numTailSamplesLeft = 0;
+    };
+
+    //==============================================================================
+    /** Returns the largest absolute sample in the first channel of the output in a time range. */
+    inline float getMagnitude (const test_utilities::EnginePlayer& player, TimeRange range)
+    {
+        const auto sampleRate = player.getParams().sampleRate;
+        const auto output = player.getOutput();
+        const auto start = toSamples (range.getStart(), sampleRate);
+        const auto end = std::min ((int64_t) output.getNumFrames(), toSamples (range.getEnd(), sampleRate));
+
+        return toAudioBuffer (output.getView()).getMagnitude (0, (int) start, (int) (end - start));
+    }
+
+    inline juce::ReferenceCountedObjectPtr<TailTestPlugin> insertTailTestPlugin (AudioTrack& track)
+    {
+        track.edit.engine.getPluginManager().createBuiltInType<TailTestPlugin>();
+        return insertNewPlugin<TailTestPlugin> (track);
+    }
+}
+
+//==============================================================================
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("PluginNode: Bypassed plugins play out their tail and are then suspended")
+    {
+        using namespace plugin_node_test_utilities;
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+
+        // Transients at 1s and 4s
+        const auto transientFile = graph::test_utilities::getTransientFile<juce::WavAudioFormat> (p.sampleRate, 3_td, 1_tp, 0.5f);
+        const auto af = AudioFile (engine, transientFile->getFile());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, transientFile->getFile(), { { 0_tp, 3_tp } }, DeleteExistingClips::no);
+        insertWaveClip (*track, {}, transientFile->getFile(), { { 3_tp, 6_tp } }, DeleteExistingClips::no);
+
+        auto plugin = insertTailTestPlugin (*track);
+        auto player = test_utilities::createEnginePlayer (*edit, p, { af });
+        test_utilities::process (*player, 0.5_td);
+
+        // Tails usually depend on parameters, so changing it after the plugin has been
+        // prepared has to be picked up when it's bypassed
+        plugin->tailSeconds = 1.0;
+        test_utilities::process (*player, 1_td);
+
+        plugin->setEnabled (false);
+        test_utilities::process (*player, 1_td);
+
+        SUBCASE ("The tail is played whilst bypassed")
+        {
+            CHECK_GT (getMagnitude (*player, { 1.6_tp, 1.9_tp }), TailTestPlugin::tailLevel * 0.5f);
+            CHECK_LT (getMagnitude (*player, { 2.1_tp, 2.5_tp }), 1.0e-5f);
+        }
+
+        SUBCASE ("Once the tail has finished the plugin isn't called")
+        {
+            test_utilities::process (*player, 0.5_td);
+            const int numBlocksProcessed = plugin->numBlocksProcessed;
+            test_utilities::process (*player, 1_td);
+            CHECK_EQ (plugin->numBlocksProcessed.load(), numBlocksProcessed);
+        }
+
+        SUBCASE ("Re-enabling a suspended plugin processes it again")
+        {
+            test_utilities::process (*player, 1_td);
+            const int numBlocksProcessed = plugin->numBlocksProcessed;
+
+            plugin->setEnabled (true);
+            test_utilities::process (*player, 2_td);
+
+            CHECK_GT (plugin->numBlocksProcessed.load(), numBlocksProcessed);
+            CHECK_GT (getMagnitude (*player, { 4.1_tp, 4.9_tp }), TailTestPlugin::tailLevel * 0.5f);
+        }
+    }
+
+    TEST_CASE ("PluginNode: Bypassed plugins keep their latency")
+    {
+        using namespace plugin_node_test_utilities;
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        const auto transientPos = 1_tp;
+        const auto transientFile = graph::test_utilities::getTransientFile<juce::WavAudioFormat> (p.sampleRate, 3_td, transientPos, 0.5f);
+        const auto af = AudioFile (engine, transientFile->getFile());
+        constexpr double latencySeconds = 0.1;
+
+        auto findTransient = [&] (bool enabled, bool bypassWhilstPlaying)
+        {
+            auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+            auto track = getAudioTracks (*edit)[0];
+            insertWaveClip (*track, {}, transientFile->getFile(), { { 0_tp, 3_tp } }, DeleteExistingClips::no);
+
+            auto plugin = insertTailTestPlugin (*track);
+            plugin->latencySeconds = latencySeconds;
+            plugin->setEnabled (enabled);
+
+            auto player = test_utilities::createEnginePlayer (*edit, p, { af });
+            test_utilities::process (*player, 0.5_td);
+
+            if (bypassWhilstPlaying)
+                plugin->setEnabled (false);
+
+            test_utilities::process (*player, 1.5_td);
+
+            return graph::test_utilities::findFirstNonZeroSample (player->getOutput().getChannel (0));
+        };
+
+        const auto expectedSample = toSamples (transientPos + TimeDuration::fromSeconds (latencySeconds), p.sampleRate);
+
+        for (auto [enabled, bypassWhilstPlaying] : { std::pair (true, false), std::pair (false, false), std::pair (true, true) })
+        {
+            const auto transient = findTransient (enabled, bypassWhilstPlaying);
+            REQUIRE (transient);
+            CHECK_EQ ((int64_t) transient->first, expectedSample);
+        }
+    }
+
+    TEST_CASE ("PluginNode: Silent plugins are put to sleep")
+    {
+        using namespace plugin_node_test_utilities;
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+
+        // A transient at 2s and a MIDI note at 6s
+        const auto transientFile = graph::test_utilities::getTransientFile<juce::WavAudioFormat> (p.sampleRate, 3_td, 2_tp, 0.5f);
+        const auto af = AudioFile (engine, transientFile->getFile());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, transientFile->getFile(), { { 0_tp, 3_tp } }, DeleteExistingClips::no);
+
+        auto midiClip = insertMIDIClip (*track, { 6_tp, 7_tp });
+        midiClip->getSequence().addNote (60, BeatPosition(), BeatDuration::fromBeats (0.5), 100, 0, nullptr);
+
+        // Plugins sleep after their tail and latency, or a second if that's longer
+        auto plugin = insertTailTestPlugin (*track);
+        plugin->sleepsWhenSilent = true;
+        plugin->latencySeconds = 0.1;
+        plugin->tailSeconds = 1.5;
+
+        auto player = test_utilities::createEnginePlayer (*edit, p, { af });
+        test_utilities::process (*player, 1.55_td);
+        CHECK_FALSE (plugin->getSleepStatistics().isAsleep);
+
+        test_utilities::process (*player, 0.15_td);
+        CHECK (plugin->getSleepStatistics().isAsleep);
+        CHECK_EQ (plugin->getSleepStatistics().numTimesSlept, 1);
+
+        SUBCASE ("Sleeping plugins aren't called")
+        {
+            const int numBlocksProcessed = plugin->numBlocksProcessed;
+            test_utilities::process (*player, 0.2_td);
+            CHECK_EQ (plugin->numBlocksProcessed.load(), numBlocksProcessed);
+            CHECK_GT (plugin->getSleepStatistics().secondsAsleep, 0.2);
+        }
+
+        SUBCASE ("Sleeping plugins wake up on the block audio or MIDI arrives")
+        {
+            // The plugin only sees the transient if it's woken on its block
+            test_utilities::process (*player, 0.5_td);
+            CHECK_GT (getMagnitude (*player, { 2.101_tp, 2.105_tp }), TailTestPlugin::tailLevel * 0.5f);
+            CHECK_FALSE (plugin->getSleepStatistics().isAsleep);
+
+            // The tail finishes at 3.6s so it should be asleep again from 5.2s
+            test_utilities::process (*player, 3.2_td);
+            CHECK (plugin->getSleepStatistics().isAsleep);
+            CHECK_EQ (plugin->getSleepStatistics().numTimesSlept, 2);
+            CHECK_EQ (plugin->numNoteOnsSeen.load(), 0);
+
+            test_utilities::process (*player, 1.0_td);
+            CHECK_EQ (plugin->numNoteOnsSeen.load(), 1);
+            CHECK_LT (getMagnitude (*player, { 5.9_tp, 5.999_tp }), 1.0e-5f);
+            CHECK_GT (getMagnitude (*player, { 6.001_tp, 6.005_tp }), TailTestPlugin::tailLevel * 0.5f);
+            CHECK_FALSE (plugin->getSleepStatistics().isAsleep);
+            CHECK_EQ (plugin->getSleepStatistics().numTimesSlept, 2);
+        }
+
+        SUBCASE ("Bypassing a sleeping plugin suspends it straight away")
+        {
+            const int numBlocksProcessed = plugin->numBlocksProcessed;
+
+            plugin->setEnabled (false);
+            test_utilities::process (*player, 1.3_td);
+
+            // No tail is played for the transient as the plugin isn't called
+            CHECK_EQ (plugin->numBlocksProcessed.load(), numBlocksProcessed);
+            CHECK_LT (getMagnitude (*player, { 2.101_tp, 2.5_tp }), 1.0e-5f);
+            CHECK_FALSE (plugin->getSleepStatistics().isAsleep);
+
+            // Re-enabling it wakes it up until it's been silent for long enough again
+            plugin->setEnabled (true);
+            test_utilities::process (*player, 0.5_td);
+            CHECK_GT (plugin->numBlocksProcessed.load(), numBlocksProcessed);
+            CHECK_FALSE (plugin->getSleepStatistics().isAsleep);
+
+            test_utilities::process (*player, 1.5_td);
+            CHECK (plugin->getSleepStatistics().isAsleep);
+            CHECK_EQ (plugin->getSleepStatistics().numTimesSlept, 2);
+        }
+    }
+
+    TEST_CASE ("PluginNode: Plugins don't sleep through the tail they have when they go silent")
+    {
+        using namespace plugin_node_test_utilities;
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+
+        const auto transientFile = graph::test_utilities::getTransientFile<juce::WavAudioFormat> (p.sampleRate, 4_td, 0.8_tp, 0.5f);
+        const auto af = AudioFile (engine, transientFile->getFile());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, transientFile->getFile(), { { 0_tp, 4_tp } }, DeleteExistingClips::no);
+
+        auto plugin = insertTailTestPlugin (*track);
+        plugin->sleepsWhenSilent = true;
+        plugin->tailIsAnEcho = true;
+
+        auto player = test_utilities::createEnginePlayer (*edit, p, { af });
+        test_utilities::process (*player, 0.5_td);
+
+        // Lengthening the tail after the plugin has been prepared puts the echo for the
+        // transient at 0.8s more than a second after it
+        plugin->tailSeconds = 2.0;
+        test_utilities::process (*player, 3_td);
+
+        CHECK_LT (getMagnitude (*player, { 0.9_tp, 2.7_tp }), 1.0e-5f);
+        CHECK_GT (getMagnitude (*player, { 2.791_tp, 2.799_tp }), TailTestPlugin::tailLevel * 0.5f);
+        CHECK_EQ (plugin->getSleepStatistics().numTimesSlept, 0);
+    }
+}
+
+} // namespace tracktion::inline engine
+
+#endif
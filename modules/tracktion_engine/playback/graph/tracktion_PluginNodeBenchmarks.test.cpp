@@ -35,6 +35,7 @@ public:
         auto& engine = *tracktion::engine::Engine::getEngines()[0];
         runNodePreparationBenchmarks (engine);
         runLargeGraphUpdateBenchmark (engine);
+        runFourOscPolyphonyBenchmark (engine);
     }
 
 private:
@@ -149,6 +150,48 @@ private:
             }
         }
     }
+
+    void runFourOscPolyphonyBenchmark (Engine& engine)
+    {
+        using namespace benchmark_utilities;
+        using namespace tracktion::graph::test_utilities;
+
+        // A pad with all 32 voices playing 4 detuned saw oscillators with 8 unison voices each
+        static auto padPatch = R"patch(
+            <PLUGIN type="4osc" id="1069" enabled="1" filterType="1" filterSlope="24" filterFreq="100.0"
+                    ampAttack="0.5" ampSustain="100.0" ampRelease="1.0"
+                    waveShape1="3" voices1="8" detune1="0.2" spread1="100.0"
+                    waveShape2="3" voices2="8" detune2="0.3" spread2="-100.0" tune2="12.0"
+                    waveShape3="3" voices3="8" detune3="0.1" spread3="50.0" tune3="-12.0"
+                    waveShape4="2" voices4="8" detune4="0.2" spread4="-50.0" level4="-6.0">
+              <MODMATRIX/>
+            </PLUGIN>
+            )patch";
+
+        auto edit = Edit::createSingleTrackEdit (engine);
+        auto track = getAudioTracks (*edit)[0];
+
+        auto synth = edit->getPluginCache().createNewPlugin (FourOscPlugin::xmlTypeName, {});
+        jassert (synth != nullptr);
+
+        if (auto e = juce::parseXML (padPatch))
+            if (auto v = juce::ValueTree::fromXml (*e); v.isValid())
+                synth->restorePluginStateFromValueTree (v);
+
+        track->pluginList.insertPlugin (synth, 0, nullptr);
+
+        constexpr int numNotes = 32;
+        auto midiClip = track->insertMIDIClip ({ TimePosition(), TimePosition::fromSeconds (10.0) }, nullptr);
+
+        for (int i = 0; i < numNotes; ++i)
+            midiClip->getSequence().addNote (36 + i, BeatPosition(), BeatDuration::fromBeats (16.0), 100, 0, nullptr);
+
+        TestSetup ts;
+        ts.sampleRate = 44100.0;
+        ts.blockSize = 256;
+
+        renderEdit (*this, { edit.get(), "FourOsc pad with 32 voices", ts, MultiThreaded::no, LockFree::yes, ThreadPoolStrategy::conditionVariable });
+    }
 };
 
 static PluginNodeBenchmarks pluginNodeBenchmarks;
@@ -329,11 +329,8 @@ void SlotControlNode::processStop (ProcessContext& pc, double timestampForMidiNo
                     const auto dest = buffer.getIterator (channel).sample;
                     auto& lastSample = (*lastSamples)[(size_t) channel];
 
-                    for (uint32_t i = 0; i < lastSampleFadeLength; ++i)
-                    {
-                        auto alpha = i / (float) lastSampleFadeLength;
-                        dest[i] = lastSample * (1.0f - alpha);
-                    }
+                    juce::FloatVectorOperations::clear (dest, (int) lastSampleFadeLength);
+                    AudioFadeCurve::rampFromValue (dest, (int) lastSampleFadeLength, lastSample);
 
                     lastSample = 0.0f;
                 }
@@ -256,13 +256,7 @@ void SpeedRampWaveNode::processSection (ProcessContext& pc, juce::Range<int64_t>
             state.resampler.processAdding (ratio, src, dest, (int) numSamples, gains[channel & 1]);
 
             if (lastSampleFadeLength > 0)
-            {
-                for (uint32_t i = 0; i < lastSampleFadeLength; ++i)
-                {
-                    auto alpha = i / (float) lastSampleFadeLength;
-                    dest[i] = alpha * dest[i] + state.lastSample * (1.0f - alpha);
-                }
-            }
+                AudioFadeCurve::rampFromValue (dest, (int) lastSampleFadeLength, state.lastSample);
 
             state.lastSample = dest[numSamples - 1];
         }
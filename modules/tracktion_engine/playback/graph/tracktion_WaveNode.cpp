@@ -1724,11 +1724,8 @@ void WaveNode::processSection (ProcessContext& pc, juce::Range<int64_t> timeline
 
             const auto dest = destBuffer.getIterator (channel).sample;
 
-            for (uint32_t i = 0; i < lastSampleFadeLength; ++i)
-            {
-                auto alpha = i / (float) lastSampleFadeLength;
-                dest[i] = state.lastSample * (1.0f - alpha);
-            }
+            juce::FloatVectorOperations::clear (dest, (int) lastSampleFadeLength);
+            AudioFadeCurve::rampFromValue (dest, (int) lastSampleFadeLength, state.lastSample);
         }
 
         for (auto state : *channelState)
@@ -1770,13 +1767,7 @@ void WaveNode::processSection (ProcessContext& pc, juce::Range<int64_t> timeline
             state.resampler.processAdding (ratio, src, dest, (int) numFrames, gains[channel & 1]);
 
             if (lastSampleFadeLength > 0)
-            {
-                for (uint32_t i = 0; i < lastSampleFadeLength; ++i)
-                {
-                    auto alpha = i / (float) lastSampleFadeLength;
-                    dest[i] = alpha * dest[i] + state.lastSample * (1.0f - alpha);
-                }
-            }
+                AudioFadeCurve::rampFromValue (dest, (int) lastSampleFadeLength, state.lastSample);
 
             state.lastSample = dest[numFrames - 1];
         }
@@ -2312,13 +2303,7 @@ void WaveNodeRealTime::processSection (ProcessContext& pc)
             auto& lastSample = (*channelState)[(size_t) channel];
 
             if (lastSampleFadeLength > 0)
-            {
-                for (uint32_t i = 0; i < lastSampleFadeLength; ++i)
-                {
-                    auto alpha = i / (float) lastSampleFadeLength;
-                    dest[i] = alpha * dest[i] + lastSample * (1.0f - alpha);
-                }
-            }
+                AudioFadeCurve::rampFromValue (dest, (int) lastSampleFadeLength, lastSample);
 
             lastSample = dest[numFrames - 1];
         }
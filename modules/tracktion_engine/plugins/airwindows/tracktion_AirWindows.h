@@ -67,6 +67,8 @@ public:
     bool producesAudioWhenNoAudioInput() override    { return true; }
     bool canBeAddedToClip() override                 { return true; }
     bool canBeAddedToRack() override                 { return true; }
+    bool canOversample() override                    { return true; }
+    double getLatencySeconds() override;
 
     //==============================================================================
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
@@ -83,6 +85,7 @@ protected:
     juce::CriticalSection lock;
     AirWindowsCallback callback;
     std::unique_ptr<AirWindowsBase> impl;
+    Oversampler oversampler;
 
 public:
     //==============================================================================
@@ -18,7 +18,7 @@ AirWindowsCallback::AirWindowsCallback (AirWindowsPlugin& o)
 
 double AirWindowsCallback::getSampleRate()
 {
-    return owner.sampleRate;
+    return owner.sampleRate * owner.oversampler.getRatio();
 }
 
 //==============================================================================
@@ -87,12 +87,20 @@ juce::String AirWindowsPlugin::getSelectableDescription()
 void AirWindowsPlugin::initialise (const PluginInitialisationInfo& info)
 {
     sampleRate = info.sampleRate;
+    oversampler.prepare (Oversampler::Factor::x8, std::max ({ 2, impl->getNumInputs(), impl->getNumOutputs() }),
+                         info.blockSizeSamples);
+    oversampler.setFactor (getOversamplingFactor());
 }
 
 void AirWindowsPlugin::deinitialise()
 {
 }
 
+double AirWindowsPlugin::getLatencySeconds()
+{
+    return Oversampler::getLatencySamples (getOversamplingFactor()) / sampleRate;
+}
+
 void AirWindowsPlugin::applyToBuffer (const PluginRenderContext& fc)
 {
     // We need to lock the processing while a preset is being loaded or the parameters
@@ -115,31 +123,39 @@ void AirWindowsPlugin::applyToBuffer (const PluginRenderContext& fc)
     auto dry = dryGain->getCurrentValue();
     auto wet = wetGain->getCurrentValue();
 
-    if (dry <= 0.00004f)
-    {
-        processBlock (asb);
-        zeroDenormalisedValuesIfNeeded (asb);
+    oversampler.setFactor (getOversamplingFactor());
 
-        if (wet < 0.999f)
-            asb.applyGain (0, fc.bufferNumSamples, wet);
-    }
-    else
+    // The dry signal is mixed in at the oversampled rate so it has the same latency as the wet
+    oversampler.process (asb, [this, dry, wet] (juce::AudioBuffer<float>& buffer)
     {
-        auto numChans = asb.getNumChannels();
-        AudioScratchBuffer dryAudio (numChans, fc.bufferNumSamples);
+        const int numSamples = buffer.getNumSamples();
 
-        for (int i = 0; i < numChans; ++i)
-            dryAudio.buffer.copyFrom (i, 0, asb, i, 0, fc.bufferNumSamples);
+        if (dry <= 0.00004f)
+        {
+            processBlock (buffer);
+            zeroDenormalisedValuesIfNeeded (buffer);
 
-        processBlock (asb);
-        zeroDenormalisedValuesIfNeeded (asb);
+            if (wet < 0.999f)
+                buffer.applyGain (0, numSamples, wet);
+        }
+        else
+        {
+            auto numChans = buffer.getNumChannels();
+            AudioScratchBuffer dryAudio (numChans, numSamples);
 
-        if (wet < 0.999f)
-            asb.applyGain (0, fc.bufferNumSamples, wet);
+            for (int i = 0; i < numChans; ++i)
+                dryAudio.buffer.copyFrom (i, 0, buffer, i, 0, numSamples);
 
-        for (int i = 0; i < numChans; ++i)
-            asb.addFrom (i, 0, dryAudio.buffer.getReadPointer (i), fc.bufferNumSamples, dry);
-    }
+            processBlock (buffer);
+            zeroDenormalisedValuesIfNeeded (buffer);
+
+            if (wet < 0.999f)
+                buffer.applyGain (0, numSamples, wet);
+
+            for (int i = 0; i < numChans; ++i)
+                buffer.addFrom (i, 0, dryAudio.buffer.getReadPointer (i), numSamples, dry);
+        }
+    });
 }
 
 void AirWindowsPlugin::processBlock (juce::AudioBuffer<float>& buffer)
@@ -29,6 +29,7 @@ public:
     void initialise (const PluginInitialisationInfo&) override;
     void deinitialise() override;
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                  { return true; }
     juce::String getSelectableDescription() override    { return TRANS("Chorus Plugin"); }
 
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
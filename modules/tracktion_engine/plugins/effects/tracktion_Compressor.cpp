@@ -70,16 +70,25 @@ void CompressorPlugin::getChannelNames (juce::StringArray* ins,
         ins->add (TRANS("Sidechain Trigger"));
 }
 
-void CompressorPlugin::initialise (const PluginInitialisationInfo&)
+void CompressorPlugin::initialise (const PluginInitialisationInfo& info)
 {
     currentLevel = 0.0;
     lastSamp = 0.0f;
+
+    // Includes the sidechain trigger channel
+    oversampler.prepare (Oversampler::Factor::x8, 3, info.blockSizeSamples);
+    oversampler.setFactor (getOversamplingFactor());
 }
 
 void CompressorPlugin::deinitialise()
 {
 }
 
+double CompressorPlugin::getLatencySeconds()
+{
+    return Oversampler::getLatencySamples (getOversamplingFactor()) / sampleRate;
+}
+
 static const float preFilterAmount = 0.9f; // more = smoother level detection
 
 void CompressorPlugin::applyToBuffer (const PluginRenderContext& fc)
@@ -89,23 +98,41 @@ void CompressorPlugin::applyToBuffer (const PluginRenderContext& fc)
 
     SCOPED_REALTIME_CHECK
 
+    juce::AudioBuffer<float> buffer (fc.destBuffer->getArrayOfWritePointers(), std::min (3, fc.destBuffer->getNumChannels()),
+                                     fc.bufferStartSample, fc.bufferNumSamples);
+
+    oversampler.setFactor (getOversamplingFactor());
+    oversampler.process (buffer, [this] (juce::AudioBuffer<float>& b)
+    {
+        applyCompression (b, sampleRate * oversampler.getRatio());
+    });
+
+    clearChannels (*fc.destBuffer, 2, -1, fc.bufferStartSample, fc.bufferNumSamples);
+}
+
+void CompressorPlugin::applyCompression (juce::AudioBuffer<float>& buffer, double rate)
+{
     const double logThreshold = std::log10 (0.01);
-    const double attackFactor = std::pow (10.0, logThreshold / (attackMs.getCurrentValue() * sampleRate / 1000.0));
-    const double releaseFactor = std::pow (10.0, logThreshold / (releaseMs.getCurrentValue() * sampleRate / 1000.0));
+    const double attackFactor = std::pow (10.0, logThreshold / (attackMs.getCurrentValue() * rate / 1000.0));
+    const double releaseFactor = std::pow (10.0, logThreshold / (releaseMs.getCurrentValue() * rate / 1000.0));
     const float outputGain = dbToGain (outputDb.getCurrentValue());
     const float thresh = thresholdGain.getCurrentValue();
     const float rat = ratio.getCurrentValue();
     const bool useSidechain = useSidechainTrigger.get();
     const float sidechainGain = dbToGain (sidechainDb.getCurrentValue());
 
-    float* b1 = fc.destBuffer->getWritePointer (0, fc.bufferStartSample);
+    // Keeps the level detection's time constant the same when oversampled
+    const float preFilter = rate == sampleRate ? preFilterAmount
+                                               : (float) std::pow (preFilterAmount, sampleRate / rate);
 
-    if (fc.destBuffer->getNumChannels() >= 2)
+    float* b1 = buffer.getWritePointer (0);
+
+    if (buffer.getNumChannels() >= 2)
     {
-        float* b2 = fc.destBuffer->getWritePointer (1, fc.bufferStartSample);
-        float* b3 = fc.destBuffer->getNumChannels() > 2 ? fc.destBuffer->getWritePointer (2, fc.bufferStartSample) : nullptr;
+        float* b2 = buffer.getWritePointer (1);
+        float* b3 = buffer.getNumChannels() > 2 ? buffer.getWritePointer (2) : nullptr;
 
-        for (int i = fc.bufferNumSamples; --i >= 0;)
+        for (int i = buffer.getNumSamples(); --i >= 0;)
         {
             float samp1 = *b1 + 1.0f;
             samp1 -= 1.0f;
@@ -116,13 +143,13 @@ void CompressorPlugin::applyToBuffer (const PluginRenderContext& fc)
 
             if (useSidechain && b3 != nullptr)
             {
-                sampAvg = lastSamp * preFilterAmount
-                            + std::abs (*b3++ * sidechainGain) * ((1.0f - preFilterAmount));
+                sampAvg = lastSamp * preFilter
+                            + std::abs (*b3++ * sidechainGain) * ((1.0f - preFilter));
             }
             else
             {
-                sampAvg = lastSamp * preFilterAmount
-                            + std::abs (samp1 + samp2) * ((1.0f - preFilterAmount) * 0.5f);
+                sampAvg = lastSamp * preFilter
+                            + std::abs (samp1 + samp2) * ((1.0f - preFilter) * 0.5f);
             }
 
             JUCE_UNDENORMALISE (sampAvg);
@@ -148,11 +175,11 @@ void CompressorPlugin::applyToBuffer (const PluginRenderContext& fc)
     }
     else
     {
-        for (int i = fc.bufferNumSamples; --i >= 0;)
+        for (int i = buffer.getNumSamples(); --i >= 0;)
         {
             const float samp = *b1;
-            const float sampAvg = lastSamp * preFilterAmount
-                                    + std::abs (samp) * (1.0f - preFilterAmount);
+            const float sampAvg = lastSamp * preFilter
+                                    + std::abs (samp) * (1.0f - preFilter);
             lastSamp = sampAvg;
 
             JUCE_UNDENORMALISE (lastSamp);
@@ -170,8 +197,6 @@ void CompressorPlugin::applyToBuffer (const PluginRenderContext& fc)
             *b1++ = samp * r;
         }
     }
-
-    clearChannels (*fc.destBuffer, 2, -1, fc.bufferStartSample, fc.bufferNumSamples);
 }
 
 float CompressorPlugin::getThreshold() const
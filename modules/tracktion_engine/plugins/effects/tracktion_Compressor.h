@@ -36,6 +36,9 @@ public:
     void initialise (const PluginInitialisationInfo&) override;
     void deinitialise() override;
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                                  { return true; }
+    bool canOversample() override                                       { return true; }
+    double getLatencySeconds() override;
 
     juce::String getSelectableDescription() override                    { return TRANS("Compressor/Limiter Plugin"); }
 
@@ -51,6 +54,9 @@ public:
 private:
     double currentLevel = 0.0;
     float lastSamp = 0.0f;
+    Oversampler oversampler;
+
+    void applyCompression (juce::AudioBuffer<float>&, double rate);
 
     void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
 
@@ -99,6 +99,15 @@ void DelayPlugin::applyToBuffer (const PluginRenderContext& fc)
     zeroDenormalisedValuesIfNeeded (*fc.destBuffer);
 }
 
+double DelayPlugin::getTailLength() const
+{
+    // The time taken for the repeats to drop by 60dB
+    const auto feedback = feedbackDb->getCurrentValue();
+    const auto numRepeats = feedback > getMinDelayFeedbackDb() ? 60.0 / std::max (0.1, (double) -feedback) : 0.0;
+
+    return lengthMs.get() / 1000.0 * (numRepeats + 1.0);
+}
+
 void DelayPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
 {
     copyPropertiesToCachedValues (v, feedbackValue, mixValue, lengthMs);
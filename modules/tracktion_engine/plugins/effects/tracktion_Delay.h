@@ -70,6 +70,8 @@ public:
     void deinitialise() override;
     void reset() override;
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                  { return true; }
+    double getTailLength() const override;
 
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
 
@@ -164,8 +164,6 @@ void EqualiserPlugin::resetToDefault()
     midGain2->setParameter (0.0f, juce::dontSendNotification);
     midFreq2->setParameter (5000.0f, juce::dontSendNotification);
     midQ2   ->setParameter (0.5f, juce::dontSendNotification);
-
-    curveNeedsUpdating = true;
 }
 
 void EqualiserPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
@@ -178,85 +176,107 @@ void EqualiserPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
         p->updateFromAttachedValue();
 }
 
-void EqualiserPlugin::valueTreePropertyChanged (juce::ValueTree& parent, const juce::Identifier& prop)
-{
-    curveNeedsUpdating = true;
-    Plugin::valueTreePropertyChanged (parent, prop);
-}
-
 static float convertEQLevelToGain (double db)
 {
     return (float) pow (10.0, db / 20.0);
 }
 
-void EqualiserPlugin::updateIIRFilters()
+EqualiserPlugin::BandParameters EqualiserPlugin::getBandParameters (int band) const
 {
-    const juce::ScopedLock sl (filterLock);
-
-    if (needToUpdateFilters[0])
+    auto get = [] (const AutomatableParameter::Ptr& freq, const AutomatableParameter::Ptr& q, const AutomatableParameter::Ptr& gain)
     {
-        needToUpdateFilters[0] = false;
+        return BandParameters { freq->getCurrentValue(), q->getCurrentValue(), gain->getCurrentValue() };
+    };
 
-        auto c = juce::IIRCoefficients::makeLowShelf (lastSampleRate, loFreq->getCurrentValue(), loQ->getCurrentValue(),
-                                                      convertEQLevelToGain (loGain->getCurrentValue()));
-
-        for (int i = EQ_CHANS; --i >= 0;)
-            low[i].setCoefficients (c);
+    switch (band)
+    {
+        case 0:     return get (loFreq, loQ, loGain);
+        case 1:     return get (midFreq1, midQ1, midGain1);
+        case 2:     return get (midFreq2, midQ2, midGain2);
+        default:    return get (hiFreq, hiQ, hiGain);
     }
+}
 
-    if (needToUpdateFilters[1])
-    {
-        needToUpdateFilters[1] = false;
+BiquadCoefficients EqualiserPlugin::makeBandCoefficients (int band, double rate, BandParameters params)
+{
+    const auto gain = convertEQLevelToGain (params.gainDb);
 
-        auto c = juce::IIRCoefficients::makePeakFilter (lastSampleRate, midFreq1->getCurrentValue(), midQ1->getCurrentValue(),
-                                                        convertEQLevelToGain (midGain1->getCurrentValue()));
+    if (band == 0)
+        return BiquadCoefficients::fromIIRCoefficients (juce::IIRCoefficients::makeLowShelf (rate, params.freq, params.q, gain));
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            mid1[i].setCoefficients (c);
-    }
+    if (band == numBands - 1)
+        return BiquadCoefficients::fromIIRCoefficients (juce::IIRCoefficients::makeHighShelf (rate, params.freq, params.q, gain));
+
+    return BiquadCoefficients::fromIIRCoefficients (juce::IIRCoefficients::makePeakFilter (rate, params.freq, params.q, gain));
+}
 
-    if (needToUpdateFilters[2])
+void EqualiserPlugin::updateFilterTargets()
+{
+    for (int band = 0; band < numBands; ++band)
     {
-        needToUpdateFilters[2] = false;
+        if (! needToUpdateFilters[band].exchange (false))
+            continue;
 
-        auto c = juce::IIRCoefficients::makePeakFilter (lastSampleRate, midFreq2->getCurrentValue(), midQ2->getCurrentValue(),
-                                                        convertEQLevelToGain (midGain2->getCurrentValue()));
+        const auto params = getBandParameters (band);
+        auto& s = smoothers[(size_t) band];
+        s.freq.setTargetValue (params.freq);
+        s.q.setTargetValue (params.q);
+        s.gainDb.setTargetValue (params.gainDb);
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            mid2[i].setCoefficients (c);
+        coefficientsNeedUpdating[(size_t) band] = true;
     }
+}
 
-    if (needToUpdateFilters[3])
+bool EqualiserPlugin::isSmoothingFilters() const
+{
+    for (auto& s : smoothers)
+        if (s.freq.isSmoothing() || s.q.isSmoothing() || s.gainDb.isSmoothing())
+            return true;
+
+    return false;
+}
+
+void EqualiserPlugin::updateFilterCoefficients (int numSamples)
+{
+    for (size_t band = 0; band < (size_t) numBands; ++band)
     {
-        needToUpdateFilters[3] = false;
+        auto& s = smoothers[band];
+        const bool isSmoothing = s.freq.isSmoothing() || s.q.isSmoothing() || s.gainDb.isSmoothing();
 
-        auto c = juce::IIRCoefficients::makeHighShelf (lastSampleRate, hiFreq->getCurrentValue(), hiQ->getCurrentValue(),
-                                                       convertEQLevelToGain (hiGain->getCurrentValue()));
+        if (! (isSmoothing || coefficientsNeedUpdating[band]))
+            continue;
 
-        for (int i = EQ_CHANS; --i >= 0;)
-            high[i].setCoefficients (c);
+        // Steps to the value at the end of this block so the ramp finishes on the target
+        const BandParameters params { s.freq.skip (numSamples), s.q.skip (numSamples), s.gainDb.skip (numSamples) };
+
+        filters.setCoefficients (band, makeBandCoefficients ((int) band, lastSampleRate, params));
+        filters.setBandEnabled (band, params.gainDb != 0 || s.gainDb.isSmoothing());
+        coefficientsNeedUpdating[band] = false;
     }
 }
 
 void EqualiserPlugin::initialise (const PluginInitialisationInfo&)
 {
-    for (int i = EQ_CHANS; --i >= 0;)
+    lastSampleRate = (float) sampleRate;
+
+    for (int band = 0; band < numBands; ++band)
     {
-        low[i].reset();
-        mid1[i].reset();
-        mid2[i].reset();
-        high[i].reset();
+        const auto params = getBandParameters (band);
+        auto& s = smoothers[(size_t) band];
+
+        s.freq.reset (sampleRate, 0.02);
+        s.q.reset (sampleRate, 0.02);
+        s.gainDb.reset (sampleRate, 0.02);
+        s.freq.setCurrentAndTargetValue (params.freq);
+        s.q.setCurrentAndTargetValue (params.q);
+        s.gainDb.setCurrentAndTargetValue (params.gainDb);
+
+        needToUpdateFilters[band] = false;
+        coefficientsNeedUpdating[(size_t) band] = true;
     }
 
-    if (lastSampleRate != sampleRate)
-        curveNeedsUpdating = true;
-
-    lastSampleRate = (float)sampleRate;
-
-    for (int i = 4; --i >= 0;)
-        needToUpdateFilters[i] = true;
-
-    updateIIRFilters();
+    filters.reset();
+    updateFilterCoefficients (0);
 }
 
 void EqualiserPlugin::deinitialise()
@@ -269,24 +289,29 @@ void EqualiserPlugin::applyToBuffer (const PluginRenderContext& fc)
     {
         SCOPED_REALTIME_CHECK
 
-        const juce::ScopedLock sl (filterLock);
-
-        updateIIRFilters();
-
         jassert (fc.bufferStartSample + fc.bufferNumSamples <= fc.destBuffer->getNumSamples());
 
         clearChannels (*fc.destBuffer, EQ_CHANS, -1, fc.bufferStartSample, fc.bufferNumSamples);
 
         addAntiDenormalisationNoise (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
 
-        for (int i = std::min ((int) EQ_CHANS, fc.destBuffer->getNumChannels()); --i >= 0;)
+        updateFilterTargets();
+
+        const int numChannels = std::min ((int) EQ_CHANS, fc.destBuffer->getNumChannels());
+        float* channels[EQ_CHANS] = {};
+
+        // While any of the parameters are changing, the coefficients are updated in short blocks
+        for (int start = 0; start < fc.bufferNumSamples;)
         {
-            auto data = fc.destBuffer->getWritePointer (i, fc.bufferStartSample);
+            const int numThisTime = isSmoothingFilters() ? std::min (numSamplesPerUpdate, fc.bufferNumSamples - start)
+                                                         : fc.bufferNumSamples - start;
+            updateFilterCoefficients (numThisTime);
+
+            for (int i = 0; i < numChannels; ++i)
+                channels[i] = fc.destBuffer->getWritePointer (i, fc.bufferStartSample + start);
 
-            if (loGain->getCurrentValue() != 0)       low[i] .processSamples (data, fc.bufferNumSamples);
-            if (midGain1->getCurrentValue() != 0)     mid1[i].processSamples (data, fc.bufferNumSamples);
-            if (midGain2->getCurrentValue() != 0)     mid2[i].processSamples (data, fc.bufferNumSamples);
-            if (hiGain->getCurrentValue() != 0)       high[i].processSamples (data, fc.bufferNumSamples);
+            filters.process (channels, numChannels, numThisTime);
+            start += numThisTime;
         }
 
         if (phaseInvert)
@@ -296,46 +321,27 @@ void EqualiserPlugin::applyToBuffer (const PluginRenderContext& fc)
 
 float EqualiserPlugin::getDBGainAtFrequency (float f)
 {
-    if (curveNeedsUpdating)
-    {
-        updateIIRFilters();
-
-        curve.clear();
-
-        if (loGain->getCurrentValue() == 0 && midGain1->getCurrentValue() == 0
-             && midGain2->getCurrentValue() == 0 && hiGain->getCurrentValue() == 0)
-            return 0.0f;
+    const auto rate = (double) lastSampleRate;
+    double magnitude = 1.0;
 
-        const int sampSize = (1 << fftOrder);
-
-        float samps[sampSize * 2 + 8] = {};
-        samps[0] = 1.0f;
-
-        if (loGain->getCurrentValue() != 0)     juce::IIRFilter (low[0]) .processSamples (samps, sampSize);
-        if (midGain1->getCurrentValue() != 0)   juce::IIRFilter (mid1[0]).processSamples (samps, sampSize);
-        if (midGain2->getCurrentValue() != 0)   juce::IIRFilter (mid2[0]).processSamples (samps, sampSize);
-        if (hiGain->getCurrentValue() != 0)     juce::IIRFilter (high[0]).processSamples (samps, sampSize);
-
-        fft.performRealOnlyForwardTransform (samps);
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto params = getBandParameters (band);
+        auto& coefficients = curveCoefficients[(size_t) band];
 
-        for (int i = 0; i < sampSize / 2;)
+        if (params != curveParameters[(size_t) band] || rate != curveSampleRate)
         {
-            curve.addPoint (i / (float)(sampSize / 2),
-                            gainToDb (juce::jlimit (0.01f, 10.0f, samps[i * 2])));
-
-            if (i < sampSize / 8)
-                ++i;
-            else if (i < sampSize / 4)
-                i += 3;
-            else
-                i += 6;
+            curveParameters[(size_t) band] = params;
+            coefficients = makeBandCoefficients (band, rate, params);
         }
 
-        curveNeedsUpdating = false;
-        yieldGUIThread();
+        if (params.gainDb != 0)
+            magnitude *= coefficients.getMagnitudeForFrequency (f, rate);
     }
 
-    return curve.getY (f / (lastSampleRate / 2));
+    curveSampleRate = rate;
+
+    return gainToDb (juce::jlimit (0.01f, 10.0f, (float) magnitude));
 }
 
 }} // namespace tracktion { inline namespace engine
@@ -18,7 +18,10 @@ public:
     ~EqualiserPlugin() override;
 
     //==============================================================================
-    /** Finds the gain at a frequency - used to plot the EQ graph. */
+    /** Finds the gain at a frequency - used to plot the EQ graph.
+        This is calculated from the filter coefficients, which are cached until the
+        parameters change, so should only be called from the message thread.
+    */
     float getDBGainAtFrequency (float f);
 
     //==============================================================================
@@ -37,6 +40,7 @@ public:
     void initialise (const PluginInitialisationInfo&) override;
     void deinitialise() override;
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override              { return true; }
 
     void resetToDefault();
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
@@ -76,21 +80,40 @@ public:
 private:
     class EQAutomatableParameter;
 
-    Spline curve;
-    float lastSampleRate = 44100.0f;
-    bool curveNeedsUpdating = true;
+    struct BandParameters
+    {
+        float freq = 0.0f, q = 0.0f, gainDb = 0.0f;
+
+        bool operator== (const BandParameters&) const = default;
+    };
 
-    enum { EQ_CHANS = 2 };
-    juce::IIRFilter low[EQ_CHANS], mid1[EQ_CHANS], mid2[EQ_CHANS], high[EQ_CHANS];
+    struct BandSmoothers
+    {
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> freq;
+        juce::SmoothedValue<float> q, gainDb;
+    };
 
-    enum { fftOrder = 10 };
-    juce::dsp::FFT fft { fftOrder };
+    enum { EQ_CHANS = 2, numBands = 4 };
+    static constexpr int numSamplesPerUpdate = 32;
 
-    void updateIIRFilters();
-    std::atomic<bool> needToUpdateFilters[4];
-    juce::CriticalSection filterLock;
+    float lastSampleRate = 44100.0f;
 
-    void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
+    // Only used on the audio thread
+    BiquadCascade<numBands> filters;
+    std::array<BandSmoothers, numBands> smoothers;
+    std::array<bool, numBands> coefficientsNeedUpdating {};
+    std::atomic<bool> needToUpdateFilters[numBands];
+
+    // Only used on the message thread, for the response curve
+    std::array<BandParameters, numBands> curveParameters;
+    std::array<BiquadCoefficients, numBands> curveCoefficients;
+    double curveSampleRate = 0.0;
+
+    BandParameters getBandParameters (int band) const;
+    static BiquadCoefficients makeBandCoefficients (int band, double sampleRate, BandParameters);
+    void updateFilterTargets();
+    bool isSmoothingFilters() const;
+    void updateFilterCoefficients (int numSamples);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EqualiserPlugin)
 };
@@ -415,7 +415,7 @@ public:
         if (numSamples > renderBuffer.getNumSamples())
             renderBuffer.setSize (2, numSamples, false, false, true);
 
-        renderBuffer.clear();
+        renderBuffer.clear (0, numSamples);
 
         // Run oscillators
         for (auto& o : oscillators)
@@ -424,7 +424,7 @@ public:
         // Apply velocity
         float velocityGain = velocityToGain (currentlyPlayingNote.noteOnVelocity.asUnsignedFloat(), paramValue (synth.ampVelocity) / 100.0f);
         velocityGain = juce::jlimit (0.0f, 1.0f, velocityGain);
-        renderBuffer.applyGain (velocityGain);
+        renderBuffer.applyGain (0, numSamples, velocityGain);
 
         // Apply filter
         if (synth.filterTypeValue != 0)
@@ -519,14 +519,12 @@ public:
         for (int i = 0; i <= 127; i++)
             currentModValue[FourOscPlugin::ccBankSelect + i] = synth.controllerValues[i];
 
-        // Flush the LFOs and envelopes
+        // Flush the LFOs and envelopes. Modulation only runs at the block rate
+        // so the envelopes can skip ahead rather than generating every sample
         lfo1.process (numSamples);
         lfo2.process (numSamples);
-        for (int i = 0; i < numSamples; i++)
-        {
-            modAdsr1.getNextSample();
-            modAdsr2.getNextSample();
-        }
+        modAdsr1.skip (numSamples);
+        modAdsr2.skip (numSamples);
 
         // Mod
         modAdsr1.setParameters ({
@@ -598,8 +596,7 @@ public:
         filterSens = currentlyPlayingNote.noteOnVelocity.asUnsignedFloat() * filterSens + 1.0f - filterSens;
         filterEnv *= filterSens;
 
-        for (int i = 0; i < numSamples; i++)
-            filterAdsr.getNextSample();
+        filterAdsr.skip (numSamples);
 
         auto getMidiNoteInHertz = [](float noteNumber)
         {
@@ -981,6 +978,11 @@ FourOscPlugin::FourOscPlugin (PluginCreationInfo info)  : Plugin (info)
     reverbDampingValue.referTo (state, IDs::reverbDamping, um, 0.0f);
     reverbWidthValue.referTo (state, IDs::reverbWidth, um, 0.0f);
     reverbMixValue.referTo (state, IDs::reverbMix, um, 0.0);
+    reverbAlgorithmValue.referTo (state, IDs::reverbAlgorithm, um, (int) ReverbAlgorithm::classic);
+
+    // Older Edits keep the classic reverb so they sound the same
+    if (info.isNewPlugin)
+        reverbAlgorithmValue.setValue ((int) ReverbAlgorithm::feedbackDelayNetwork, nullptr);
 
     reverbSize      = addParam ("reverbSize",     TRANS("Size"),    {0.0f, 1.0f});
     reverbDamping   = addParam ("reverbDamping",  TRANS("Damping"), {0.0f, 1.0f});
@@ -1428,12 +1430,17 @@ void FourOscPlugin::initialise (const PluginInitialisationInfo& info)
     setCurrentPlaybackSampleRate (info.sampleRate);
 
     reverb.setSampleRate (info.sampleRate);
+    fdnReverb.setSampleRate (info.sampleRate);
     delay->setSampleRate (info.sampleRate);
     chorus->setSampleRate (info.sampleRate);
 
     reverb.reset();
+    fdnReverb.reset();
+    currentReverbAlgorithm = getReverbAlgorithm();
     delay->reset();
     chorus->reset();
+    distortionOversampler.prepare (Oversampler::Factor::x8, 2, info.blockSizeSamples);
+    distortionOversampler.setFactor (getOversamplingFactor());
 
     for (auto& itr : smoothers)
         itr.second.reset (info.sampleRate, 0.01f);
@@ -1443,6 +1450,11 @@ void FourOscPlugin::deinitialise()
 {
 }
 
+double FourOscPlugin::getLatencySeconds()
+{
+    return Oversampler::getLatencySamples (getOversamplingFactor()) / sampleRate;
+}
+
 //==============================================================================
 void FourOscPlugin::reset()
 {
@@ -1531,13 +1543,16 @@ void FourOscPlugin::applyEffects (juce::AudioBuffer<float>& buffer)
     int numSamples = buffer.getNumSamples();
 
     // Apply Distortion
-    if (distortionOnValue)
+    // This always goes through the oversampler, even when off, to keep the latency constant
+    const float drive = distortionOnValue ? paramValue (distortion) : 0.0f;
+
+    distortionOversampler.setFactor (getOversamplingFactor());
+    distortionOversampler.process (buffer, [drive] (juce::AudioBuffer<float>& b)
     {
-        float drive = paramValue (distortion);
         float clip = 1.0f / (2.0f * drive);
-        Distortion::distortion (buffer.getWritePointer (0), numSamples, drive, -clip, clip);
-        Distortion::distortion (buffer.getWritePointer (1), numSamples, drive, -clip, clip);
-    }
+        Distortion::distortion (b.getWritePointer (0), b.getNumSamples(), drive, -clip, clip);
+        Distortion::distortion (b.getWritePointer (1), b.getNumSamples(), drive, -clip, clip);
+    });
 
     // Apply Chorus
     if (chorusOnValue)
@@ -1549,7 +1564,12 @@ void FourOscPlugin::applyEffects (juce::AudioBuffer<float>& buffer)
 
     // Apply Reverb
     if (reverbOnValue)
-        reverb.processStereo (buffer.getWritePointer (0), buffer.getWritePointer (1), numSamples);
+    {
+        if (currentReverbAlgorithm == ReverbAlgorithm::feedbackDelayNetwork)
+            fdnReverb.processStereo (buffer.getWritePointer (0), buffer.getWritePointer (1), numSamples);
+        else
+            reverb.processStereo (buffer.getWritePointer (0), buffer.getWritePointer (1), numSamples);
+    }
 
     // Apply master level
     buffer.applyGain (juce::Decibels::decibelsToGain (paramValue (masterLevel)));
@@ -1562,15 +1582,41 @@ void FourOscPlugin::updateParams (juce::AudioBuffer<float>& buffer)
     // Reverb
     AudioFadeCurve::CrossfadeLevels wetDry (paramValue (reverbMix));
 
-    juce::Reverb::Parameters params;
-    params.roomSize = paramValue (reverbSize);
-    params.damping = paramValue (reverbDamping);
-    params.width = paramValue (reverbWidth);
-    params.wetLevel = wetDry.gain1;
-    params.dryLevel = wetDry.gain2;
-    params.freezeMode = 0;
+    if (auto algorithm = getReverbAlgorithm(); algorithm != currentReverbAlgorithm)
+    {
+        if (algorithm == ReverbAlgorithm::feedbackDelayNetwork)
+            fdnReverb.reset();
+        else
+            reverb.reset();
 
-    reverb.setParameters (params);
+        currentReverbAlgorithm = algorithm;
+    }
+
+    if (currentReverbAlgorithm == ReverbAlgorithm::feedbackDelayNetwork)
+    {
+        FDNReverb::Parameters params;
+        params.roomSize = paramValue (reverbSize);
+        params.damping = paramValue (reverbDamping);
+        params.width = paramValue (reverbWidth);
+        params.wetLevel = wetDry.gain1;
+        params.dryLevel = wetDry.gain2;
+        params.freezeMode = 0;
+
+        if (params != fdnReverb.getParameters())
+            fdnReverb.setParameters (params);
+    }
+    else
+    {
+        juce::Reverb::Parameters params;
+        params.roomSize = paramValue (reverbSize);
+        params.damping = paramValue (reverbDamping);
+        params.width = paramValue (reverbWidth);
+        params.wetLevel = wetDry.gain1;
+        params.dryLevel = wetDry.gain2;
+        params.freezeMode = 0;
+
+        reverb.setParameters (params);
+    }
 
     // Delay
     float delayTime = (delayValue.get()) / (currentTempo / 60.0f);
@@ -1592,9 +1638,9 @@ void FourOscPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
     copyPropertiesToCachedValues (v, ampAttackValue, ampDecayValue, ampSustainValue, ampReleaseValue, ampVelocityValue, filterAttackValue,
                                   filterDecayValue, filterSustainValue, filterReleaseValue, filterFreqValue, filterResonanceValue,
                                   filterAmountValue, filterKeyValue, filterVelocityValue, distortionValue, reverbSizeValue,
-                                  reverbDampingValue, reverbWidthValue, reverbMixValue, delayValue, delayFeedbackValue, delayCrossfeedValue,
-                                  delayMixValue, chorusSpeedValue, chorusDepthValue, chorusWidthValue, chorusMixValue, legatoValue,
-                                  masterLevelValue, voiceModeValue, voicesValue, filterTypeValue, filterSlopeValue,
+                                  reverbDampingValue, reverbWidthValue, reverbMixValue, reverbAlgorithmValue, delayValue, delayFeedbackValue,
+                                  delayCrossfeedValue, delayMixValue, chorusSpeedValue, chorusDepthValue, chorusWidthValue, chorusMixValue,
+                                  legatoValue, masterLevelValue, voiceModeValue, voicesValue, filterTypeValue, filterSlopeValue,
                                   ampAnalogValue, distortionOnValue, reverbOnValue, delayOnValue, chorusOnValue);
 
     auto um = getUndoManager();
@@ -1805,4 +1851,38 @@ float FourOscPlugin::paramValue (AutomatableParameter::Ptr param)
     return param->valueRange.convertFrom0to1 (smoothItr->second.getCurrentValue());
 }
 
+double FourOscPlugin::getTailLength() const
+{
+    // The release of the last voice goes through the delay and then the reverb
+    double tail = ampRelease->getCurrentValue();
+
+    if (delayOnValue.get() && delayMix->getCurrentValue() > 0.0f)
+    {
+        // Each repeat is fed back to both sides so it decays by the sum of the
+        // clamped feedback and crossfeed gains
+        const auto loopGain = std::min (0.99, (double) juce::Decibels::decibelsToGain (delayFeedback->getCurrentValue()))
+                                + std::min (0.99, (double) juce::Decibels::decibelsToGain (delayCrossfeed->getCurrentValue()));
+
+        if (loopGain >= 1.0)
+            return std::numeric_limits<double>::infinity();
+
+        const auto tempo = currentTempo > 0.0f ? (double) currentTempo : edit.tempoSequence.getBpmAt (TimePosition());
+        const auto delaySeconds = delayValue.get() / (tempo / 60.0);
+        const auto numRepeats = loopGain > 0.0 ? std::log (0.001) / std::log (loopGain) : 0.0;
+
+        tail += delaySeconds * (numRepeats + 1.0);
+    }
+
+    if (reverbOnValue.get() && reverbMix->getCurrentValue() > 0.0f)
+        tail += ReverbPlugin::getDecayTimeSeconds (getReverbAlgorithm(), reverbSize->getCurrentValue());
+
+    return tail;
+}
+
+ReverbAlgorithm FourOscPlugin::getReverbAlgorithm() const
+{
+    return reverbAlgorithmValue.get() == (int) ReverbAlgorithm::feedbackDelayNetwork ? ReverbAlgorithm::feedbackDelayNetwork
+                                                                                     : ReverbAlgorithm::classic;
+}
+
 }} // namespace tracktion { inline namespace engine
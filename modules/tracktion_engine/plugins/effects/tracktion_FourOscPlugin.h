@@ -194,7 +194,10 @@ public:
     bool takesAudioInput() override                     { return false; }
     bool isSynth() override                             { return true; }
     bool producesAudioWhenNoAudioInput() override       { return true; }
-    double getTailLength() const override               { return ampRelease->getCurrentValue(); }
+    double getTailLength() const override;
+    bool canSleepWhenSilent() override                  { return true; }
+    bool canOversample() override                       { return true; }
+    double getLatencySeconds() override;
 
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
 
@@ -281,6 +284,7 @@ public:
     AutomatableParameter::Ptr distortion;
 
     juce::CachedValue<float> reverbSizeValue, reverbDampingValue, reverbWidthValue, reverbMixValue;
+    juce::CachedValue<int> reverbAlgorithmValue;
     AutomatableParameter::Ptr reverbSize, reverbDamping, reverbWidth, reverbMix;
 
     juce::CachedValue<float> delayValue, delayFeedbackValue, delayCrossfeedValue, delayMixValue;
@@ -376,9 +380,13 @@ private:
     void updateParams (juce::AudioBuffer<float>& buffer);
     void applyEffects (juce::AudioBuffer<float>& buffer);
     float paramValue (AutomatableParameter::Ptr param);
+    ReverbAlgorithm getReverbAlgorithm() const;
 
     tempo::Sequence::Position currentPos { createPosition (edit.tempoSequence) };
     juce::Reverb reverb;
+    FDNReverb fdnReverb;
+    ReverbAlgorithm currentReverbAlgorithm = ReverbAlgorithm::classic;
+    Oversampler distortionOversampler;
     std::unique_ptr<FODelay> delay;
     std::unique_ptr<FOChorus> chorus;
     std::unordered_map<AutomatableParameter*, ValueSmoother<float>> smoothers;
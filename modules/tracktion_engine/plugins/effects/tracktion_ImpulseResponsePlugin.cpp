@@ -12,6 +12,90 @@
 namespace tracktion { inline namespace engine
 {
 
+namespace impulse_response_helpers
+{
+    /** Resamples an IR, scaling it so the overall gain stays the same. */
+    inline juce::AudioBuffer<float> resample (const juce::AudioBuffer<float>& source, double sourceSampleRate, double destSampleRate)
+    {
+        if (sourceSampleRate == destSampleRate)
+            return source;
+
+        const auto ratio = sourceSampleRate / destSampleRate;
+        const int numDestSamples = (int) std::ceil (source.getNumSamples() / ratio);
+
+        // Pad the source so the interpolator can read past the end
+        juce::AudioBuffer<float> padded (source.getNumChannels(), source.getNumSamples() + 8);
+        padded.clear();
+
+        juce::AudioBuffer<float> dest (source.getNumChannels(), numDestSamples);
+
+        for (int chan = 0; chan < source.getNumChannels(); ++chan)
+        {
+            padded.copyFrom (chan, 0, source, chan, 0, source.getNumSamples());
+
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process (ratio, padded.getReadPointer (chan), dest.getWritePointer (chan), numDestSamples);
+        }
+
+        dest.applyGain ((float) ratio);
+        return dest;
+    }
+
+    /** Removes any silence from the start and end of an IR. */
+    inline void trimSilence (juce::AudioBuffer<float>& buffer)
+    {
+        const auto threshold = juce::Decibels::decibelsToGain (-80.0f);
+        int start = buffer.getNumSamples(), end = 0;
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+        {
+            auto data = buffer.getReadPointer (chan);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                if (std::abs (data[i]) >= threshold)
+                {
+                    start = std::min (start, i);
+                    end = std::max (end, i + 1);
+                }
+            }
+        }
+
+        if (start >= end)
+        {
+            buffer.setSize (buffer.getNumChannels(), 0);
+            return;
+        }
+
+        juce::AudioBuffer<float> trimmed (buffer.getNumChannels(), end - start);
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            trimmed.copyFrom (chan, 0, buffer, chan, start, end - start);
+
+        buffer = std::move (trimmed);
+    }
+
+    /** Scales an IR to the same level juce::dsp::Convolution normalises to. */
+    inline void normalise (juce::AudioBuffer<float>& buffer)
+    {
+        float maxSumOfSquares = 0.0f;
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+        {
+            auto data = buffer.getReadPointer (chan);
+            float sumOfSquares = 0.0f;
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                sumOfSquares += data[i] * data[i];
+
+            maxSumOfSquares = std::max (maxSumOfSquares, sumOfSquares);
+        }
+
+        if (maxSumOfSquares > 0.0f)
+            buffer.applyGain (0.125f / std::sqrt (maxSumOfSquares));
+    }
+}
+
 //==============================================================================
 ImpulseResponsePlugin::ImpulseResponsePlugin (PluginCreationInfo info)
     : Plugin (info)
@@ -60,11 +144,13 @@ ImpulseResponsePlugin::ImpulseResponsePlugin (PluginCreationInfo info)
                              [] (const juce::String& s)   { return s.getFloatValue(); });
     filterQParam->attachToCurrentValue (qValue);
 
+    convolverLoader = std::make_shared<ConvolverLoader> (*this);
     loadImpulseResponseFromState();
 }
 
 ImpulseResponsePlugin::~ImpulseResponsePlugin()
 {
+    convolverLoader->detach();
     notifyListenersOfDeletion();
     gainParam->detachFromCurrentValue();
     highPassCutoffParam->detachFromCurrentValue();
@@ -136,7 +222,13 @@ juce::String ImpulseResponsePlugin::getSelectableDescription()  { return getName
 
 double ImpulseResponsePlugin::getLatencySeconds()
 {
-    return processorChain.get<convolutionIndex>().getLatency() / sampleRate;
+    // The head of the IR is convolved directly so there's no latency
+    return 0.0;
+}
+
+double ImpulseResponsePlugin::getTailLength() const
+{
+    return tailLengthSeconds.load (std::memory_order_relaxed);
 }
 
 void ImpulseResponsePlugin::initialise (const PluginInitialisationInfo& info)
@@ -147,6 +239,12 @@ void ImpulseResponsePlugin::initialise (const PluginInitialisationInfo& info)
     processSpec.numChannels = 2;
     processorChain.prepare (processSpec);
 
+    if (info.sampleRate != convolverSampleRate)
+    {
+        convolverSampleRate = info.sampleRate;
+        convolverLoader->setSampleRate (convolverSampleRate, edit.isRendering());
+    }
+
     // Update smoothers
     lowFreqSmoother.setTargetValue (midiNoteToFrequency (lowPassCutoffParam->getCurrentValue()));
     highFreqSmoother.setTargetValue (midiNoteToFrequency (highPassCutoffParam->getCurrentValue()));
@@ -172,6 +270,7 @@ void ImpulseResponsePlugin::deinitialise()
 void ImpulseResponsePlugin::reset()
 {
     processorChain.reset();
+    resetPending = true;
 }
 
 void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
@@ -193,6 +292,8 @@ void ImpulseResponsePlugin::applyToBuffer (const PluginRenderContext& fc)
 
     AudioScratchBuffer dryBuffer (*fc.destBuffer);
 
+    applyConvolution (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
+
     if (gainSmoother.isSmoothing() || lowFreqSmoother.isSmoothing() || highFreqSmoother.isSmoothing() || qSmoother.isSmoothing())
     {
         const int blockSize = 32;
@@ -264,28 +365,241 @@ void ImpulseResponsePlugin::restorePluginStateFromValueTree (const juce::ValueTr
 }
 
 //==============================================================================
-void ImpulseResponsePlugin::loadImpulseResponseFromState()
+/** Decodes, resamples and partitions the IR on a background thread then hands the
+    convolver to the audio thread, which crossfades to it.
+    Requests made whilst a build is running are coalesced so only the latest is used.
+*/
+struct ImpulseResponsePlugin::ConvolverLoader  : public std::enable_shared_from_this<ConvolverLoader>
 {
-    if (auto irFileData = state.getProperty (IDs::irFileData).getBinaryData())
+    ConvolverLoader (ImpulseResponsePlugin& p)
+        : engine (p.engine), owner (&p)
+    {}
+
+    /** Called by the plugin's destructor so nothing is handed to it after it's gone. */
+    void detach()
     {
-        auto is = std::make_unique<juce::MemoryInputStream> (*irFileData, false);
+        const std::scoped_lock sl (lock);
+        owner = nullptr;
+    }
+
+    void setImpulseResponse (std::shared_ptr<const juce::MemoryBlock> irFileData, bool shouldTrim, bool shouldNormalise)
+    {
+        update ([&] (Request& r)
+                {
+                    r.irFileData = std::move (irFileData);
+                    r.trimSilence = shouldTrim;
+                    r.normalise = shouldNormalise;
+                }, false);
+    }
+
+    /** Set synchronously when rendering so the convolver is ready before the first block. */
+    void setSampleRate (double newSampleRate, bool synchronously)
+    {
+        update ([&] (Request& r) { r.sampleRate = newSampleRate; }, synchronously);
+    }
+
+    bool isLoading() const
+    {
+        const std::scoped_lock sl (lock);
+        return isRunning;
+    }
+
+private:
+    struct Request
+    {
+        std::shared_ptr<const juce::MemoryBlock> irFileData;
+        double sampleRate = 0.0;
+        bool trimSilence = false, normalise = true;
+    };
+
+    Engine& engine;
+    mutable std::mutex lock;
+    ImpulseResponsePlugin* owner = nullptr;
+    Request latest;
+    int generation = 0, loadedGeneration = 0;
+    bool isRunning = false;
+
+    template<typename ChangeFn>
+    void update (ChangeFn&& change, bool synchronously)
+    {
+        bool shouldStart = false;
 
-        if (auto reader = std::unique_ptr<juce::AudioFormatReader> (juce::FlacAudioFormat()
-                                                                        .createReaderFor (is.release(), true)))
         {
-            juce::AudioBuffer<float> loadIRBuffer ((int) reader->numChannels, (int) reader->lengthInSamples);
-            reader->read (&loadIRBuffer, 0, (int) reader->lengthInSamples, 0, true, true);
-
-            jassert (reader->numChannels > 0);
-            processorChain.get<convolutionIndex>().loadImpulseResponse (std::move (loadIRBuffer),
-                                                                        reader->sampleRate,
-                                                                        reader->numChannels > 1 ? juce::dsp::Convolution::Stereo::yes
-                                                                                                : juce::dsp::Convolution::Stereo::no,
-                                                                        trimSilence.get() ? juce::dsp::Convolution::Trim::yes
-                                                                                          : juce::dsp::Convolution::Trim::no,
-                                                                        normalise.get() ? juce::dsp::Convolution::Normalise::yes
-                                                                                        : juce::dsp::Convolution::Normalise::no);
+            const std::scoped_lock sl (lock);
+            change (latest);
+            ++generation;
+
+            shouldStart = ! isRunning;
+            isRunning = true;
         }
+
+        if (! shouldStart)
+        {
+            if (synchronously)
+                while (isLoading())
+                    juce::Thread::sleep (1);
+        }
+        else if (synchronously)
+        {
+            run();
+        }
+        else
+        {
+            engine.getBackgroundJobs().getPool().addJob ([self = shared_from_this()] { self->run(); });
+        }
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            Request request;
+            int requestGeneration = 0;
+
+            {
+                const std::scoped_lock sl (lock);
+
+                if (owner == nullptr || loadedGeneration == generation)
+                {
+                    isRunning = false;
+                    return;
+                }
+
+                request = latest;
+                requestGeneration = generation;
+            }
+
+            double tailLength = 0.0;
+            auto newConvolver = build (request, tailLength);
+
+            const std::scoped_lock sl (lock);
+
+            // If the IR or sample rate changed whilst building, build again
+            if (owner != nullptr && requestGeneration == generation)
+            {
+                owner->tailLengthSeconds.store (tailLength, std::memory_order_relaxed);
+
+                if (newConvolver != nullptr)
+                    owner->convolver.pushNonRealTime (std::move (newConvolver));
+            }
+
+            loadedGeneration = requestGeneration;
+        }
+    }
+
+    std::unique_ptr<PartitionedConvolver> build (const Request& request, double& tailLength)
+    {
+        if (request.irFileData == nullptr)
+            return {};
+
+        auto& store = engine.getSharedAudioDataStore();
+        const auto& irFileData = *request.irFileData;
+        const auto irDataKey = SharedAudioDataStore::createKey (irFileData.getData(), irFileData.getSize());
+
+        auto decoded = store.getOrCreate<DecodedImpulseResponse> (irDataKey, [&]
+        {
+            DecodedImpulseResponse result;
+            auto is = std::make_unique<juce::MemoryInputStream> (irFileData, false);
+
+            if (auto reader = std::unique_ptr<juce::AudioFormatReader> (juce::FlacAudioFormat()
+                                                                            .createReaderFor (is.release(), true)))
+            {
+                jassert (reader->numChannels > 0);
+
+                // Only the first two channels are used
+                result.buffer.setSize (std::min (2, (int) reader->numChannels), (int) reader->lengthInSamples);
+                reader->read (&result.buffer, 0, (int) reader->lengthInSamples, 0, true, true);
+                result.sampleRate = reader->sampleRate;
+            }
+
+            return result;
+        });
+
+        if (decoded == nullptr || decoded->buffer.getNumSamples() == 0 || decoded->sampleRate <= 0.0)
+            return {};
+
+        tailLength = decoded->buffer.getNumSamples() / decoded->sampleRate;
+
+        if (request.sampleRate <= 0.0)
+            return {};
+
+        // Instances using the same file with the same settings share the transformed IR
+        auto key = irDataKey;
+        key.add (request.sampleRate).add (request.trimSilence).add (request.normalise);
+
+        auto createImpulseResponse = [&]
+        {
+            auto buffer = impulse_response_helpers::resample (decoded->buffer, decoded->sampleRate, request.sampleRate);
+
+            if (request.trimSilence)
+                impulse_response_helpers::trimSilence (buffer);
+
+            if (request.normalise)
+                impulse_response_helpers::normalise (buffer);
+
+            return buffer;
+        };
+
+        auto ir = PartitionedConvolver::getSharedImpulseResponse (store, std::move (key), createImpulseResponse, {});
+        return std::make_unique<PartitionedConvolver> (std::move (ir), 2);
+    }
+};
+
+//==============================================================================
+void ImpulseResponsePlugin::loadImpulseResponseFromState()
+{
+    if (auto irFileData = state.getProperty (IDs::irFileData).getBinaryData())
+        convolverLoader->setImpulseResponse (std::make_shared<const juce::MemoryBlock> (*irFileData),
+                                             trimSilence.get(), normalise.get());
+}
+
+bool ImpulseResponsePlugin::isLoadingImpulseResponse() const
+{
+    return convolverLoader->isLoading();
+}
+
+void ImpulseResponsePlugin::applyConvolution (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    auto access = convolver.getScopedAccess();
+    auto current = access.get() != nullptr ? access.get()->get() : nullptr;
+
+    if (current == nullptr)
+        return;
+
+    if (resetPending.exchange (false))
+        current->reset();
+
+    const int numChannels = std::min (2, buffer.getNumChannels());
+    float* channels[2] = {};
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        channels[chan] = buffer.getWritePointer (chan, startSample);
+
+    if (current == lastConvolverUsed)
+    {
+        current->process (channels, numChannels, numSamples);
+        return;
+    }
+
+    // A new IR has just been swapped in. The previous convolver is still held
+    // by the LockFreeObject until the next push so fade from it over this block.
+    auto previous = lastConvolverUsed;
+    lastConvolverUsed = current;
+
+    AudioScratchBuffer fadeOut (numChannels, numSamples);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        fadeOut.buffer.copyFrom (chan, 0, buffer, chan, startSample, numSamples);
+
+    if (previous != nullptr)
+        previous->process (fadeOut.buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+    current->process (channels, numChannels, numSamples);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        buffer.applyGainRamp (chan, startSample, numSamples, 0.0f, 1.0f);
+        buffer.addFromWithRamp (chan, startSample, fadeOut.buffer.getReadPointer (chan), numSamples, 1.0f, 0.0f);
     }
 }
 
@@ -34,22 +34,25 @@ public:
 
     //==============================================================================
     /** Loads an impulse from binary audio file data i.e. not a block of raw floats.
-        @see juce::Convolution::loadImpulseResponse
+        The IR is convolved with a PartitionedConvolver so doesn't add any latency.
+        Other instances using the same IR file at the same settings will share
+        the transformed IR data.
     */
     bool loadImpulseResponse (const void* sourceData, size_t sourceDataSize);
 
-    /** Loads an impulse from a file.
-        @see juce::Convolution::loadImpulseResponse
-    */
+    /** Loads an impulse from a file. */
     bool loadImpulseResponse (const juce::File& fileImpulseResponse);
 
-    /** Loads an impulse from an AudioBuffer<float>.
-        @see juce::Convolution::loadImpulseResponse
-    */
+    /** Loads an impulse from an AudioBuffer<float>. */
     bool loadImpulseResponse (juce::AudioBuffer<float>&& bufferImpulseResponse,
                               double sampleRateToStore,
                               int bitDepthToStore);
 
+    /** Returns true whilst a new IR is being prepared on a background thread.
+        Until it's ready, the previous one carries on being used.
+    */
+    bool isLoadingImpulseResponse() const;
+
     //==============================================================================
     juce::CachedValue<juce::String> name;           /**< A name property. This isn't used by the IR itselt but useful in UI contexts. */
     juce::CachedValue<bool> normalise;              /**< Normalise the IR file when loading from the state. True by default. */
@@ -74,6 +77,10 @@ public:
     /** @internal */
     double getLatencySeconds() override;
     /** @internal */
+    double getTailLength() const override;
+    /** @internal */
+    bool canSleepWhenSilent() override                  { return true; }
+    /** @internal */
     void initialise (const PluginInitialisationInfo&) override;
     /** @internal */
     void deinitialise() override;
@@ -88,7 +95,6 @@ private:
     //==============================================================================
     enum
     {
-        convolutionIndex,
         HPFIndex,
         LPFIndex,
         gainIndex,
@@ -98,10 +104,29 @@ private:
     juce::CachedValue<float> highPassCutoffValue, lowPassCutoffValue;
     juce::CachedValue<float> qValue;
 
-    juce::dsp::ProcessorChain<juce::dsp::Convolution,
-                              juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>,
+    juce::dsp::ProcessorChain<juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>,
                               juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>,
                               juce::dsp::Gain<float>> processorChain;
+
+    // The decoded IR and the convolver created from it for the current sample rate.
+    // These are shared with any other instances using the same IR file.
+    struct DecodedImpulseResponse
+    {
+        juce::AudioBuffer<float> buffer;
+        double sampleRate = 0.0;
+
+        size_t getMemoryUsage() const   { return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (float); }
+    };
+
+    struct ConvolverLoader;
+    std::shared_ptr<ConvolverLoader> convolverLoader;
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    double convolverSampleRate = 0.0;
+
+    LockFreeObject<std::unique_ptr<PartitionedConvolver>> convolver;
+    PartitionedConvolver* lastConvolverUsed = nullptr;
+    std::atomic<bool> resetPending { false };
+
     juce::SmoothedValue<float> highFreqSmoother, lowFreqSmoother, gainSmoother, wetGainSmoother, dryGainSmoother, qSmoother;
 
     struct WetDryGain { float wet, dry; };
@@ -114,6 +139,7 @@ private:
         return { wet, dry };
     }
     void loadImpulseResponseFromState();
+    void applyConvolution (juce::AudioBuffer<float>&, int startSample, int numSamples);
 
     void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
 
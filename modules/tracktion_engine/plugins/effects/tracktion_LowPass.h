@@ -31,6 +31,7 @@ public:
 
     int getNumOutputChannelsGivenInputs (int numInputChannels) override  { return juce::jmin (numInputChannels, 2); }
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                  { return true; }
 
     bool isLowPass() const noexcept                     { return mode.get() != "highpass"; }
 
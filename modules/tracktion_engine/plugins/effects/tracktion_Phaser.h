@@ -27,6 +27,7 @@ public:
     void deinitialise() override;
     int getNumOutputChannelsGivenInputs (int numInputChannels) override  { return juce::jmin (numInputChannels, 2); }
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                      { return true; }
     juce::String getSelectableDescription() override;
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
 
@@ -50,6 +50,10 @@ ReverbPlugin::ReverbPlugin (PluginCreationInfo info) : Plugin (info)
     dryValue.referTo (state, IDs::dry, um, 0.5f);
     widthValue.referTo (state, IDs::width, um, 1.0f);
     modeValue.referTo (state, IDs::mode, um);
+    algorithmValue.referTo (state, IDs::reverbAlgorithm, um, (int) ReverbAlgorithm::classic);
+
+    if (info.isNewPlugin)
+        algorithmValue.setValue ((int) ReverbAlgorithm::feedbackDelayNetwork, nullptr);
 
     roomSizeParam->attachToCurrentValue (roomSizeValue);
     dampParam->attachToCurrentValue (dampValue);
@@ -77,6 +81,8 @@ void ReverbPlugin::initialise (const PluginInitialisationInfo& info)
 {
     outputSilent = true;
     reverb.setSampleRate (info.sampleRate);
+    fdnReverb.setSampleRate (info.sampleRate);
+    currentAlgorithm = getAlgorithm();
 }
 
 void ReverbPlugin::deinitialise()
@@ -86,6 +92,22 @@ void ReverbPlugin::deinitialise()
 void ReverbPlugin::reset()
 {
     reverb.reset();
+    fdnReverb.reset();
+}
+
+double ReverbPlugin::getTailLength() const
+{
+    return getDecayTimeSeconds (getAlgorithm(), roomSizeParam->getCurrentValue());
+}
+
+double ReverbPlugin::getDecayTimeSeconds (ReverbAlgorithm algorithm, float roomSize)
+{
+    if (algorithm == ReverbAlgorithm::feedbackDelayNetwork)
+        return FDNReverb::getDecayTimeSeconds (roomSize);
+
+    // juce::Reverb's longest comb is about 37ms and its feedback goes from 0.7 to 0.98
+    const auto feedback = roomSize * 0.28 + 0.7;
+    return 3.0 * 0.037 / -std::log10 (feedback);
 }
 
 static bool isNotSilent (float v) noexcept
@@ -111,16 +133,45 @@ void ReverbPlugin::applyToBuffer (const PluginRenderContext& fc)
     {
         SCOPED_REALTIME_CHECK
 
-        juce::Reverb::Parameters params;
-        params.roomSize   = roomSizeParam->getCurrentValue();
-        params.damping    = dampParam->getCurrentValue();
-        params.wetLevel   = wetParam->getCurrentValue();
-        params.dryLevel   = dryParam->getCurrentValue();
-        params.width      = widthParam->getCurrentValue();
-        params.freezeMode = modeParam->getCurrentValue();
+        if (auto algorithm = getAlgorithm(); algorithm != currentAlgorithm)
+        {
+            // Start the newly selected reverb from silence rather than an old tail
+            if (algorithm == ReverbAlgorithm::feedbackDelayNetwork)
+                fdnReverb.reset();
+            else
+                reverb.reset();
+
+            currentAlgorithm = algorithm;
+        }
 
-        if (memcmp (&params, &reverb.getParameters(), sizeof (params)) != 0)
-            reverb.setParameters (params);
+        const bool useFDN = currentAlgorithm == ReverbAlgorithm::feedbackDelayNetwork;
+
+        if (useFDN)
+        {
+            FDNReverb::Parameters params;
+            params.roomSize   = roomSizeParam->getCurrentValue();
+            params.damping    = dampParam->getCurrentValue();
+            params.wetLevel   = wetParam->getCurrentValue();
+            params.dryLevel   = dryParam->getCurrentValue();
+            params.width      = widthParam->getCurrentValue();
+            params.freezeMode = modeParam->getCurrentValue();
+
+            if (params != fdnReverb.getParameters())
+                fdnReverb.setParameters (params);
+        }
+        else
+        {
+            juce::Reverb::Parameters params;
+            params.roomSize   = roomSizeParam->getCurrentValue();
+            params.damping    = dampParam->getCurrentValue();
+            params.wetLevel   = wetParam->getCurrentValue();
+            params.dryLevel   = dryParam->getCurrentValue();
+            params.width      = widthParam->getCurrentValue();
+            params.freezeMode = modeParam->getCurrentValue();
+
+            if (memcmp (&params, &reverb.getParameters(), sizeof (params)) != 0)
+                reverb.setParameters (params);
+        }
 
         const int num = fc.bufferNumSamples;
         float* const left = fc.destBuffer->getWritePointer (0, fc.bufferStartSample);
@@ -134,7 +185,10 @@ void ReverbPlugin::applyToBuffer (const PluginRenderContext& fc)
             if (outputSilent && isSilent (left, num) && isSilent (right, num))
                 return;
 
-            reverb.processStereo (left, right, num);
+            if (useFDN)
+                fdnReverb.processStereo (left, right, num);
+            else
+                reverb.processStereo (left, right, num);
 
             outputSilent = isSilent (left, num) && isSilent (right, num);
         }
@@ -143,7 +197,10 @@ void ReverbPlugin::applyToBuffer (const PluginRenderContext& fc)
             if (outputSilent && isSilent (left, num))
                 return;
 
-            reverb.processMono (left, num);
+            if (useFDN)
+                fdnReverb.processMono (left, num);
+            else
+                reverb.processMono (left, num);
 
             outputSilent = isSilent (left, num);
         }
@@ -154,7 +211,7 @@ void ReverbPlugin::applyToBuffer (const PluginRenderContext& fc)
 
 void ReverbPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
 {
-    copyPropertiesToCachedValues (v, roomSizeValue, dampValue, wetValue, dryValue, widthValue, modeValue);
+    copyPropertiesToCachedValues (v, roomSizeValue, dampValue, wetValue, dryValue, widthValue, modeValue, algorithmValue);
 
     for (auto p : getAutomatableParameters())
         p->updateFromAttachedValue();
@@ -178,4 +235,15 @@ float ReverbPlugin::getWidth()                  { return widthParam->getCurrentV
 void ReverbPlugin::setMode (float value)        { modeParam->setParameter (juce::jlimit (0.0f, 1.0f, value), juce::sendNotification); }
 float ReverbPlugin::getMode()                   { return modeParam->getCurrentValue(); }
 
+void ReverbPlugin::setAlgorithm (ReverbAlgorithm a)
+{
+    algorithmValue = (int) a;
+}
+
+ReverbAlgorithm ReverbPlugin::getAlgorithm() const
+{
+    return algorithmValue.get() == (int) ReverbAlgorithm::feedbackDelayNetwork ? ReverbAlgorithm::feedbackDelayNetwork
+                                                                               : ReverbAlgorithm::classic;
+}
+
 }} // namespace tracktion { inline namespace engine
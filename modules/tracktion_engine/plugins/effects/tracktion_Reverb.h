@@ -28,7 +28,9 @@ public:
     void deinitialise() override;
     void reset() override;
     int getNumOutputChannelsGivenInputs (int numInputChannels) override { return juce::jmin (numInputChannels, 2); }
+    double getTailLength() const override;
     void applyToBuffer (const PluginRenderContext&) override;
+    bool canSleepWhenSilent() override                  { return true; }
     juce::String getSelectableDescription() override    { return TRANS("Reverb Plugin"); }
     void restorePluginStateFromValueTree (const juce::ValueTree&) override;
 
@@ -51,8 +53,18 @@ public:
     void setMode (float value);
     float getMode();
 
+    /** Sets the algorithm used. New plugins use the FDN reverb, older ones keep
+        the classic juce::Reverb so existing Edits sound the same.
+    */
+    void setAlgorithm (ReverbAlgorithm);
+    ReverbAlgorithm getAlgorithm() const;
+
+    /** Returns the time it takes a reverb to decay by 60dB for an algorithm and room size. */
+    static double getDecayTimeSeconds (ReverbAlgorithm, float roomSize);
+
     juce::CachedValue<float> roomSizeValue, dampValue, wetValue,
                              dryValue, widthValue, modeValue;
+    juce::CachedValue<int> algorithmValue;
 
     AutomatableParameter::Ptr roomSizeParam, dampParam, wetParam,
                               dryParam, widthParam, modeParam;
@@ -60,6 +72,8 @@ public:
 private:
     bool outputSilent = true;
     juce::Reverb reverb;
+    FDNReverb fdnReverb;
+    ReverbAlgorithm currentAlgorithm = ReverbAlgorithm::classic;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReverbPlugin)
 };
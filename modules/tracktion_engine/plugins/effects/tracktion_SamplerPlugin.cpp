@@ -14,36 +14,358 @@ namespace tracktion { inline namespace engine
 // this must be high enough for low freq sounds not to click
 static constexpr int minimumSamplesToPlayWhenStopping = 8;
 static constexpr int maximumSimultaneousNotes = 32;
+static constexpr int defaultStreamingPreloadSize = 32768;
 
+//==============================================================================
+struct SamplerStreamingThread  : public juce::TimeSliceThread
+{
+    SamplerStreamingThread()  : juce::TimeSliceThread ("Sampler Streaming")
+    {
+        startThread (juce::Thread::Priority::high);
+    }
+
+    ~SamplerStreamingThread() override
+    {
+        stopThread (10000);
+    }
+};
+
+//==============================================================================
+/**
+    Streams the part of a sound after its preloaded head for one voice.
+
+    The plugin keeps one of these per voice. A voice claims an idle stream when it
+    starts and plays from the sound's head while the streaming thread opens an
+    AudioFileCache reader and fills a FIFO with the rest of the sound.
+*/
+struct SamplerPlugin::SampleStream  : private juce::TimeSliceClient
+{
+    SampleStream (Engine& e)
+        : engine (e)
+    {
+        thread->addTimeSliceClient (this);
+    }
+
+    ~SampleStream() override
+    {
+        thread->removeTimeSliceClient (this);
+    }
+
+    //==============================================================================
+    /** Claims the stream for a voice, returning false if it's in use.
+        Called on the audio thread. The stream keeps a reference to the set until the
+        thread has finished with it, so the sound stays valid without being copied.
+    */
+    bool start (const std::shared_ptr<SoundSet>& set, const SamplerSound& soundToPlay)
+    {
+        if (state.load (std::memory_order_acquire) != State::idle)
+            return false;
+
+        // The plugin keeps its own reference to every set in use, so this never allocates or frees
+        jassert (soundSet == nullptr);
+        soundSet = set;
+        sound = &soundToPlay;
+
+        const auto numHeadFrames = soundToPlay.numPreloadedSamples;
+        firstFrameToRead = soundToPlay.fileStartSample + numHeadFrames;
+        numFramesToRead = soundToPlay.fileLengthSamples - numHeadFrames;
+        numFramesInSound = soundToPlay.fileLengthSamples;
+        windowStart = 0;
+        numInWindow = 0;
+        nextFifoFrame = numHeadFrames;
+
+        state.store (State::starting, std::memory_order_release);
+        return true;
+    }
+
+    /** Hands the stream back once the voice has finished. */
+    void release() noexcept
+    {
+        state.store (State::releasing, std::memory_order_release);
+    }
+
+    /** Returns true if no voice is using the stream and the thread has finished with it. */
+    bool isIdle() const noexcept
+    {
+        return state.load (std::memory_order_acquire) == State::idle;
+    }
+
+    /** Returns the most output frames that can be rendered from one call to getFrames. */
+    int getMaxNumOutputFrames (double playbackRatio) const noexcept
+    {
+        return std::max (1, static_cast<int> ((windowSize - 8) / playbackRatio) - 2);
+    }
+
+    /** Returns a buffer starting at the given frame of the sound with at least numFrames frames.
+        Frames still in the head are copied from there, the rest come from the FIFO. If
+        the FIFO hasn't got them yet, they're replaced with silence and an underrun is counted.
+    */
+    const juce::AudioBuffer<float>& getFrames (const juce::AudioBuffer<float>& head, int numHeadFrames,
+                                               int firstFrame, int numFrames) noexcept
+    {
+        jassert (numFrames <= windowSize && firstFrame >= windowStart);
+
+        // Drop the frames that have been used
+        const auto numToDrop = std::min (firstFrame - windowStart, numInWindow);
+        numInWindow -= numToDrop;
+
+        if (numInWindow > 0 && numToDrop > 0)
+            for (int chan = 0; chan < window.getNumChannels(); ++chan)
+                std::memmove (window.getWritePointer (chan), window.getReadPointer (chan, numToDrop),
+                              static_cast<size_t> (numInWindow) * sizeof (float));
+
+        windowStart = firstFrame;
+        bool hasUnderrun = false;
+
+        while (numInWindow < numFrames)
+        {
+            const auto frame = windowStart + numInWindow;
+            auto numThisTime = numFrames - numInWindow;
+
+            if (frame < numHeadFrames)
+            {
+                numThisTime = std::min (numThisTime, numHeadFrames - frame);
+
+                for (int chan = 0; chan < window.getNumChannels(); ++chan)
+                    window.copyFrom (chan, numInWindow, head, std::min (chan, head.getNumChannels() - 1), frame, numThisTime);
+            }
+            else if (frame >= numFramesInSound)
+            {
+                window.clear (numInWindow, numThisTime);
+            }
+            else
+            {
+                numThisTime = std::min (numThisTime, numFramesInSound - frame);
+                const bool isStreaming = state.load (std::memory_order_acquire) == State::streaming;
+
+                // Skip anything that arrived too late to be used
+                if (isStreaming && nextFifoFrame < frame)
+                {
+                    const auto numToSkip = std::min (frame - nextFifoFrame, fifo.getNumReady());
+                    fifo.skip (numToSkip);
+                    nextFifoFrame += numToSkip;
+                }
+
+                const auto numReady = isStreaming && nextFifoFrame == frame ? std::min (numThisTime, fifo.getNumReady()) : 0;
+
+                if (numReady > 0)
+                {
+                    fifo.read (window, numInWindow, numReady);
+                    nextFifoFrame += numReady;
+                }
+
+                if (numReady < numThisTime)
+                {
+                    window.clear (numInWindow + numReady, numThisTime - numReady);
+                    numFramesMissed.fetch_add (numThisTime - numReady, std::memory_order_relaxed);
+                    hasUnderrun = true;
+                }
+            }
+
+            numInWindow += numThisTime;
+        }
+
+        if (hasUnderrun)
+            numUnderruns.fetch_add (1, std::memory_order_relaxed);
+
+        return window;
+    }
+
+    //==============================================================================
+    StreamingVoiceStats getStats() const noexcept
+    {
+        return { numUnderruns.load (std::memory_order_relaxed),
+                 numFramesMissed.load (std::memory_order_relaxed) };
+    }
+
+    void resetStats() noexcept
+    {
+        numUnderruns = 0;
+        numFramesMissed = 0;
+    }
+
+private:
+    //==============================================================================
+    enum class State
+    {
+        idle,       // Free to be claimed by a voice
+        starting,   // Claimed, waiting for the thread to open the file
+        streaming,  // Being filled by the thread and read by the voice
+        releasing   // Finished with, waiting for the thread to reset it
+    };
+
+    static constexpr int windowSize = 8192, fifoSize = 32768, maxNumFramesPerRead = 8192;
+
+    Engine& engine;
+    juce::SharedResourcePointer<SamplerStreamingThread> thread;
+    std::atomic<State> state { State::idle };
+
+    // Set by the voice when starting and cleared by the thread when it hands the stream back
+    std::shared_ptr<SoundSet> soundSet;
+    const SamplerSound* sound = nullptr;
+    int firstFrameToRead = 0, numFramesToRead = 0, numFramesInSound = 0;
+
+    // Only used by the streaming thread
+    AudioFileCache::Reader::Ptr reader;
+    AudioFile readerFile { engine };
+    int numFramesRead = 0;
+    juce::AudioBuffer<float> readBuffer { 2, maxNumFramesPerRead };
+
+    // Only used by the voice
+    juce::AudioBuffer<float> window { 2, windowSize };
+    int windowStart = 0, numInWindow = 0, nextFifoFrame = 0;
+
+    AudioFifo fifo { 2, fifoSize };
+    std::atomic<int> numUnderruns { 0 };
+    std::atomic<SampleCount> numFramesMissed { 0 };
+
+    int useTimeSlice() override
+    {
+        switch (state.load (std::memory_order_acquire))
+        {
+            case State::idle:
+                return 5;
+
+            case State::starting:
+                startReading();
+                return 0;
+
+            case State::streaming:
+                return fillFifo();
+
+            case State::releasing:
+                handBack();
+                return 5;
+        }
+
+        return 5;
+    }
+
+    void startReading()
+    {
+        CRASH_TRACER
+
+        // Voices often play the same sound again so the reader is kept
+        if (reader == nullptr || readerFile != sound->audioFile)
+        {
+            readerFile = sound->audioFile;
+            reader = engine.getAudioFileManager().cache.createReader (readerFile);
+        }
+
+        if (reader != nullptr)
+            reader->setReadPosition (firstFrameToRead);
+
+        numFramesRead = 0;
+
+        // The voice may have released the stream whilst the file was being opened,
+        // in which case it has to be handed straight back rather than left streaming
+        auto expected = State::starting;
+
+        if (! state.compare_exchange_strong (expected, State::streaming, std::memory_order_acq_rel))
+            handBack();
+    }
+
+    void handBack()
+    {
+        fifo.reset();
+        sound = nullptr;
+        soundSet.reset();
+        state.store (State::idle, std::memory_order_release);
+    }
+
+    int fillFifo()
+    {
+        const auto numToRead = std::min ({ numFramesToRead - numFramesRead, fifo.getFreeSpace(), maxNumFramesPerRead });
+
+        if (numToRead <= 0 || reader == nullptr)
+            return 2;
+
+        const auto sourceChannels = juce::AudioChannelSet::canonicalChannelSet (reader->getNumChannels());
+        readBuffer.clear();
+
+        if (! reader->readSamples (numToRead, readBuffer, juce::AudioChannelSet::stereo(), 0, sourceChannels, 100))
+            return 1;
+
+        fifo.write (readBuffer, 0, numToRead);
+        numFramesRead += numToRead;
+
+        // Keep going straight away if the voice has used lots of the buffer
+        return fifo.getFreeSpace() > fifoSize / 2 ? 0 : 2;
+    }
 
-struct SamplerPlugin::SampledNote   : public ReferenceCountedObject
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleStream)
+};
+
+
+//==============================================================================
+/** An immutable set of sounds, published to the audio thread as a whole. */
+struct SamplerPlugin::SoundSet
+{
+    juce::OwnedArray<SamplerSound> sounds;
+    juce::Array<SampleStream*> streams;
+};
+
+//==============================================================================
+/**
+    One of the plugin's preallocated voices.
+    While a voice is active it holds on to the SoundSet its sound belongs to, so
+    the sounds can be swapped without cutting off notes that are still playing.
+*/
+struct SamplerPlugin::SampledNote
 {
 public:
-    SampledNote (int midiNote, int keyNote,
-                 float velocity,
-                 const AudioFile& file,
-                 double sampleRate,
-                 int sampleDelayFromBufferStart,
-                 const juce::AudioBuffer<float>& data,
-                 int lengthInSamples,
-                 float gainDb,
-                 float pan,
-                 bool openEnded_)
-       : note (midiNote),
-         offset (-sampleDelayFromBufferStart),
-         audioData (data),
-         openEnded (openEnded_)
+    SampledNote() = default;
+
+    ~SampledNote()
+    {
+        stop();
+    }
+
+    void start (const std::shared_ptr<SoundSet>& set, const SamplerSound& sound,
+                int midiNote, float velocity, double sampleRate,
+                int sampleDelayFromBufferStart, SampleStream* stream_)
     {
+        soundSet = set;
+        audioData = sound.audioData.get();
+        stream = stream_;
+        note = midiNote;
+        offset = -sampleDelayFromBufferStart;
+        openEnded = sound.openEnded;
+        numHeadSamples = sound.numPreloadedSamples;
+        numSourceSamples = stream != nullptr || ! sound.isStreamed() ? sound.fileLengthSamples
+                                                                     : sound.numPreloadedSamples;
+        startFade = 1.0f;
+        isFinished = false;
+
         resampler[0].reset();
         resampler[1].reset();
 
-        const float volumeSliderPos = decibelsToVolumeFaderPosition (gainDb - (20.0f * (1.0f - velocity)));
-        getGainsFromVolumeFaderPositionAndPan (volumeSliderPos, pan, getDefaultPanLaw(), gains[0], gains[1]);
+        const float volumeSliderPos = decibelsToVolumeFaderPosition (sound.gainDb - (20.0f * (1.0f - velocity)));
+        getGainsFromVolumeFaderPositionAndPan (volumeSliderPos, sound.pan, getDefaultPanLaw(), gains[0], gains[1]);
 
         const double hz = juce::MidiMessage::getMidiNoteInHertz (midiNote);
-        playbackRatio = hz / juce::MidiMessage::getMidiNoteInHertz (keyNote);
-        playbackRatio *= file.getSampleRate() / sampleRate;
-        samplesLeftToPlay = playbackRatio > 0 ? (1 + (int) (lengthInSamples / playbackRatio)) : 0;
+        playbackRatio = hz / juce::MidiMessage::getMidiNoteInHertz (sound.keyNote);
+        playbackRatio *= sound.fileSampleRate / sampleRate;
+        samplesLeftToPlay = playbackRatio > 0 ? (1 + (int) (numSourceSamples / playbackRatio)) : 0;
+    }
+
+    /** Stops the note and lets go of its sound and stream. */
+    void stop() noexcept
+    {
+        if (stream != nullptr)
+            stream->release();
+
+        stream = nullptr;
+        audioData = nullptr;
+
+        // The plugin also keeps a reference to each set until it's unused,
+        // so this is never the last one and the set isn't freed here
+        soundSet.reset();
+    }
+
+    bool isActive() const noexcept
+    {
+        return soundSet != nullptr;
     }
 
     void addNextBlock (juce::AudioBuffer<float>& outBuffer, int startSamp, int numSamples)
@@ -62,22 +384,32 @@ public:
 
         if (numSamps > 0)
         {
-            int numUsed = 0;
+            // Streamed sounds are rendered in sections that fit in the stream's buffer
+            const auto maxNumPerSection = stream != nullptr ? stream->getMaxNumOutputFrames (playbackRatio) : numSamps;
 
-            for (int i = std::min (2, outBuffer.getNumChannels()); --i >= 0;)
+            for (int done = 0; done < numSamps;)
             {
-                numUsed = resampler[i]
-                            .processAdding (playbackRatio,
-                                            audioData.getReadPointer (std::min (i, audioData.getNumChannels() - 1), offset),
-                                            outBuffer.getWritePointer (i, startSamp),
-                                            numSamps,
-                                            gains[i]);
+                const auto numThisTime = std::min (numSamps - done, maxNumPerSection);
+                const auto [source, sourceStart] = getSourceSamples (2 + (int) std::ceil ((numThisTime + 2) * playbackRatio));
+                int numUsed = 0;
+
+                for (int i = std::min (2, outBuffer.getNumChannels()); --i >= 0;)
+                {
+                    numUsed = resampler[i]
+                                .processAdding (playbackRatio,
+                                                source->getReadPointer (std::min (i, source->getNumChannels() - 1), sourceStart),
+                                                outBuffer.getWritePointer (i, startSamp + done),
+                                                numThisTime,
+                                                gains[i]);
+                }
+
+                offset += numUsed;
+                done += numThisTime;
             }
 
-            offset += numUsed;
             samplesLeftToPlay -= numSamps;
 
-            jassert (offset <= audioData.getNumSamples());
+            jassert (stream != nullptr || offset <= audioData->getNumSamples());
         }
 
         if (numSamples > numSamps && startFade > 0.0f)
@@ -97,12 +429,14 @@ public:
             }
 
             const int numSampsNeeded = 2 + juce::roundToInt ((numSamps + 2) * playbackRatio);
-            AudioScratchBuffer scratch (audioData.getNumChannels(), numSampsNeeded + 8);
+            AudioScratchBuffer scratch (audioData->getNumChannels(), numSampsNeeded + 8);
 
-            if (offset + numSampsNeeded < audioData.getNumSamples())
+            if (offset + numSampsNeeded < getNumSourceSamples())
             {
+                const auto [source, sourceStart] = getSourceSamples (numSampsNeeded);
+
                 for (int i = scratch.buffer.getNumChannels(); --i >= 0;)
-                    scratch.buffer.copyFrom (i, 0, audioData, i, offset, numSampsNeeded);
+                    scratch.buffer.copyFrom (i, 0, *source, std::min (i, source->getNumChannels() - 1), sourceStart, numSampsNeeded);
             }
             else
             {
@@ -131,28 +465,60 @@ public:
     }
 
     juce::LagrangeInterpolator resampler[2];
-    int note;
-    int offset, samplesLeftToPlay = 0;
-    float gains[2];
+    int note = 0;
+    int offset = 0, samplesLeftToPlay = 0;
+    float gains[2] = { 0, 0 };
     double playbackRatio = 1.0;
-    const juce::AudioBuffer<float>& audioData;
-    float lastVals[4] = { 0, 0, 0, 0 };
     float startFade = 1.0f;
-    bool openEnded, isFinished = false;
+    bool openEnded = false, isFinished = false;
 
 private:
+    std::shared_ptr<SoundSet> soundSet;
+    const juce::AudioBuffer<float>* audioData = nullptr;
+    SampleStream* stream = nullptr;
+    int numHeadSamples = 0, numSourceSamples = 0;
+
+    /** Returns the number of samples that can be read, including the padding after the sound. */
+    int getNumSourceSamples() const
+    {
+        return stream != nullptr ? numSourceSamples + 32 : audioData->getNumSamples();
+    }
+
+    /** Returns a buffer and start index holding the next numNeeded source samples. */
+    std::pair<const juce::AudioBuffer<float>*, int> getSourceSamples (int numNeeded)
+    {
+        if (stream == nullptr)
+            return { audioData, offset };
+
+        return { &stream->getFrames (*audioData, numHeadSamples, offset, numNeeded), 0 };
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampledNote)
 };
 
 //==============================================================================
 SamplerPlugin::SamplerPlugin (PluginCreationInfo info)  : Plugin (info)
 {
+    auto um = getUndoManager();
+    diskStreaming.referTo (state, IDs::diskStreaming, um, false);
+    streamingPreloadSize.referTo (state, IDs::streamingPreloadSize, um, defaultStreamingPreloadSize);
+
+    soundSet = std::make_shared<SoundSet>();
+    previewNotes.reset (256);
+    releaseTimer.setCallback ([this] { releaseUnusedSoundSets(); });
+
+    for (int i = 0; i < maximumSimultaneousNotes; ++i)
+        voices.add (new SampledNote());
+
     triggerAsyncUpdate();
 }
 
 SamplerPlugin::~SamplerPlugin()
 {
     notifyListenersOfDeletion();
+
+    // Stop any voices before the streams they use are deleted
+    voices.clear();
 }
 
 const char* SamplerPlugin::xmlTypeName = "sampler";
@@ -192,94 +558,136 @@ void SamplerPlugin::handleAsyncUpdate()
         }
     }
 
-    for (auto newSound : newSounds)
-    {
-        for (auto s : soundList)
-        {
-            if (s->source == newSound->source
-                && s->startTime == newSound->startTime
-                && s->length == newSound->length)
-            {
-                newSound->audioFile = s->audioFile;
-                newSound->fileStartSample = s->fileStartSample;
-                newSound->fileLengthSamples = s->fileLengthSamples;
-                newSound->audioData = s->audioData;
-            }
-        }
-    }
+    // Streams are created up front so voices never have to wait for one. A voice only uses one
+    // at a time, the spares cover ones that have been stopped but not yet handed back by the thread.
+    if (diskStreaming.get() && streams.isEmpty())
+        for (int i = 0; i < maximumSimultaneousNotes * 2; ++i)
+            streams.add (new SampleStream (engine));
+
+    auto newSet = std::make_shared<SoundSet>();
+    newSet->sounds.swapWith (newSounds);
+    newSet->streams.addArray (streams);
 
     {
         const juce::ScopedLock sl (lock);
-        allNotesOff();
-        soundList.swapWith (newSounds);
-
-        sourceMediaChanged();
+        soundSet = newSet;
     }
 
-    newSounds.clear();
+    // Voices still playing the old sounds carry on until they finish, new notes
+    // use the new set from the next block
+    soundSetsInUse.push_back (newSet);
+    realTimeSoundSet.pushNonRealTime (std::move (newSet));
+    releaseUnusedSoundSets();
+
     changed();
 }
 
+void SamplerPlugin::releaseUnusedSoundSets()
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    // If this is the only reference, neither the audio thread nor any voices can
+    // be using the set and as it's not current, they can't get hold of it again
+    std::erase_if (soundSetsInUse, [] (auto& set) { return set.use_count() == 1; });
+
+    if (soundSetsInUse.size() > 1)
+    {
+        // The audio thread keeps the previous set as its pending object until
+        // something else is pushed, so push the current set again to release it
+        if (releaseTimer.isTimerRunning())
+            realTimeSoundSet.pushNonRealTime (std::shared_ptr<SoundSet> (soundSet));
+
+        releaseTimer.startTimer (1000);
+    }
+    else
+    {
+        releaseTimer.stopTimer();
+    }
+}
+
 void SamplerPlugin::initialise (const PluginInitialisationInfo&)
 {
-    const juce::ScopedLock sl (lock);
     allNotesOff();
 }
 
 void SamplerPlugin::deinitialise()
 {
-    allNotesOff();
+    // Nothing's being rendered at this point so the voices can be stopped directly
+    allNotesOffPending = false;
+    stopAllVoices();
 }
 
 //==============================================================================
 void SamplerPlugin::playNotes (const juce::BigInteger& keysDown)
 {
-    const juce::ScopedLock sl (lock);
+    // The notes are started on the audio thread so the voices are never locked
+    for (int note = 128; --note >= 0;)
+        if (keysDown[note] != previewKeysDown[note])
+            previewNotes.push ({ note, keysDown[note] });
 
-    if (highlightedNotes != keysDown)
-    {
-        for (int i = playingNotes.size(); --i >= 0;)
-            if ((! keysDown [playingNotes.getUnchecked(i)->note])
-                 && highlightedNotes [playingNotes.getUnchecked(i)->note]
-                 && ! playingNotes.getUnchecked(i)->openEnded)
-                playingNotes.getUnchecked(i)->samplesLeftToPlay = minimumSamplesToPlayWhenStopping;
+    previewKeysDown = keysDown;
+}
 
-        for (int note = 128; --note >= 0;)
+void SamplerPlugin::allNotesOff()
+{
+    allNotesOffPending = true;
+}
+
+SamplerPlugin::SampledNote* SamplerPlugin::findFreeVoice() const noexcept
+{
+    for (auto voice : voices)
+        if (! voice->isActive())
+            return voice;
+
+    return nullptr;
+}
+
+void SamplerPlugin::addNote (const std::shared_ptr<SoundSet>& set, const SamplerSound& ss,
+                             int note, float velocity, int sampleDelayFromBufferStart)
+{
+    auto voice = findFreeVoice();
+
+    if (voice == nullptr)
+        return;
+
+    SampleStream* stream = nullptr;
+
+    // If lots of voices have just been stopped, all the spare streams may still be on their way
+    // back. Rather than drop the note, it then plays the preloaded head on its own.
+    if (ss.isStreamed())
+    {
+        for (auto s : set->streams)
         {
-            if (keysDown [note] && ! highlightedNotes [note])
+            if (s->start (set, ss))
             {
-                for (auto ss : soundList)
-                {
-                    if (ss->minNote <= note
-                         && ss->maxNote >= note
-                         && ss->audioData.getNumSamples() > 0
-                         && (! ss->audioFile.isNull())
-                         && playingNotes.size() < maximumSimultaneousNotes)
-                    {
-                        playingNotes.add (new SampledNote (note,
-                                                           ss->keyNote,
-                                                           0.75f,
-                                                           ss->audioFile,
-                                                           sampleRate,
-                                                           0,
-                                                           ss->audioData,
-                                                           ss->fileLengthSamples,
-                                                           ss->gainDb,
-                                                           ss->pan,
-                                                           ss->openEnded));
-                    }
-                }
+                stream = s;
+                break;
             }
         }
+    }
+
+    voice->start (set, ss, note, velocity, sampleRate, sampleDelayFromBufferStart, stream);
+}
 
-        highlightedNotes = keysDown;
+void SamplerPlugin::stopNote (int note, int noteTimeSample)
+{
+    for (auto voice : voices)
+    {
+        if (voice->isActive() && voice->note == note && ! voice->openEnded)
+        {
+            voice->samplesLeftToPlay = std::min (voice->samplesLeftToPlay,
+                                                 std::max (minimumSamplesToPlayWhenStopping,
+                                                           noteTimeSample));
+            highlightedNotes.clearBit (note);
+        }
     }
 }
 
-void SamplerPlugin::allNotesOff()
+void SamplerPlugin::stopAllVoices()
 {
-    const juce::ScopedLock sl (lock);
-    playingNotes.clear();
+    for (auto voice : voices)
+        voice->stop();
+
     highlightedNotes.clear();
 }
 
@@ -289,17 +697,48 @@ void SamplerPlugin::applyToBuffer (const PluginRenderContext& fc)
     {
         SCOPED_REALTIME_CHECK
 
-        const juce::ScopedLock sl (lock);
+        auto soundSetAccess = realTimeSoundSet.getScopedAccess();
+        auto set = soundSetAccess.get() != nullptr ? *soundSetAccess.get() : std::shared_ptr<SoundSet>();
 
         clearChannels (*fc.destBuffer, 2, -1, fc.bufferStartSample, fc.bufferNumSamples);
 
-        if (fc.bufferForMidiMessages != nullptr)
+        if (allNotesOffPending.exchange (false))
+            stopAllVoices();
+
+        auto startNote = [&] (int note, float velocity, int noteTimeSample)
         {
-            if (fc.bufferForMidiMessages->isAllNotesOff)
+            if (set == nullptr)
+                return;
+
+            for (auto ss : set->sounds)
             {
-                playingNotes.clear();
-                highlightedNotes.clear();
+                if (ss->minNote <= note
+                    && ss->maxNote >= note
+                    && ss->audioData->getNumSamples() > 0)
+                {
+                    highlightedNotes.setBit (note);
+                    addNote (set, *ss, note, velocity, noteTimeSample);
+                }
             }
+        };
+
+        for (PreviewNote preview; previewNotes.pop (preview);)
+        {
+            if (preview.isOn)
+            {
+                if (! highlightedNotes[preview.note])
+                    startNote (preview.note, 0.75f, 0);
+            }
+            else if (highlightedNotes[preview.note])
+            {
+                stopNote (preview.note, minimumSamplesToPlayWhenStopping);
+            }
+        }
+
+        if (fc.bufferForMidiMessages != nullptr)
+        {
+            if (fc.bufferForMidiMessages->isAllNotesOff)
+                stopAllVoices();
 
             for (auto& m : *fc.bufferForMidiMessages)
             {
@@ -308,77 +747,69 @@ void SamplerPlugin::applyToBuffer (const PluginRenderContext& fc)
                     const int note = m.getNoteNumber();
                     const int noteTimeSample = juce::roundToInt (m.getTimeStamp() * sampleRate);
 
-                    for (auto playingNote : playingNotes)
-                    {
-                        if (playingNote->note == note && ! playingNote->openEnded)
-                        {
-                            playingNote->samplesLeftToPlay = std::min (playingNote->samplesLeftToPlay,
-                                                                       std::max (minimumSamplesToPlayWhenStopping,
-                                                                                 noteTimeSample));
-                            highlightedNotes.clearBit (note);
-                        }
-                    }
-
-                    for (auto ss : soundList)
-                    {
-                        if (ss->minNote <= note
-                            && ss->maxNote >= note
-                            && ss->audioData.getNumSamples() > 0
-                            && playingNotes.size() < maximumSimultaneousNotes)
-                        {
-                            highlightedNotes.setBit (note);
-
-                            playingNotes.add (new SampledNote (note,
-                                                               ss->keyNote,
-                                                               m.getVelocity() / 127.0f,
-                                                               ss->audioFile,
-                                                               sampleRate,
-                                                               noteTimeSample,
-                                                               ss->audioData,
-                                                               ss->fileLengthSamples,
-                                                               ss->gainDb,
-                                                               ss->pan,
-                                                               ss->openEnded));
-                        }
-                    }
+                    stopNote (note, noteTimeSample);
+                    startNote (note, m.getVelocity() / 127.0f, noteTimeSample);
                 }
                 else if (m.isNoteOff())
                 {
-                    const int note = m.getNoteNumber();
-                    const int noteTimeSample = juce::roundToInt (m.getTimeStamp() * sampleRate);
-
-                    for (auto playingNote : playingNotes)
-                    {
-                        if (playingNote->note == note && ! playingNote->openEnded)
-                        {
-                            playingNote->samplesLeftToPlay = std::min (playingNote->samplesLeftToPlay,
-                                                                       std::max (minimumSamplesToPlayWhenStopping,
-                                                                                 noteTimeSample));
-
-                            highlightedNotes.clearBit (note);
-                        }
-                    }
+                    stopNote (m.getNoteNumber(), juce::roundToInt (m.getTimeStamp() * sampleRate));
                 }
                 else if (m.isAllNotesOff() || m.isAllSoundOff())
                 {
-                    playingNotes.clear();
-                    highlightedNotes.clear();
+                    stopAllVoices();
                 }
             }
         }
 
-        for (int i = playingNotes.size(); --i >= 0;)
+        for (auto voice : voices)
         {
-            auto sn = playingNotes.getUnchecked (i);
+            if (! voice->isActive())
+                continue;
 
-            sn->addNextBlock (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
+            voice->addNextBlock (*fc.destBuffer, fc.bufferStartSample, fc.bufferNumSamples);
 
-            if (sn->isFinished)
-                playingNotes.remove (i);
+            if (voice->isFinished)
+                voice->stop();
         }
     }
 }
 
+//==============================================================================
+void SamplerPlugin::setDiskStreamingEnabled (bool shouldStream)
+{
+    diskStreaming = shouldStream;
+}
+
+void SamplerPlugin::setStreamingPreloadSize (int numFrames)
+{
+    streamingPreloadSize = juce::jlimit (1024, 1 << 22, numFrames);
+}
+
+std::vector<SamplerPlugin::StreamingVoiceStats> SamplerPlugin::getStreamingVoiceStats() const
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    std::vector<StreamingVoiceStats> stats;
+
+    for (auto s : streams)
+        stats.push_back (s->getStats());
+
+    return stats;
+}
+
+void SamplerPlugin::resetStreamingVoiceStats()
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+
+    for (auto s : streams)
+        s->resetStats();
+}
+
+int SamplerPlugin::getNumStreamsInUse() const
+{
+    TRACKTION_ASSERT_MESSAGE_THREAD
+    return static_cast<int> (std::count_if (streams.begin(), streams.end(), [] (auto s) { return ! s->isIdle(); }));
+}
+
 //==============================================================================
 int SamplerPlugin::getNumSounds() const
 {
@@ -403,7 +834,7 @@ bool SamplerPlugin::hasNameForMidiNoteNumber (int note, int, juce::String& noteN
     {
         const juce::ScopedLock sl (lock);
 
-        for (auto ss : soundList)
+        for (auto ss : soundSet->sounds)
         {
             if (ss->minNote <= note && ss->maxNote >= note)
             {
@@ -423,7 +854,7 @@ AudioFile SamplerPlugin::getSoundFile (int index) const
 {
     const juce::ScopedLock sl (lock);
 
-    if (auto s = soundList[index])
+    if (auto s = soundSet->sounds[index])
         return s->audioFile;
 
     return AudioFile (edit.engine);
@@ -433,7 +864,7 @@ juce::String SamplerPlugin::getSoundMedia (int index) const
 {
     const juce::ScopedLock sl (lock);
 
-    if (auto s = soundList[index])
+    if (auto s = soundSet->sounds[index])
         return s->source;
 
     return {};
@@ -455,7 +886,7 @@ double SamplerPlugin::getSoundLength (int index) const
     {
         const juce::ScopedLock sl (lock);
 
-        if (auto s = soundList[index])
+        if (auto s = soundSet->sounds[index])
             return s->length;
     }
 
@@ -488,10 +919,6 @@ juce::String SamplerPlugin::addSound (const juce::String& source, const juce::St
 void SamplerPlugin::removeSound (int index)
 {
     state.removeChild (index, getUndoManager());
-
-    const juce::ScopedLock sl (lock);
-    playingNotes.clear();
-    highlightedNotes.clear();
 }
 
 void SamplerPlugin::setSoundParams (int index, int keyNote, int minNote, int maxNote)
@@ -589,10 +1016,8 @@ void SamplerPlugin::reassignReferencedItem (const ReferencedItem& item, ProjectI
 
 void SamplerPlugin::sourceMediaChanged()
 {
-    const juce::ScopedLock sl (lock);
-
-    for (auto s : soundList)
-        s->refreshFile();
+    // The sounds are rebuilt rather than changed in place as the audio thread may be using them
+    triggerAsyncUpdate();
 }
 
 void SamplerPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
@@ -613,7 +1038,8 @@ SamplerPlugin::SamplerSound::SamplerSound (SamplerPlugin& sf,
       gainDb (juce::jlimit (-48.0f, 48.0f, gainDb_)),
       startTime (startTime_),
       length (length_),
-      audioFile (owner.edit.engine, SourceFileReference::findFileFromString (owner.edit, source))
+      audioFile (owner.edit.engine, SourceFileReference::findFileFromString (owner.edit, source)),
+      audioData (std::make_shared<const juce::AudioBuffer<float>>())
 {
     setExcerpt (startTime_, length_);
 
@@ -651,52 +1077,62 @@ void SamplerPlugin::SamplerSound::setExcerpt (double startTime_, double length_)
         else
             length = audioFile.getLength();
 
+        fileSampleRate    = audioFile.getSampleRate();
         fileStartSample   = juce::roundToInt (startTime * audioFile.getSampleRate());
         fileLengthSamples = juce::roundToInt (length * audioFile.getSampleRate());
 
-        if (auto reader = owner.engine.getAudioFileManager().cache.createReader (audioFile))
-        {
-            audioData.setSize (audioFile.getNumChannels(), fileLengthSamples + 32);
-            audioData.clear();
+        // When streaming, only the head of the sound is loaded and the rest is read as it plays
+        numPreloadedSamples = owner.isDiskStreamingEnabled() ? std::min (fileLengthSamples, owner.getStreamingPreloadSize())
+                                                             : fileLengthSamples;
 
-            auto audioDataChannelSet = juce::AudioChannelSet::canonicalChannelSet (audioFile.getNumChannels());
-            auto channelsToUse = juce::AudioChannelSet::stereo();
+        // Any other sounds using the same part of the same file share the decoded audio
+        auto key = SharedAudioDataStore::createKey (audioFile);
+        key.add (fileStartSample).add (numPreloadedSamples);
 
-            int total = fileLengthSamples;
-            int offset = 0;
+        audioData = owner.engine.getSharedAudioDataStore().getOrCreate<juce::AudioBuffer<float>> (key, [this]
+        {
+            juce::AudioBuffer<float> data (audioFile.getNumChannels(), numPreloadedSamples + 32);
+            data.clear();
 
-            while (total > 0)
+            if (auto reader = owner.engine.getAudioFileManager().cache.createReader (audioFile))
             {
-                const int numThisTime = std::min (8192, total);
-                reader->setReadPosition (fileStartSample + offset);
+                auto audioDataChannelSet = juce::AudioChannelSet::canonicalChannelSet (audioFile.getNumChannels());
+                auto channelsToUse = juce::AudioChannelSet::stereo();
+
+                int total = numPreloadedSamples;
+                int offset = 0;
 
-                if (! reader->readSamples (numThisTime, audioData, audioDataChannelSet, offset, channelsToUse, 2000))
+                while (total > 0)
                 {
-                    jassertfalse;
-                    break;
-                }
+                    const int numThisTime = std::min (8192, total);
+                    reader->setReadPosition (fileStartSample + offset);
+
+                    if (! reader->readSamples (numThisTime, data, audioDataChannelSet, offset, channelsToUse, 2000))
+                    {
+                        jassertfalse;
+                        break;
+                    }
 
-                offset += numThisTime;
-                total -= numThisTime;
+                    offset += numThisTime;
+                    total -= numThisTime;
+                }
             }
-        }
-        else
-        {
-            audioData.clear();
-        }
 
-        // add a quick fade-in if needed..
-        int fadeLen = 0;
-        for (int i = audioData.getNumChannels(); --i >= 0;)
-        {
-            const float* d = audioData.getReadPointer (i);
+            // add a quick fade-in if needed..
+            int fadeLen = 0;
+            for (int i = data.getNumChannels(); --i >= 0;)
+            {
+                const float* d = data.getReadPointer (i);
 
-            if (std::abs (*d) > 0.01f)
-                fadeLen = 30;
-        }
+                if (std::abs (*d) > 0.01f)
+                    fadeLen = 30;
+            }
+
+            if (fadeLen > 0)
+                AudioFadeCurve::applyCrossfadeSection (data, 0, fadeLen, AudioFadeCurve::concave, 0.0f, 1.0f);
 
-        if (fadeLen > 0)
-            AudioFadeCurve::applyCrossfadeSection (audioData, 0, fadeLen, AudioFadeCurve::concave, 0.0f, 1.0f);
+            return data;
+        });
     }
     else
     {
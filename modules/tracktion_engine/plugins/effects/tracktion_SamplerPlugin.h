@@ -46,6 +46,43 @@ public:
     void playNotes (const juce::BigInteger& keysDown);
     void allNotesOff();
 
+    //==============================================================================
+    /** Enables disk streaming.
+        When enabled, only the first part of each sound is kept in memory and the
+        rest is streamed from disk as each note plays, so large multi-sampled
+        instruments load quickly and use a fixed amount of memory per sound.
+    */
+    void setDiskStreamingEnabled (bool);
+    bool isDiskStreamingEnabled() const                 { return diskStreaming.get(); }
+
+    /** Sets the number of frames of each sound kept in memory when streaming.
+        This needs to cover the time it takes to start reading the file, which
+        will depend on the disk and how far notes are transposed up.
+    */
+    void setStreamingPreloadSize (int numFrames);
+    int getStreamingPreloadSize() const                 { return streamingPreloadSize.get(); }
+
+    /** Describes how well disk streaming has kept up for one voice. */
+    struct StreamingVoiceStats
+    {
+        int numUnderruns = 0;               ///< The number of blocks where the disk couldn't keep up.
+        SampleCount numFramesMissed = 0;    ///< The number of source frames replaced by silence.
+    };
+
+    /** Returns the streaming stats for each stream since the last reset.
+        There are two streams per voice so notes can start while others are being handed back.
+        If these show underruns, the preload size should be increased.
+    */
+    std::vector<StreamingVoiceStats> getStreamingVoiceStats() const;
+
+    /** Clears the streaming stats for all voices. */
+    void resetStreamingVoiceStats();
+
+    /** @internal Returns the number of streams claimed by voices or still being handed back.
+        N.B. For testing only.
+    */
+    int getNumStreamsInUse() const;
+
     //==============================================================================
     static const char* getPluginName()                  { return NEEDS_TRANS("Sampler"); }
     static const char* xmlTypeName;
@@ -87,11 +124,15 @@ public:
         juce::String name;
         int keyNote = -1, minNote = 0, maxNote = 0;
         int fileStartSample = 0, fileLengthSamples = 0;
+        int numPreloadedSamples = 0;    ///< Less than fileLengthSamples if the rest is streamed.
+        double fileSampleRate = 44100.0;
         bool openEnded = false;
         float gainDb = 0, pan = 0;
         double startTime = 0, length = 0;
         AudioFile audioFile;
-        juce::AudioBuffer<float> audioData { 2, 64 };
+        SharedAudioDataStore::Ptr<juce::AudioBuffer<float>> audioData;    ///< Shared with other sounds using the same excerpt. Never null.
+
+        bool isStreamed() const noexcept    { return numPreloadedSamples < fileLengthSamples; }
 
     private:
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerSound)
@@ -99,15 +140,42 @@ public:
 
 private:
     //==============================================================================
+    struct SoundSet;
     struct SampledNote;
+    struct SampleStream;
+
+    struct PreviewNote
+    {
+        int note = 0;
+        bool isOn = false;
+    };
+
+    juce::CachedValue<bool> diskStreaming;
+    juce::CachedValue<int> streamingPreloadSize;
 
     juce::Colour colour;
     juce::CriticalSection lock;
-    juce::ReferenceCountedArray<SampledNote> playingNotes;
-    juce::OwnedArray<SamplerSound> soundList;
-    juce::BigInteger highlightedNotes;
+    juce::OwnedArray<SampleStream> streams;
+    juce::OwnedArray<SampledNote> voices;
+
+    // The current sounds. The audio thread gets these through realTimeSoundSet and
+    // the sets it may still be using are kept in soundSetsInUse so they're never
+    // deleted on the audio thread
+    std::shared_ptr<SoundSet> soundSet;
+    LockFreeObject<std::shared_ptr<SoundSet>> realTimeSoundSet;
+    std::vector<std::shared_ptr<SoundSet>> soundSetsInUse;
+    LambdaTimer releaseTimer;
+
+    choc::fifo::SingleReaderMultipleWriterFIFO<PreviewNote> previewNotes;
+    juce::BigInteger previewKeysDown, highlightedNotes;
+    std::atomic<bool> allNotesOffPending { false };
 
     juce::ValueTree getSound (int index) const;
+    SampledNote* findFreeVoice() const noexcept;
+    void addNote (const std::shared_ptr<SoundSet>&, const SamplerSound&, int note, float velocity, int sampleDelayFromBufferStart);
+    void stopNote (int note, int noteTimeSample);
+    void stopAllVoices();
+    void releaseUnusedSoundSets();
 
     void valueTreeChanged() override;
     void handleAsyncUpdate() override;
@@ -1533,6 +1533,12 @@ double ExternalPlugin::getTailLength() const
     return 0.0;
 }
 
+bool ExternalPlugin::canSleepWhenSilent()
+{
+    // Instruments might have their own sequencers or arpeggiators so can make sound without any input
+    return ! isSynth() && std::isfinite (getTailLength());
+}
+
 //==============================================================================
 juce::File ExternalPlugin::getFile() const
 {
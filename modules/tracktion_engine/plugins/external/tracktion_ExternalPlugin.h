@@ -84,6 +84,7 @@ public:
     double getLatencySeconds() override     { return latencySeconds; }
     bool noTail() override;
     double getTailLength() const override;
+    bool canSleepWhenSilent() override;
     void trackPropertiesChanged() override;
 
     juce::AudioProcessor* getWrappedAudioProcessor() const override     { return getAudioPluginInstance(); }
@@ -26,6 +26,8 @@ public:
     void runTest() override
     {
         runRestoreStateTests();
+        runTailLengthTests();
+        runImpulseResponseTests();
     }
 
 private:
@@ -84,6 +86,84 @@ private:
                     });
     }
 
+    void runTailLengthTests()
+    {
+        beginTest ("FourOsc tail includes its delay and reverb");
+
+        auto edit = Edit::createSingleTrackEdit (*Engine::getEngines()[0]);
+        auto synth = dynamic_cast<FourOscPlugin*> (edit->getPluginCache().createNewPlugin (FourOscPlugin::xmlTypeName, {}).get());
+        expect (synth != nullptr);
+
+        auto restore = [synth] (std::initializer_list<std::pair<juce::Identifier, juce::var>> properties)
+        {
+            juce::ValueTree preset (IDs::PLUGIN);
+            preset.setProperty (IDs::type, FourOscPlugin::xmlTypeName, nullptr);
+            preset.setProperty (IDs::ampRelease, 0.5f, nullptr);
+
+            for (auto& [name, value] : properties)
+                preset.setProperty (name, value, nullptr);
+
+            synth->restorePluginStateFromValueTree (preset);
+        };
+
+        restore ({ { IDs::delayOn, false }, { IDs::reverbOn, false } });
+        expectWithinAbsoluteError (synth->getTailLength(), 0.5, 0.0001);
+
+        // A beat at 120bpm with repeats 6dB quieter each time
+        restore ({ { IDs::delayOn, true }, { IDs::delayMix, 0.5f }, { IDs::delay, 1.0f },
+                   { IDs::delayFeedback, -6.0f }, { IDs::delayCrossfeed, -100.0f }, { IDs::reverbOn, false } });
+        const auto delayTail = synth->getTailLength() - 0.5;
+        expectGreaterThan (delayTail, 0.5 * 9.0);
+        expectLessThan (delayTail, 0.5 * 12.0);
+
+        // Repeats that don't decay never finish
+        restore ({ { IDs::delayOn, true }, { IDs::delayMix, 0.5f }, { IDs::delayFeedback, 0.0f },
+                   { IDs::delayCrossfeed, 0.0f }, { IDs::reverbOn, false } });
+        expect (! std::isfinite (synth->getTailLength()));
+
+        restore ({ { IDs::delayOn, false }, { IDs::reverbOn, true }, { IDs::reverbMix, 0.5f }, { IDs::reverbSize, 0.8f },
+                   { IDs::reverbAlgorithm, (int) ReverbAlgorithm::feedbackDelayNetwork } });
+        expectWithinAbsoluteError (synth->getTailLength(),
+                                   0.5 + ReverbPlugin::getDecayTimeSeconds (ReverbAlgorithm::feedbackDelayNetwork, 0.8f),
+                                   0.0001);
+    }
+
+    void runImpulseResponseTests()
+    {
+        beginTest ("Impulse responses are prepared in the background");
+
+        auto edit = Edit::createSingleTrackEdit (*Engine::getEngines()[0]);
+        auto ir = dynamic_cast<ImpulseResponsePlugin*> (edit->getPluginCache().createNewPlugin (ImpulseResponsePlugin::xmlTypeName, {}).get());
+        expect (ir != nullptr);
+        expect (! ir->isLoadingImpulseResponse());
+
+        auto waitForLoad = [ir]
+        {
+            for (int i = 0; i < 5000 && ir->isLoadingImpulseResponse(); ++i)
+                juce::Thread::sleep (1);
+
+            return ! ir->isLoadingImpulseResponse();
+        };
+
+        // Half a second decaying noise
+        juce::AudioBuffer<float> buffer (2, 22050);
+        juce::Random r (42);
+
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (chan, i, (r.nextFloat() * 2.0f - 1.0f) * (1.0f - i / (float) buffer.getNumSamples()));
+
+        expect (ir->loadImpulseResponse (std::move (buffer), 44100.0, 24));
+        expect (waitForLoad());
+        expectWithinAbsoluteError (ir->getTailLength(), 0.5, 0.0001);
+
+        // Changing the sample rate builds a new convolver from the same IR
+        ir->baseClassInitialise ({ TimePosition(), 48000.0, 512 });
+        expect (waitForLoad());
+        expectWithinAbsoluteError (ir->getTailLength(), 0.5, 0.0001);
+        ir->baseClassDeinitialise();
+    }
+
     struct ParamTest
     {
         const char* paramID;
@@ -93,6 +93,8 @@ Plugin::Plugin (PluginCreationInfo info)
     quickParamName.referTo (state, IDs::quickParamName, um);
     masterPluginID.referTo (state, IDs::masterPluginID, um);
     sidechainSourceID.referTo (state, IDs::sidechainSourceID, um);
+    oversamplingRatio.referTo (state, IDs::oversampling, um, 1);
+    oversamplingFactor = Oversampler::getFactorForRatio (oversamplingRatio.get());
 
     state.addListener (this);
 
@@ -372,12 +374,26 @@ bool Plugin::isClipEffectPlugin() const
     return isClipEffect;
 }
 
-void Plugin::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier& i)
+void Plugin::valueTreePropertyChanged (juce::ValueTree& v, const juce::Identifier& i)
 {
     if (i == IDs::process)
+    {
         processingChanged();
+    }
     else
+    {
+        if (v == state && i == IDs::oversampling)
+        {
+            oversamplingRatio.forceUpdateOfCachedValue();
+            oversamplingFactor = Oversampler::getFactorForRatio (oversamplingRatio.get());
+
+            // The oversampling changes the latency so the graph needs rebuilding
+            if (canOversample())
+                edit.restartPlayback();
+        }
+
         valueTreeChanged();
+    }
 }
 
 void Plugin::valueTreeChanged()
@@ -696,6 +712,44 @@ void Plugin::applyToBufferWithAutomation (const PluginRenderContext& pc)
     }
 }
 
+//==============================================================================
+Plugin::SleepStatistics Plugin::getSleepStatistics() const noexcept
+{
+    return { isAsleepFlag.load(),
+             numTimesSlept.load(),
+             sampleRate > 0.0 ? (double) numSamplesAsleep.load() / sampleRate : 0.0 };
+}
+
+void Plugin::resetSleepStatistics() noexcept
+{
+    numTimesSlept = 0;
+    numSamplesAsleep = 0;
+}
+
+void Plugin::updateSleepStatistics (bool isAsleep, int numSamples) noexcept
+{
+    if (! isAsleep)
+    {
+        isAsleepFlag.store (false, std::memory_order_relaxed);
+        return;
+    }
+
+    if (! isAsleepFlag.exchange (true, std::memory_order_relaxed))
+    {
+        numTimesSlept.fetch_add (1, std::memory_order_relaxed);
+        cpuUsageMs = 0.0;
+    }
+
+    numSamplesAsleep.fetch_add (numSamples, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Plugin::setOversamplingFactor (Oversampler::Factor newFactor)
+{
+    jassert (canOversample() || newFactor == Oversampler::Factor::none);
+    oversamplingRatio = (int) newFactor;
+}
+
 //==============================================================================
 bool Plugin::hasNameForMidiNoteNumber (int, int midiChannel, juce::String&)
 {
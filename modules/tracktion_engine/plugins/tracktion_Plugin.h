@@ -224,6 +224,52 @@ public:
     /** Returns the proportion of the current buffer size spent processing this plugin. */
     double getCpuUsage() const noexcept     { return juce::jlimit (0.0, 1.0, timeToCpuScale * cpuUsageMs.load()); }
 
+    //==============================================================================
+    /** Should return true if the plugin can be put to sleep when its input and output
+        have been silent for longer than its tail.
+        Sleeping plugins aren't called until they get some MIDI or non-silent audio so
+        plugins that can make sound on their own shouldn't return true here.
+        @see EngineBehaviour::shouldPluginsSleepWhenSilent
+    */
+    virtual bool canSleepWhenSilent()                   { return false; }
+
+    /** Describes how much a plugin has been put to sleep when it's been silent. */
+    struct SleepStatistics
+    {
+        bool isAsleep = false;              ///< Whether the plugin is currently asleep
+        int numTimesSlept = 0;              ///< The number of times the plugin has been put to sleep
+        double secondsAsleep = 0.0;         ///< The total time the plugin has spent asleep
+    };
+
+    /** Returns the plugin's sleep statistics. */
+    SleepStatistics getSleepStatistics() const noexcept;
+
+    /** Resets the number of times slept and time spent asleep. */
+    void resetSleepStatistics() noexcept;
+
+    /** @internal Called by the playback graph for each block to update the sleep statistics. */
+    void updateSleepStatistics (bool isAsleep, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Should return true if the plugin can oversample its processing to reduce aliasing.
+        Plugins that return true should run their nonlinear processing through an
+        Oversampler prepared with Oversampler::Factor::x8 in initialise(), set it to
+        getOversamplingFactor() at the start of each block, and include the latency
+        of getOversamplingFactor() in getLatencySeconds().
+    */
+    virtual bool canOversample()                        { return false; }
+
+    /** Sets the factor the plugin's processing is oversampled by.
+        The plugin switches to it on the audio thread and, as this changes the
+        plugin's latency, playback is restarted so the graph picks it up.
+    */
+    void setOversamplingFactor (Oversampler::Factor);
+
+    /** Returns the factor the plugin's processing is oversampled by.
+        This is safe to call from the audio thread.
+    */
+    Oversampler::Factor getOversamplingFactor() const noexcept   { return oversamplingFactor.load (std::memory_order_relaxed); }
+
     //==============================================================================
     /** This must return the number of output channels that the plugin will produce, given
         a number of input channels.
@@ -418,6 +464,8 @@ protected:
     juce::CachedValue<bool> frozen, processing;
     juce::CachedValue<juce::String> quickParamName;
     juce::CachedValue<EditItemID> masterPluginID, sidechainSourceID;
+    juce::CachedValue<int> oversamplingRatio;
+    std::atomic<Oversampler::Factor> oversamplingFactor { Oversampler::Factor::none };
 
     double sampleRate = 44100.0;
     int blockSizeSamples = 512;
@@ -441,6 +489,9 @@ private:
     std::atomic<int> initialiseCount { 0 };
     double timeToCpuScale = 0;
     std::atomic<double> cpuUsageMs { 0 };
+    std::atomic<bool> isAsleepFlag { false };
+    std::atomic<int> numTimesSlept { 0 };
+    std::atomic<int64_t> numSamplesAsleep { 0 };
     std::atomic<bool> isClipEffect { false };
 
     juce::ValueTree getConnectionsTree();
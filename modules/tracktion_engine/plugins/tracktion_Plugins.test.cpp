@@ -585,6 +585,156 @@ TEST_SUITE ("tracktion_engine")
 }
 #endif
 
+#if ENGINE_UNIT_TESTS_OVERSAMPLER
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("Changing the oversampling factor whilst playing")
+    {
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+
+        const auto duration = 3_td;
+        const auto transientPos = 2_tp;
+        const auto transientFile = graph::test_utilities::getTransientFile<juce::WavAudioFormat> (p.sampleRate, duration, transientPos, 0.5f);
+        const auto af = AudioFile (engine, transientFile->getFile());
+
+        auto track = getAudioTracks (*edit)[0];
+        insertWaveClip (*track, {}, transientFile->getFile(), { { 0_tp, duration } }, DeleteExistingClips::no);
+
+        auto compressor = insertNewPlugin<CompressorPlugin> (*track);
+        CHECK_EQ (compressor->getLatencySeconds(), 0.0);
+
+        auto player = test_utilities::createEnginePlayer (*edit, p, { af });
+        test_utilities::process (*player, 1_td);
+
+        // The plugin is already initialised so this has to switch factor without being prepared again
+        compressor->setOversamplingFactor (Oversampler::Factor::x4);
+        edit->dispatchPendingUpdatesSynchronously();
+
+        const auto expectedLatency = Oversampler::getLatencySamples (Oversampler::Factor::x4);
+        CHECK_EQ (juce::roundToInt (compressor->getLatencySeconds() * p.sampleRate), expectedLatency);
+
+        test_utilities::process (*player, 2_td);
+
+        // The transient should be delayed by the oversampler's filters
+        const auto output = player->getOutput();
+        choc::buffer::FrameCount peakFrame = 0;
+        float peak = 0.0f;
+
+        for (choc::buffer::FrameCount i = 0; i < output.getNumFrames(); ++i)
+        {
+            if (const auto level = std::abs (output.getSample (0, i)); level > peak)
+            {
+                peak = level;
+                peakFrame = i;
+            }
+        }
+
+        CHECK_GT (peak, 0.1f);
+        CHECK_LT (std::abs ((int) peakFrame - (int) (toSamples (transientPos, p.sampleRate) + expectedLatency)), 5);
+    }
+}
+#endif
+
+#if ENGINE_UNIT_TESTS_SAMPLER
+TEST_SUITE ("tracktion_engine")
+{
+    TEST_CASE ("Sampler streams are handed back when notes stop whilst starting")
+    {
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+        auto track = getAudioTracks (*edit)[0];
+
+        // Much longer than the preload so every note needs a stream
+        const auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (p.sampleRate, 5.0, 2);
+
+        auto sampler = insertNewPlugin<SamplerPlugin> (*track);
+        sampler->setDiskStreamingEnabled (true);
+        sampler->setStreamingPreloadSize (1024);
+        CHECK (sampler->addSound (sinFile->getFile().getFullPathName(), "sin", 0.0, 0.0, 0.0f).isEmpty());
+        juce::MessageManager::getInstance()->runDispatchLoopUntil (20);
+
+        // Lots of very short notes so most are released before their stream has opened the file
+        auto clip = track->insertMIDIClip ({ 0_tp, 8_tp }, nullptr);
+        auto& sequence = clip->getSequence();
+
+        for (int i = 0; i < 256; ++i)
+            sequence.addNote (72, BeatPosition::fromBeats (i / 16.0), BeatDuration::fromBeats (1.0 / 128.0), 100, 0, nullptr);
+
+        auto player = test_utilities::createEnginePlayer (*edit, p, { AudioFile (engine, sinFile->getFile()) });
+        test_utilities::process (*player, 9_td);
+
+        // Once the voices have stopped, the thread should return every stream to the pool
+        for (int i = 0; i < 200 && sampler->getNumStreamsInUse() > 0; ++i)
+            juce::Thread::sleep (10);
+
+        CHECK_EQ (sampler->getNumStreamsInUse(), 0);
+
+        // Notes only play if they can claim a stream
+        const auto output = player->getOutput();
+        float peak = 0.0f;
+
+        for (choc::buffer::FrameCount i = 0; i < output.getNumFrames(); ++i)
+            peak = std::max (peak, std::abs (output.getSample (0, i)));
+
+        CHECK_GT (peak, 0.1f);
+    }
+
+    TEST_CASE ("Sampler notes play whilst their streams are still being handed back")
+    {
+        HostedAudioDeviceInterface::Parameters p;
+
+        auto& engine = *Engine::getEngines()[0];
+        auto edit = engine::test_utilities::createTestEdit (engine, 1, Edit::EditRole::forEditing);
+        auto track = getAudioTracks (*edit)[0];
+
+        const auto sinFile = graph::test_utilities::getSinFile<juce::WavAudioFormat> (p.sampleRate, 5.0, 2);
+
+        auto sampler = insertNewPlugin<SamplerPlugin> (*track);
+        sampler->setDiskStreamingEnabled (true);
+        sampler->setStreamingPreloadSize (1024);
+        CHECK (sampler->addSound (sinFile->getFile().getFullPathName(), "sin", 0.0, 0.0, 0.0f).isEmpty());
+        juce::MessageManager::getInstance()->runDispatchLoopUntil (20);
+
+        // Short chords using every voice, each in a later block than the last one finished in but
+        // rendered faster than the thread can hand the streams back
+        const int numChords = 32;
+        auto clip = track->insertMIDIClip ({ 0_tp, 2_tp }, nullptr);
+        auto& sequence = clip->getSequence();
+
+        for (int chord = 0; chord < numChords; ++chord)
+            for (int note = 0; note < 32; ++note)
+                sequence.addNote (56 + note, BeatPosition::fromBeats (chord / 16.0), BeatDuration::fromBeats (1.0 / 128.0), 100, 0, nullptr);
+
+        auto player = test_utilities::createEnginePlayer (*edit, p, { AudioFile (engine, sinFile->getFile()) });
+        test_utilities::process (*player, 2_td);
+
+        // Every chord should be heard, even if it has to play from the preloaded head
+        const auto output = player->getOutput();
+
+        for (int chord = 0; chord < numChords; ++chord)
+        {
+            const auto start = static_cast<choc::buffer::FrameCount> (toSamples (TimePosition::fromSeconds (chord / 32.0), p.sampleRate));
+            float peak = 0.0f;
+
+            for (auto i = start; i < start + 150; ++i)
+                peak = std::max (peak, std::abs (output.getSample (0, i)));
+
+            CHECK_GT (peak, 0.1f);
+        }
+
+        for (int i = 0; i < 200 && sampler->getNumStreamsInUse() > 0; ++i)
+            juce::Thread::sleep (10);
+
+        CHECK_EQ (sampler->getNumStreamsInUse(), 0);
+    }
+}
+#endif
+
 } // namespace tracktion::inline engine
 
 #endif //TRACKTION_UNIT_TESTS
\ No newline at end of file
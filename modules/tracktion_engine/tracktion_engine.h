@@ -47,6 +47,7 @@
 #include <variant>
 #include <any>
 #include <shared_mutex>
+#include <condition_variable>
 #include <span>
 
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -280,6 +281,7 @@ namespace tracktion { inline namespace engine
     class DeviceManager;
     class GrooveTemplateManager;
     class Edit;
+    class BinaryEditFile;
     class Track;
     class Clip;
     class ClipOwner;
@@ -376,6 +378,7 @@ namespace tracktion { inline namespace engine
     class LaunchHandle;
     class LaunchQuantisation;
     class BufferedAudioFileManager;
+    class SharedAudioDataStore;
 }} // namespace tracktion { inline namespace engine
 
 #ifdef __GNUC__
@@ -425,6 +428,11 @@ namespace tracktion { inline namespace engine
 #include "utilities/tracktion_CurveEditor.h"
 #include "utilities/tracktion_Envelope.h"
 #include "utilities/tracktion_Oscillators.h"
+#include "utilities/tracktion_BiquadCascade.h"
+#include "utilities/tracktion_FDNReverb.h"
+#include "utilities/tracktion_SharedAudioDataStore.h"
+#include "utilities/tracktion_PartitionedConvolver.h"
+#include "utilities/tracktion_Oversampler.h"
 #include "utilities/tracktion_ScreenSaverDefeater.h"
 
 #include "project/tracktion_ProjectItemID.h"
@@ -435,6 +443,7 @@ namespace tracktion { inline namespace engine
 #include "model/edit/tracktion_EditItem.h"
 #include "model/automation/tracktion_AutomationMode.h"
 #include "model/automation/tracktion_AutomationCurve.h"
+#include "model/automation/tracktion_CompiledAutomationCurve.h"
 #include "model/automation/tracktion_AutomatableParameterTree.h"
 #include "model/automation/tracktion_AutomatableParameter.h"
 #include "model/automation/tracktion_AutomationCurveList.h"
@@ -507,6 +516,8 @@ namespace tracktion { inline namespace engine
 #include "model/edit/tracktion_PitchSetting.h"
 #include "model/edit/tracktion_PitchSequence.h"
 #include "model/edit/tracktion_Edit.h"
+#include "model/edit/tracktion_BinaryEditFile.h"
+#include "model/edit/tracktion_EditJournal.h"
 #include "model/edit/tracktion_EditFileOperations.h"
 #include "model/edit/tracktion_EditLoader.h"
 
@@ -538,6 +549,7 @@ namespace tracktion { inline namespace engine
 #include "audio_files/tracktion_AudioFormatManager.h"
 #include "audio_files/tracktion_AudioFileUtils.h"
 #include "audio_files/tracktion_AudioFifo.h"
+#include "audio_files/tracktion_ChunkedAudioRing.h"
 #include "audio_files/tracktion_RecordingThumbnailManager.h"
 #include "audio_files/formats/tracktion_FFmpegEncoderAudioFormat.h"
 #include "audio_files/formats/tracktion_FloatAudioFileFormat.h"
@@ -55,8 +55,11 @@ extern "C"
 #include "audio_files/tracktion_AudioFileUtils.cpp"
 #include "audio_files/tracktion_AudioFormatManager.cpp"
 #include "audio_files/tracktion_BufferedAudioReader.cpp"
+#include "audio_files/tracktion_ChunkedAudioRing.cpp"
+#include "audio_files/tracktion_ChunkedAudioRing.test.cpp"
 
 #include "midi/tracktion_MidiList.cpp"
+#include "midi/tracktion_MidiList.test.cpp"
 #include "midi/tracktion_MidiProgramManager.cpp"
 #include "midi/tracktion_Musicality.cpp"
 #include "midi/tracktion_SelectedMidiEvents.cpp"
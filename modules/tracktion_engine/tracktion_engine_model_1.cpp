@@ -47,6 +47,7 @@ using namespace std::literals;
 #include "model/automation/tracktion_AutomatableParameter.test.cpp"
 #include "model/automation/tracktion_MacroParameter.cpp"
 #include "model/automation/tracktion_AutomationCurve.cpp"
+#include "model/automation/tracktion_CompiledAutomationCurve.cpp"
 #include "model/automation/tracktion_AutomationCurveList.cpp"
 #include "model/automation/tracktion_AutomationCurveList.test.cpp"
 #include "model/automation/tracktion_AutomationMode.cpp"
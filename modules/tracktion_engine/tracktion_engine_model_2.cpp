@@ -62,8 +62,13 @@ using namespace std::literals;
 #include "model/edit/tracktion_TempoSetting.cpp"
 #include "model/edit/tracktion_TimecodeDisplayFormat.cpp"
 #include "model/edit/tracktion_TimeSigSetting.cpp"
+#include "model/edit/tracktion_BinaryEditFile.cpp"
+#include "model/edit/tracktion_BinaryEditFile.test.cpp"
+#include "model/edit/tracktion_EditJournal.cpp"
+#include "model/edit/tracktion_EditJournal.test.cpp"
 #include "model/edit/tracktion_EditSnapshot.cpp"
 #include "model/edit/tracktion_EditFileOperations.cpp"
+#include "model/edit/tracktion_EditFileOperations.test.cpp"
 #include "model/edit/tracktion_EditInsertPoint.cpp"
 #include "model/edit/tracktion_EditLoader.cpp"
 #include "model/edit/tracktion_EditLoader.test.cpp"
@@ -239,6 +239,7 @@ using namespace std::literals;
 #include "playback/graph/tracktion_RackNode.test.cpp"
 #include "playback/graph/tracktion_RackReturnNode.cpp"
 #include "playback/graph/tracktion_PluginNode.cpp"
+#include "playback/graph/tracktion_PluginNode.test.cpp"
 #include "playback/graph/tracktion_PluginNodeBenchmarks.test.cpp"
 #include "playback/graph/tracktion_ModifierNode.cpp"
 
@@ -278,6 +279,7 @@ using namespace std::literals;
 
 #include "playback/devices/tracktion_InputDevice.cpp"
 #include "playback/devices/tracktion_MidiInputDevice.cpp"
+#include "playback/devices/tracktion_MidiInputDevice.test.cpp"
 #include "playback/devices/tracktion_PhysicalMidiInputDevice.cpp"
 #include "playback/devices/tracktion_VirtualMidiInputDevice.cpp"
 #include "playback/devices/tracktion_MidiOutputDevice.cpp"
@@ -71,13 +71,22 @@ extern "C" char MacGetMacFSRefForREXDLL (FSRef* fsRef)
 
 #include "utilities/tracktion_AppFunctions.cpp"
 #include "utilities/tracktion_AudioUtilities.cpp"
+#include "utilities/tracktion_BiquadCascade.test.cpp"
 #include "utilities/tracktion_ConstrainedCachedValue.cpp"
 #include "utilities/tracktion_CrashTracer.cpp"
 #include "utilities/tracktion_CurveEditor.cpp"
 #include "utilities/tracktion_ExternalPlayheadSynchroniser.cpp"
 #include "utilities/tracktion_Envelope.cpp"
+#include "utilities/tracktion_Envelope.test.cpp"
 #include "utilities/tracktion_FileUtilities.cpp"
 #include "utilities/tracktion_Oscillators.cpp"
+#include "utilities/tracktion_Oscillators.test.cpp"
+#include "utilities/tracktion_FDNReverb.cpp"
+#include "utilities/tracktion_FDNReverb.test.cpp"
+#include "utilities/tracktion_PartitionedConvolver.cpp"
+#include "utilities/tracktion_PartitionedConvolver.test.cpp"
+#include "utilities/tracktion_Oversampler.cpp"
+#include "utilities/tracktion_Oversampler.test.cpp"
 #include "utilities/tracktion_PropertyStorage.cpp"
 #include "utilities/tracktion_ParameterHelpers.cpp"
 #include "utilities/tracktion_UIBehaviour.cpp"
@@ -86,6 +95,9 @@ extern "C" char MacGetMacFSRefForREXDLL (FSRef* fsRef)
 #include "utilities/tracktion_Threads.cpp"
 #include "utilities/tracktion_BinaryData.cpp"
 #include "utilities/tracktion_ScreenSaverDefeater.cpp"
+#include "utilities/tracktion_SharedAudioDataStore.cpp"
+#include "utilities/tracktion_SharedAudioDataStore.test.cpp"
+#include "utilities/tracktion_ValueTreeUtilities.test.cpp"
 
 #ifdef __GNUC__
  #pragma GCC diagnostic pop
@@ -112,6 +112,20 @@ struct AudioFadeCurve
         }
     }
 
+    /** Fills a buffer with the curve's gains between two alpha-positions.
+        The gain for sample i is taken at startAlpha + i * (endAlpha - startAlpha) / numSamples,
+        the same positions as renderBlock uses. The non-linear curves are read from precomputed
+        tables rather than calling sin/cos for every sample.
+    */
+    static void getGains (float* dest, int numSamples,
+                          float startAlpha, float endAlpha, Type) noexcept;
+
+    /** Linearly crossfades from a constant value to the existing samples in dest.
+        Sample i becomes value + (dest[i] - value) * (i / numSamples). This is used to
+        de-click discontinuities by ramping from the last sample played.
+    */
+    static void rampFromValue (float* dest, int numSamples, float value) noexcept;
+
     /** Calculates the two gain multipliers to use for mixing between two sources, given a position
         alpha from 0 to 1.0.
 
@@ -330,27 +330,99 @@ void convertFloatsToInts (juce::AudioBuffer<float>& buffer)
 }
 
 //==============================================================================
-struct OneChannelDestination
+/** Gain tables for the non-linear fade curves, linearly interpolated on lookup.
+    With this many points the interpolation error is well below -100dB.
+*/
+struct AudioFadeCurveTables
 {
-    float* channel0;
+    static constexpr int tableSize = 1024;
+
+    AudioFadeCurveTables()
+    {
+        for (int i = 0; i <= tableSize; ++i)
+        {
+            const auto alpha = i / (float) tableSize;
+            convex[(size_t) i]  = AudioFadeCurve::alphaToGain<AudioFadeCurve::Convex>  (alpha);
+            concave[(size_t) i] = AudioFadeCurve::alphaToGain<AudioFadeCurve::Concave> (alpha);
+            sCurve[(size_t) i]  = AudioFadeCurve::alphaToGain<AudioFadeCurve::SCurve>  (alpha);
+        }
+    }
 
-    inline void apply (float value) noexcept
+    const float* getTable (AudioFadeCurve::Type type) const noexcept
     {
-        *channel0++ *= value;
+        switch (type)
+        {
+            case AudioFadeCurve::convex:    return convex.data();
+            case AudioFadeCurve::concave:   return concave.data();
+            case AudioFadeCurve::sCurve:    return sCurve.data();
+            case AudioFadeCurve::linear:
+            default:                        return nullptr;
+        }
     }
+
+    static void lookup (const float* table, float* dest, int numSamples, double alpha, double delta) noexcept
+    {
+        // Work in table index space so each sample is just a truncation and a lerp
+        auto index = alpha * tableSize;
+        const auto indexDelta = delta * tableSize;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto pos = juce::jlimit (0.0, (double) tableSize, index);
+            const auto i1 = std::min ((int) pos, tableSize - 1);
+            const auto frac = (float) (pos - i1);
+            dest[i] = table[i1] + frac * (table[i1 + 1] - table[i1]);
+            index += indexDelta;
+        }
+    }
+
+    std::array<float, tableSize + 1> convex, concave, sCurve;
 };
 
-struct TwoChannelDestination
+static const AudioFadeCurveTables audioFadeCurveTables;
+
+void AudioFadeCurve::getGains (float* dest, int numSamples, float startAlpha, float endAlpha, Type type) noexcept
 {
-    float* channel0;
-    float* channel1;
+    jassert (numSamples > 0);
+    const auto delta = (endAlpha - (double) startAlpha) / numSamples;
 
-    inline void apply (float value) noexcept
+    if (auto table = audioFadeCurveTables.getTable (type))
     {
-        *channel0++ *= value;
-        *channel1++ *= value;
+        AudioFadeCurveTables::lookup (table, dest, numSamples, startAlpha, delta);
+        return;
     }
-};
+
+    jassert (type == linear);
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = (float) (startAlpha + i * delta);
+}
+
+void AudioFadeCurve::rampFromValue (float* dest, int numSamples, float value) noexcept
+{
+    const auto step = 1.0f / (float) numSamples;
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = value + (dest[i] - value) * ((float) i * step);
+}
+
+/** Calls fn with successive blocks of gains so the samples can be processed with vector ops. */
+template<typename Fn>
+static void forEachGainBlock (int numSamples, float startAlpha, float endAlpha, AudioFadeCurve::Type type, Fn&& fn) noexcept
+{
+    constexpr int maxBlockSize = 256;
+    float gains[maxBlockSize];
+    const auto delta = (endAlpha - (double) startAlpha) / numSamples;
+
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize)
+    {
+        const auto num = std::min (maxBlockSize, numSamples - offset);
+        const auto alpha1 = (float) (startAlpha + offset * delta);
+        const auto alpha2 = (float) (startAlpha + (offset + num) * delta);
+        AudioFadeCurve::getGains (gains, num, alpha1, alpha2, type);
+        fn (offset, gains, num);
+    }
+}
 
 void AudioFadeCurve::applyCrossfadeSection (juce::AudioBuffer<float>& buffer,
                                             int channel, int startSample, int numSamples,
@@ -358,10 +430,15 @@ void AudioFadeCurve::applyCrossfadeSection (juce::AudioBuffer<float>& buffer,
 {
     jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
 
-    if (! buffer.hasBeenCleared())
+    if (! buffer.hasBeenCleared() && numSamples > 0)
     {
-        OneChannelDestination d = { buffer.getWritePointer (channel, startSample) };
-        AudioFadeCurve::renderBlockForType (d, numSamples, startAlpha, endAlpha, type);
+        auto dest = buffer.getWritePointer (channel, startSample);
+
+        forEachGainBlock (numSamples, startAlpha, endAlpha, type,
+                          [dest] (int offset, const float* gains, int num)
+                          {
+                              juce::FloatVectorOperations::multiply (dest + offset, gains, num);
+                          });
     }
 }
 
@@ -373,32 +450,19 @@ void AudioFadeCurve::applyCrossfadeSection (juce::AudioBuffer<float>& buffer,
 
     if (! buffer.hasBeenCleared())
     {
-        if (buffer.getNumChannels() == 2)
-        {
-            TwoChannelDestination d = { buffer.getWritePointer (0, startSample),
-                                        buffer.getWritePointer (1, startSample) };
-
-            AudioFadeCurve::renderBlockForType (d, numSamples, startAlpha, endAlpha, type);
-        }
-        else
-        {
-            for (int i = buffer.getNumChannels(); --i >= 0;)
-                applyCrossfadeSection (buffer, i, startSample, numSamples, type, startAlpha, endAlpha);
-        }
+        const auto numChannels = buffer.getNumChannels();
+        auto channels = buffer.getArrayOfWritePointers();
+
+        // Calculate the gains once and apply them to all the channels
+        forEachGainBlock (numSamples, startAlpha, endAlpha, type,
+                          [channels, numChannels, startSample] (int offset, const float* gains, int num)
+                          {
+                              for (int i = 0; i < numChannels; ++i)
+                                  juce::FloatVectorOperations::multiply (channels[i] + startSample + offset, gains, num);
+                          });
     }
 }
 
-struct AddingFadeApplier
-{
-    float* dest;
-    const float* src;
-
-    inline void apply (float value) noexcept
-    {
-        *dest++ += *src++ * value;
-    }
-};
-
 void AudioFadeCurve::addWithCrossfade (juce::AudioBuffer<float>& dest,
                                        const juce::AudioBuffer<float>& src,
                                        int destChannel, int destStartIndex,
@@ -416,10 +480,14 @@ void AudioFadeCurve::addWithCrossfade (juce::AudioBuffer<float>& dest,
         }
         else
         {
-            AddingFadeApplier d = { dest.getWritePointer (destChannel, destStartIndex),
-                                    src.getReadPointer (sourceChannel, sourceStartIndex) };
-
-            AudioFadeCurve::renderBlockForType (d, numSamples, startAlpha, endAlpha, type);
+            auto d = dest.getWritePointer (destChannel, destStartIndex);
+            auto s = src.getReadPointer (sourceChannel, sourceStartIndex);
+
+            forEachGainBlock (numSamples, startAlpha, endAlpha, type,
+                              [d, s] (int offset, const float* gains, int num)
+                              {
+                                  juce::FloatVectorOperations::addWithMultiply (d + offset, s + offset, gains, num);
+                              });
         }
     }
 }
@@ -626,6 +694,73 @@ private:
 
 static PanLawTests panLawTests;
 
+//==============================================================================
+class AudioFadeCurveTests   : public juce::UnitTest
+{
+public:
+    AudioFadeCurveTests() : juce::UnitTest ("AudioFadeCurve", "Tracktion") {}
+
+    void runTest() override
+    {
+        beginTest ("Gain tables match the curves");
+        {
+            for (auto type : { AudioFadeCurve::linear, AudioFadeCurve::convex, AudioFadeCurve::concave, AudioFadeCurve::sCurve })
+            {
+                for (auto [startAlpha, endAlpha, numSamples] : { std::tuple (0.0f, 1.0f, 1000), std::tuple (1.0f, 0.0f, 37),
+                                                                std::tuple (0.25f, 0.3f, 512), std::tuple (0.9f, 0.1f, 4096) })
+                {
+                    std::vector<float> gains ((size_t) numSamples);
+                    AudioFadeCurve::getGains (gains.data(), numSamples, startAlpha, endAlpha, type);
+
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        auto alpha = startAlpha + i * (endAlpha - startAlpha) / numSamples;
+                        expectWithinAbsoluteError (gains[(size_t) i], AudioFadeCurve::alphaToGainForType (type, alpha), 1.0e-5f);
+                    }
+                }
+            }
+        }
+
+        beginTest ("Crossfade sections");
+        {
+            juce::AudioBuffer<float> buffer (3, 1000), src (1, 1000);
+            buffer.clear();
+
+            for (int c = 0; c < buffer.getNumChannels(); ++c)
+                juce::FloatVectorOperations::fill (buffer.getWritePointer (c), 0.5f, buffer.getNumSamples());
+
+            src.copyFrom (0, 0, buffer, 0, 0, buffer.getNumSamples());
+
+            AudioFadeCurve::applyCrossfadeSection (buffer, 100, 800, AudioFadeCurve::convex, 0.0f, 1.0f);
+            AudioFadeCurve::addWithCrossfade (buffer, src, 2, 0, 0, 0, 1000, AudioFadeCurve::sCurve, 1.0f, 0.0f);
+
+            for (int c = 0; c < 2; ++c)
+            {
+                expectEquals (buffer.getSample (c, 0), 0.5f);
+                expectEquals (buffer.getSample (c, 100), 0.0f);
+                expectWithinAbsoluteError (buffer.getSample (c, 500), 0.5f * AudioFadeCurve::alphaToGain<AudioFadeCurve::Convex> (0.5f), 1.0e-5f);
+                expectEquals (buffer.getSample (c, 999), 0.5f);
+            }
+
+            expectWithinAbsoluteError (buffer.getSample (2, 0), 1.0f, 1.0e-5f);
+            expectWithinAbsoluteError (buffer.getSample (2, 999), 0.5f + 0.5f * AudioFadeCurve::alphaToGain<AudioFadeCurve::SCurve> (0.001f), 1.0e-5f);
+        }
+
+        beginTest ("Ramp from value");
+        {
+            float samples[40];
+            std::fill (std::begin (samples), std::end (samples), 1.0f);
+            AudioFadeCurve::rampFromValue (samples, 40, -1.0f);
+
+            expectEquals (samples[0], -1.0f);
+            expectWithinAbsoluteError (samples[20], 0.0f, 1.0e-6f);
+            expectWithinAbsoluteError (samples[39], 1.0f - 2.0f / 40.0f, 1.0e-6f);
+        }
+    }
+};
+
+static AudioFadeCurveTests audioFadeCurveTests;
+
 #endif // TRACKTION_UNIT_TESTS
 
 }} // namespace tracktion { inline namespace engine
@@ -0,0 +1,166 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+/** The coefficients of a biquad filter, normalised so that a0 is 1. */
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+    /** Converts a set of juce::IIRCoefficients. */
+    static BiquadCoefficients fromIIRCoefficients (const juce::IIRCoefficients& c) noexcept
+    {
+        return { c.coefficients[0], c.coefficients[1], c.coefficients[2], c.coefficients[3], c.coefficients[4] };
+    }
+
+    /** Returns the magnitude of the filter's response at a frequency. */
+    double getMagnitudeForFrequency (double frequency, double sampleRate) const noexcept
+    {
+        const auto z1 = std::polar (1.0, -juce::MathConstants<double>::twoPi * frequency / sampleRate);
+        const auto z2 = z1 * z1;
+
+        return std::abs (((double) b0 + (double) b1 * z1 + (double) b2 * z2)
+                          / (1.0 + (double) a1 * z1 + (double) a2 * z2));
+    }
+
+    bool operator== (const BiquadCoefficients&) const = default;
+};
+
+//==============================================================================
+/**
+    A cascade of biquad filters applied to up to four channels at once.
+
+    The filters use transposed direct form II. Rather than running a filter per
+    channel, each channel is held in a lane of a small fixed-size array and every
+    band is applied to all the lanes with the same arithmetic, so the compiler
+    can process the channels together in a single vector register.
+
+    Bands that are disabled are skipped and their state is cleared.
+*/
+template<size_t maxNumBands>
+class BiquadCascade
+{
+public:
+    static constexpr int maxNumChannels = 4;
+
+    /** Creates a cascade with all the bands disabled. */
+    BiquadCascade() = default;
+
+    /** Sets a band's coefficients. This is cheap so can be called for every block. */
+    void setCoefficients (size_t band, const BiquadCoefficients& c) noexcept    { coefficients[band] = c; }
+
+    /** Returns a band's coefficients. */
+    const BiquadCoefficients& getCoefficients (size_t band) const noexcept      { return coefficients[band]; }
+
+    /** Enables or disables a band. Disabling a band clears its state. */
+    void setBandEnabled (size_t band, bool shouldBeEnabled) noexcept;
+
+    /** Returns true if a band is enabled. */
+    bool isBandEnabled (size_t band) const noexcept                             { return enabled[band]; }
+
+    /** Clears the state of all the bands. */
+    void reset() noexcept;
+
+    /** Applies the enabled bands, in order, to some channels of audio. */
+    void process (float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    using Lanes = std::array<float, (size_t) maxNumChannels>;
+
+    std::array<BiquadCoefficients, maxNumBands> coefficients;
+    std::array<Lanes, maxNumBands> state1 {}, state2 {};
+    std::array<bool, maxNumBands> enabled {};
+};
+
+
+//==============================================================================
+//        _        _           _  _
+//     __| |  ___ | |_   __ _ (_)| | ___
+//    / _` | / _ \| __| / _` || || |/ __|
+//   | (_| ||  __/| |_ | (_| || || |\__ \ _  _  _
+//    \__,_| \___| \__| \__,_||_||_||___/(_)(_)(_)
+//
+//   Code beyond this point is implementation detail...
+//
+//==============================================================================
+template<size_t maxNumBands>
+void BiquadCascade<maxNumBands>::setBandEnabled (size_t band, bool shouldBeEnabled) noexcept
+{
+    if (! shouldBeEnabled)
+    {
+        state1[band] = {};
+        state2[band] = {};
+    }
+
+    enabled[band] = shouldBeEnabled;
+}
+
+template<size_t maxNumBands>
+void BiquadCascade<maxNumBands>::reset() noexcept
+{
+    state1 = {};
+    state2 = {};
+}
+
+template<size_t maxNumBands>
+void BiquadCascade<maxNumBands>::process (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert (numChannels <= maxNumChannels);
+    numChannels = std::min (numChannels, maxNumChannels);
+
+    std::array<size_t, maxNumBands> bands;
+    size_t numBands = 0;
+
+    for (size_t band = 0; band < maxNumBands; ++band)
+        if (enabled[band])
+            bands[numBands++] = band;
+
+    if (numBands == 0 || numChannels <= 0)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    // Local copies so the state can stay in registers, it can't alias the channel data
+    auto s1 = state1, s2 = state2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        Lanes x {};
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            x[(size_t) chan] = channels[chan][i];
+
+        for (size_t n = 0; n < numBands; ++n)
+        {
+            const auto band = bands[n];
+            const auto c = coefficients[band];
+            auto& z1 = s1[band];
+            auto& z2 = s2[band];
+
+            for (size_t lane = 0; lane < x.size(); ++lane)
+            {
+                const auto y = c.b0 * x[lane] + z1[lane];
+                z1[lane] = c.b1 * x[lane] - c.a1 * y + z2[lane];
+                z2[lane] = c.b2 * x[lane] - c.a2 * y;
+                x[lane] = y;
+            }
+        }
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            channels[chan][i] = x[(size_t) chan];
+    }
+
+    state1 = s1;
+    state2 = s2;
+}
+
+} // namespace tracktion::inline engine
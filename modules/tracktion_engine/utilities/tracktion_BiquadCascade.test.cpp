@@ -0,0 +1,238 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_BIQUAD_CASCADE) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_BIQUAD_CASCADE)
+
+namespace tracktion::inline engine
+{
+
+namespace biquad_cascade_test_utilities
+{
+    /** Returns the coefficients of a typical four band EQ. */
+    inline std::array<juce::IIRCoefficients, 4> createEQCoefficients (double sampleRate)
+    {
+        return { juce::IIRCoefficients::makeLowShelf (sampleRate, 80.0, 0.5, 2.0f),
+                 juce::IIRCoefficients::makePeakFilter (sampleRate, 1'000.0, 1.0, 0.5f),
+                 juce::IIRCoefficients::makePeakFilter (sampleRate, 5'000.0, 2.0, 3.0f),
+                 juce::IIRCoefficients::makeHighShelf (sampleRate, 12'000.0, 0.5, 0.25f) };
+    }
+
+    /** Returns a buffer of noise. */
+    inline juce::AudioBuffer<float> createNoise (int numChannels, int numSamples, juce::Random& r)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (chan, i, r.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_BIQUAD_CASCADE
+
+//==============================================================================
+//==============================================================================
+class BiquadCascadeTests  : public juce::UnitTest
+{
+public:
+    BiquadCascadeTests()
+        : juce::UnitTest ("BiquadCascade", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using namespace biquad_cascade_test_utilities;
+        constexpr double sampleRate = 44'100.0;
+        const auto eqCoefficients = createEQCoefficients (sampleRate);
+
+        beginTest ("Matches separate filters");
+        {
+            for (int numChannels : { 1, 2 })
+            {
+                juce::Random r (42);
+                const auto input = createNoise (numChannels, 10'000, r);
+
+                auto expected = input;
+
+                for (int chan = 0; chan < numChannels; ++chan)
+                {
+                    for (auto& c : eqCoefficients)
+                    {
+                        juce::IIRFilter filter;
+                        filter.setCoefficients (c);
+                        filter.processSamples (expected.getWritePointer (chan), expected.getNumSamples());
+                    }
+                }
+
+                BiquadCascade<4> cascade;
+
+                for (size_t band = 0; band < eqCoefficients.size(); ++band)
+                {
+                    cascade.setCoefficients (band, BiquadCoefficients::fromIIRCoefficients (eqCoefficients[band]));
+                    cascade.setBandEnabled (band, true);
+                }
+
+                auto output = input;
+
+                for (int start = 0; start < output.getNumSamples();)
+                {
+                    const int numThisTime = std::min (output.getNumSamples() - start, r.nextInt ({ 1, 700 }));
+                    float* channels[] = { output.getWritePointer (0, start), output.getWritePointer (numChannels - 1, start) };
+                    cascade.process (channels, numChannels, numThisTime);
+                    start += numThisTime;
+                }
+
+                float maxError = 0.0f;
+
+                for (int chan = 0; chan < numChannels; ++chan)
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        maxError = std::max (maxError, std::abs (expected.getSample (chan, i) - output.getSample (chan, i)));
+
+                expectLessThan (maxError, 1.0e-4f, "Num channels: " + juce::String (numChannels));
+            }
+        }
+
+        beginTest ("Disabled bands are skipped");
+        {
+            juce::Random r (42);
+            const auto input = createNoise (2, 1'000, r);
+
+            BiquadCascade<4> cascade;
+            cascade.setCoefficients (0, BiquadCoefficients::fromIIRCoefficients (eqCoefficients[0]));
+
+            auto output = input;
+            cascade.process (output.getArrayOfWritePointers(), 2, output.getNumSamples());
+
+            for (int chan = 0; chan < 2; ++chan)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    expectEquals (output.getSample (chan, i), input.getSample (chan, i));
+        }
+
+        beginTest ("Magnitude response");
+        {
+            // Measures the gain of a sine after the filter has settled
+            for (size_t band = 0; band < eqCoefficients.size(); ++band)
+            {
+                const auto c = BiquadCoefficients::fromIIRCoefficients (eqCoefficients[band]);
+
+                for (double frequency : { 50.0, 1'000.0, 5'000.0, 15'000.0 })
+                {
+                    BiquadCascade<1> cascade;
+                    cascade.setCoefficients (0, c);
+                    cascade.setBandEnabled (0, true);
+
+                    juce::AudioBuffer<float> buffer (1, 44'100);
+
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        buffer.setSample (0, i, (float) std::sin (juce::MathConstants<double>::twoPi * frequency * i / sampleRate));
+
+                    cascade.process (buffer.getArrayOfWritePointers(), 1, buffer.getNumSamples());
+
+                    const auto measured = buffer.getRMSLevel (0, 22'050, 22'050) * std::sqrt (2.0f);
+                    expectWithinAbsoluteError ((float) c.getMagnitudeForFrequency (frequency, sampleRate), measured, 0.01f);
+                }
+            }
+        }
+    }
+};
+
+static BiquadCascadeTests biquadCascadeTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_BIQUAD_CASCADE
+
+//==============================================================================
+//==============================================================================
+class BiquadCascadeBenchmarks  : public juce::UnitTest
+{
+public:
+    BiquadCascadeBenchmarks()
+        : juce::UnitTest ("BiquadCascade", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Benchmark: Four band EQ");
+        {
+            constexpr double sampleRate = 48'000.0;
+            juce::Random r (42);
+            const auto coefficients = biquad_cascade_test_utilities::createEQCoefficients (sampleRate);
+            const auto input = biquad_cascade_test_utilities::createNoise (2, (int) sampleRate * 10, r);
+            const std::string suffix = " (10s stereo, 48KHz, 512 sample blocks)";
+
+            {
+                juce::IIRFilter filters[2][4];
+
+                for (auto& channelFilters : filters)
+                    for (size_t band = 0; band < coefficients.size(); ++band)
+                        channelFilters[band].setCoefficients (coefficients[band]);
+
+                auto buffer = input;
+                ScopedBenchmark sb (getDescription ("juce::IIRFilter" + suffix));
+
+                processInBlocks (buffer, [&] (float* const* channels, int numSamples)
+                {
+                    for (int chan = 0; chan < 2; ++chan)
+                        for (auto& filter : filters[chan])
+                            filter.processSamples (channels[chan], numSamples);
+                });
+            }
+
+            {
+                BiquadCascade<4> cascade;
+
+                for (size_t band = 0; band < coefficients.size(); ++band)
+                {
+                    cascade.setCoefficients (band, BiquadCoefficients::fromIIRCoefficients (coefficients[band]));
+                    cascade.setBandEnabled (band, true);
+                }
+
+                auto buffer = input;
+                ScopedBenchmark sb (getDescription ("BiquadCascade" + suffix));
+
+                processInBlocks (buffer, [&] (float* const* channels, int numSamples)
+                {
+                    cascade.process (channels, 2, numSamples);
+                });
+            }
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    template<typename ProcessFunction>
+    static void processInBlocks (juce::AudioBuffer<float>& buffer, ProcessFunction&& process)
+    {
+        for (int start = 0; start + 512 <= buffer.getNumSamples(); start += 512)
+        {
+            float* channels[] = { buffer.getWritePointer (0, start), buffer.getWritePointer (1, start) };
+            process (channels, 512);
+        }
+    }
+};
+
+static BiquadCascadeBenchmarks biquadCascadeBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -112,6 +112,7 @@ Engine::~Engine()
     audioFileFormatManager.reset();
     backToArrangerUpdateTimer.reset();
     bufferedAudioFileManager.reset();
+    sharedAudioDataStore.reset();
 
     instance = nullptr;
     engines.removeFirstMatchingValue (this);
@@ -283,6 +284,14 @@ BufferedAudioFileManager& Engine::getBufferedAudioFileManager()
     return *bufferedAudioFileManager;
 }
 
+SharedAudioDataStore& Engine::getSharedAudioDataStore()
+{
+    if (! sharedAudioDataStore)
+        sharedAudioDataStore = std::make_unique<SharedAudioDataStore>();
+
+    return *sharedAudioDataStore;
+}
+
 bool EngineBehaviour::shouldLoadPlugin (ExternalPlugin& p)
 {
     return p.edit.shouldLoadPlugins();
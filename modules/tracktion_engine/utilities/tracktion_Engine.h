@@ -79,6 +79,7 @@ public:
     ProjectManager& getProjectManager() const;                          ///< Returns the ProjectManager instance.
     SharedTimer& getBackToArrangerUpdateTimer() const;                  ///< Returns the SharedTimer instance.
     BufferedAudioFileManager& getBufferedAudioFileManager();            ///< Returns the BufferedAudioFileManager instance
+    SharedAudioDataStore& getSharedAudioDataStore();                    ///< Returns the SharedAudioDataStore instance
 
     using WeakRef = juce::WeakReference<Engine>;
 
@@ -108,6 +109,7 @@ private:
     mutable std::unique_ptr<WarpTimeFactory> warpTimeFactory;
     mutable std::unique_ptr<SharedTimer> backToArrangerUpdateTimer;
     std::unique_ptr<BufferedAudioFileManager> bufferedAudioFileManager;
+    std::unique_ptr<SharedAudioDataStore> sharedAudioDataStore;
 
     JUCE_DECLARE_WEAK_REFERENCEABLE (Engine)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Engine)
@@ -101,12 +101,18 @@ public:
     virtual void describeWaveDevices (std::vector<WaveDeviceDescription>&, juce::AudioIODevice&, bool /*isInput*/) {}
 
     /// Should return if plugins which have been bypassed should be included in the playback graph.
-    /// By default this is false and bypassed plugins will still call processBypassed and introduce
-    /// the same latency as if they weren't.
-    /// But by returning false here, you can opt to remove them from the playback graph entirely
+    /// By default this is false and bypassed plugins stay in the graph and introduce the same latency
+    /// as if they weren't. They're only called until their tail has finished, after which they're
+    /// suspended and use no CPU, and they can be re-enabled without rebuilding the graph.
+    /// But by returning true here, you can opt to remove them from the playback graph entirely
     /// which means they won't introduce latency which can be useful for tracking.
     virtual bool shouldBypassedPluginsBeRemovedFromPlaybackGraph()                  { return false; }
 
+    /// If this returns true, plugins that support it (see Plugin::canSleepWhenSilent) stop being
+    /// processed once their input and output have been silent for longer than their tail.
+    /// They're woken up again as soon as they get some MIDI or non-silent audio.
+    virtual bool shouldPluginsSleepWhenSilent()                                     { return true; }
+
     /// Whether or not to include muted track contents in aux send plugins.
     /// Returning true here enables you to still listen to return busses when send tracks are
     /// muted or other tracks are soloed.
@@ -147,6 +153,11 @@ public:
     /// The default filename that will be used for audio input devices if not overridden
     virtual juce::String getDefaultAudioRecordingFilePattern()                      { return "%projectdir%/%edit%_%track%_Take_%take%"; }
 
+    /// The number of threads used to write audio recordings to disk. Each file is
+    /// always written by the same thread so more than one only helps when recording
+    /// several inputs at once.
+    virtual int getNumberOfRecordingWriterThreads()                                 { return juce::jlimit (1, 4, juce::SystemStats::getNumCpus() / 2); }
+
     //==============================================================================
     // Model-related options
 
@@ -159,6 +170,10 @@ public:
     // Notifies the host application that an edit has just been saved
     virtual void editHasBeenSaved (Edit&, juce::File)                               {}
 
+    /// If this returns true, Edits are saved in the chunked BinaryEditFile format rather than as XML.
+    /// Both formats can always be loaded.
+    virtual bool saveEditsAsBinary()                                                { return false; }
+
     /// Should return the maximum number of elements that can be added to an Edit.
     virtual EditLimits getEditLimits()                                              { return {}; }
 
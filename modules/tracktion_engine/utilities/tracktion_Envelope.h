@@ -145,16 +145,22 @@ public:
     {
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
-        auto numChannels = buffer.getNumChannels();
+        // The envelope is generated in small chunks so it can be applied to each channel in one go
+        constexpr int chunkSize = 64;
+        FloatType envelope[chunkSize];
 
-        while (--numSamples >= 0)
+        while (numSamples > 0)
         {
-            auto env = getNextSample();
+            const int numThisTime = std::min (numSamples, chunkSize);
 
-            for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            for (int i = 0; i < numThisTime; ++i)
+                envelope[i] = static_cast<FloatType> (getNextSample());
 
-            ++startSample;
+            for (int i = buffer.getNumChannels(); --i >= 0;)
+                juce::FloatVectorOperations::multiply (buffer.getWritePointer (i, startSample), envelope, numThisTime);
+
+            startSample += numThisTime;
+            numSamples -= numThisTime;
         }
     }
 
@@ -381,6 +387,76 @@ public:
         return envelopeVal;
     }
 
+    /** Advances the envelope by a number of samples without generating them.
+        This is much quicker than calling getNextSample() for each sample so can be
+        used when only the envelope value at the start of each block is needed.
+        @see getNextSample
+     */
+    void skip (int numSamples)
+    {
+        while (numSamples > 0 && currentState != State::idle)
+        {
+            // Returns the number of samples before the envelope reaches a target
+            auto getNumSteps = [] (float distance, float rate)
+            {
+                return std::max (1, (int) std::ceil (distance / rate));
+            };
+
+            if (currentState == State::attack && attackRate > 0.0f)
+            {
+                const auto numSteps = getNumSteps (1.0f - envelopeVal, attackRate);
+
+                if (numSteps > numSamples)
+                {
+                    envelopeVal += attackRate * (float) numSamples;
+                    return;
+                }
+
+                numSamples -= numSteps;
+                envelopeVal = 1.0f;
+                currentState = decayRate > 0.0f ? State::decay : State::sustain;
+            }
+            else if (currentState == State::decay && decayRate > 0.0f)
+            {
+                const auto numSteps = getNumSteps (envelopeVal - sustainLevel, decayRate);
+
+                if (numSteps > numSamples)
+                {
+                    envelopeVal -= decayRate * (float) numSamples;
+                    return;
+                }
+
+                numSamples -= numSteps;
+                envelopeVal = sustainLevel;
+                currentState = State::sustain;
+            }
+            else if (currentState == State::release && releaseRate > 0.0f)
+            {
+                const auto numSteps = getNumSteps (envelopeVal, releaseRate);
+
+                if (numSteps > numSamples)
+                {
+                    envelopeVal -= releaseRate * (float) numSamples;
+                    return;
+                }
+
+                numSamples -= numSteps;
+                reset();
+            }
+            else if (currentState == State::sustain)
+            {
+                envelopeVal = sustainLevel;
+                return;
+            }
+            else
+            {
+                // Stages with a zero rate finish in a single sample
+                getNextSample();
+                --numSamples;
+            }
+        }
+    }
+
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
         @see getNextSample
@@ -390,16 +466,22 @@ public:
     {
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
-        auto numChannels = buffer.getNumChannels();
+        // The envelope is generated in small chunks so it can be applied to each channel in one go
+        constexpr int chunkSize = 64;
+        FloatType envelope[chunkSize];
 
-        while (--numSamples >= 0)
+        while (numSamples > 0)
         {
-            auto env = getNextSample();
+            const int numThisTime = std::min (numSamples, chunkSize);
+
+            for (int i = 0; i < numThisTime; ++i)
+                envelope[i] = static_cast<FloatType> (getNextSample());
 
-            for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+            for (int i = buffer.getNumChannels(); --i >= 0;)
+                juce::FloatVectorOperations::multiply (buffer.getWritePointer (i, startSample), envelope, numThisTime);
 
-            ++startSample;
+            startSample += numThisTime;
+            numSamples -= numThisTime;
         }
     }
 
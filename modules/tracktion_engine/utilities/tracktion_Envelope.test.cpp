@@ -0,0 +1,90 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_ENVELOPE
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class LinEnvelopeTests  : public juce::UnitTest
+{
+public:
+    LinEnvelopeTests()
+        : juce::UnitTest ("LinEnvelope", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Skipping matches generating each sample");
+        {
+            const LinEnvelope::Parameters parameterSets[] =
+            {
+                { 0.05f,  0.1f,   0.5f, 0.2f },
+                { 0.0f,   0.1f,   0.5f, 0.2f },     // No attack
+                { 0.05f,  0.0f,   0.5f, 0.2f },     // No decay
+                { 0.05f,  0.1f,   0.0f, 0.2f },     // No sustain
+                { 0.05f,  0.1f,   0.5f, 0.0f },     // No release
+                { 0.001f, 0.001f, 0.3f, 0.001f },   // Stages shorter than a block
+            };
+
+            for (auto& parameters : parameterSets)
+                for (int blockSize : { 1, 7, 64, 512, 3'000 })
+                    expectSkipMatchesGeneratingEachSample (parameters, blockSize);
+        }
+    }
+
+private:
+    void expectSkipMatchesGeneratingEachSample (const LinEnvelope::Parameters& parameters, int blockSize)
+    {
+        constexpr double sampleRate = 44'100.0;
+        constexpr int numSamples = 44'100, noteOffSample = 22'050;
+
+        LinEnvelope skipped, generated;
+
+        for (auto envelope : { &skipped, &generated })
+        {
+            envelope->setSampleRate (sampleRate);
+            envelope->setParameters (parameters);
+            envelope->noteOn();
+        }
+
+        float maxError = 0.0f;
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            if (noteOffSample >= start && noteOffSample < start + blockSize)
+            {
+                skipped.noteOff();
+                generated.noteOff();
+            }
+
+            skipped.skip (blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+                generated.getNextSample();
+
+            maxError = std::max (maxError, std::abs (skipped.getEnvelopeValue() - generated.getEnvelopeValue()));
+        }
+
+        // Stepping a sample at a time accumulates rounding errors so it can reach
+        // the end of a stage a sample later, but never by more than one step
+        expectLessThan (maxError, 1.0e-4f, "Block size: " + juce::String (blockSize));
+        expect (skipped.getState() == LinEnvelope::State::idle);
+        expect (generated.getState() == LinEnvelope::State::idle);
+    }
+};
+
+static LinEnvelopeTests linEnvelopeTests;
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -0,0 +1,359 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace fdn_reverb
+{
+    // Mutually prime-ish lengths so the echoes don't line up
+    static constexpr std::array<float, 8> delayTimesMs { 29.8f, 34.9f, 41.3f, 46.7f, 53.1f, 59.9f, 66.7f, 73.3f };
+    static constexpr std::array<float, 8> modulationRatesHz { 0.31f, 0.37f, 0.43f, 0.47f, 0.53f, 0.59f, 0.61f, 0.67f };
+    static constexpr float modulationDepthMs = 0.3f;
+
+    // Rows of a Hadamard matrix so the inputs and outputs are decorrelated
+    static constexpr std::array<float, 8> inputSignsLeft   { 1.0f, -1.0f,  1.0f, -1.0f,  1.0f, -1.0f,  1.0f, -1.0f };
+    static constexpr std::array<float, 8> inputSignsRight  { 1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f };
+    static constexpr std::array<float, 8> outputSignsLeft  { 1.0f,  1.0f,  1.0f,  1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+    static constexpr std::array<float, 8> outputSignsRight { 1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f };
+
+    // Similar levels to juce::Reverb so the two sound alike at the same settings
+    static constexpr float fixedInputGain = 0.1f;
+    static constexpr float wetScale = 3.0f;
+    static constexpr float dryScale = 2.0f;
+    static constexpr float maxDamping = 0.4f;
+
+    /** Returns the time for the reverb to decay by 60dB for a room size. */
+    inline float getDecayTimeSeconds (float roomSize) noexcept
+    {
+        return 0.3f * std::pow (40.0f, roomSize);
+    }
+
+    /** Mixes a block of each line with a Hadamard matrix.
+        This isn't normalised, the lines should be scaled by 1 / sqrt (numLines) first.
+    */
+    template<typename Lines>
+    inline void applyHadamard (Lines& lines, int numSamples) noexcept
+    {
+        for (size_t h = 1; h < lines.size(); h *= 2)
+        {
+            for (size_t i = 0; i < lines.size(); i += h * 2)
+            {
+                for (size_t j = i; j < i + h; ++j)
+                {
+                    auto a = lines[j].data();
+                    auto b = lines[j + h].data();
+
+                    for (int n = 0; n < numSamples; ++n)
+                    {
+                        const auto sum = a[n] + b[n];
+                        b[n] = a[n] - b[n];
+                        a[n] = sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+FDNReverb::FDNReverb()
+{
+    setSampleRate (44100.0);
+}
+
+void FDNReverb::setParameters (const Parameters& newParams)
+{
+    parameters = newParams;
+    updateGainTargets();
+}
+
+void FDNReverb::setSampleRate (double newSampleRate)
+{
+    jassert (newSampleRate > 0.0);
+    sampleRate = newSampleRate;
+
+    const auto samplesPerMs = (float) (sampleRate / 1000.0);
+    modulationDepth = fdn_reverb::modulationDepthMs * samplesPerMs;
+
+    for (size_t i = 0; i < numLines; ++i)
+    {
+        baseDelays[i] = fdn_reverb::delayTimesMs[i] * samplesPerMs;
+
+        // The LFOs are rotated by this much on each update
+        const auto increment = juce::MathConstants<double>::twoPi * fdn_reverb::modulationRatesHz[i] * numSamplesPerUpdate / sampleRate;
+        rotationSin[i] = (float) std::sin (increment);
+        rotationCos[i] = (float) std::cos (increment);
+    }
+
+    const auto maxDelay = *std::max_element (baseDelays.begin(), baseDelays.end()) + modulationDepth * 2.0f;
+    bufferSize = juce::nextPowerOfTwo ((int) std::ceil (maxDelay) + numSamplesPerUpdate + 4);
+    delayBuffer.resize ((size_t) bufferSize * numLines);
+
+    const double smoothTime = 0.01;
+
+    for (auto smoother : { &decaySmoother, &dampingSmoother, &inputGainSmoother, &wetGain1, &wetGain2, &dryGain })
+        smoother->reset (sampleRate, smoothTime);
+
+    reset();
+}
+
+float FDNReverb::getDecayTimeSeconds (float roomSize) noexcept
+{
+    return fdn_reverb::getDecayTimeSeconds (roomSize);
+}
+
+void FDNReverb::reset()
+{
+    std::fill (delayBuffer.begin(), delayBuffer.end(), 0.0f);
+    filterStates.fill (0.0f);
+    writePosition = 0;
+
+    for (size_t i = 0; i < numLines; ++i)
+    {
+        const auto phase = juce::MathConstants<float>::twoPi * (float) i / (float) numLines;
+        modulationSin[i] = std::sin (phase);
+        modulationCos[i] = std::cos (phase);
+    }
+
+    roomSizeForGains = -1.0f;
+
+    updateGainTargets();
+
+    for (auto smoother : { &decaySmoother, &dampingSmoother, &inputGainSmoother, &wetGain1, &wetGain2, &dryGain })
+        smoother->setCurrentAndTargetValue (smoother->getTargetValue());
+
+    updateLines();
+    numSamplesUntilUpdate = numSamplesPerUpdate;
+}
+
+//==============================================================================
+void FDNReverb::processStereo (float* left, float* right, int numSamples) noexcept
+{
+    jassert (left != nullptr && right != nullptr);
+    [[maybe_unused]] juce::ScopedNoDenormals noDenormals;
+
+    const bool isSmoothing = wetGain1.isSmoothing() || wetGain2.isSmoothing() || dryGain.isSmoothing();
+    const auto wet1 = wetGain1.getCurrentValue(), wet2 = wetGain2.getCurrentValue(), dry = dryGain.getCurrentValue();
+
+    for (int done = 0; done < numSamples;)
+    {
+        if (numSamplesUntilUpdate == 0)
+        {
+            updateLines();
+            numSamplesUntilUpdate = numSamplesPerUpdate;
+        }
+
+        const int numThisTime = std::min (numSamples - done, numSamplesUntilUpdate);
+        auto l = left + done;
+        auto r = right + done;
+        processBlock (l, r, numThisTime);
+
+        if (isSmoothing)
+        {
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                const auto w1 = wetGain1.getNextValue(), w2 = wetGain2.getNextValue(), d = dryGain.getNextValue();
+                l[i] = wetLeft[(size_t) i] * w1 + wetRight[(size_t) i] * w2 + l[i] * d;
+                r[i] = wetRight[(size_t) i] * w1 + wetLeft[(size_t) i] * w2 + r[i] * d;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                l[i] = wetLeft[(size_t) i] * wet1 + wetRight[(size_t) i] * wet2 + l[i] * dry;
+                r[i] = wetRight[(size_t) i] * wet1 + wetLeft[(size_t) i] * wet2 + r[i] * dry;
+            }
+        }
+
+        numSamplesUntilUpdate -= numThisTime;
+        done += numThisTime;
+    }
+}
+
+void FDNReverb::processMono (float* samples, int numSamples) noexcept
+{
+    jassert (samples != nullptr);
+    [[maybe_unused]] juce::ScopedNoDenormals noDenormals;
+
+    for (int done = 0; done < numSamples;)
+    {
+        if (numSamplesUntilUpdate == 0)
+        {
+            updateLines();
+            numSamplesUntilUpdate = numSamplesPerUpdate;
+        }
+
+        const int numThisTime = std::min (numSamples - done, numSamplesUntilUpdate);
+        auto s = samples + done;
+        processBlock (s, s, numThisTime);
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            const auto wet = wetGain1.getNextValue();
+            wetGain2.skip (1);
+            s[i] = wetLeft[(size_t) i] * wet + s[i] * dryGain.getNextValue();
+        }
+
+        numSamplesUntilUpdate -= numThisTime;
+        done += numThisTime;
+    }
+}
+
+//==============================================================================
+void FDNReverb::updateGainTargets()
+{
+    const bool isFrozen = parameters.freezeMode >= 0.5f;
+    const auto wet = parameters.wetLevel * fdn_reverb::wetScale;
+
+    decaySmoother.setTargetValue (parameters.roomSize);
+    dampingSmoother.setTargetValue (isFrozen ? 0.0f : parameters.damping * fdn_reverb::maxDamping);
+    inputGainSmoother.setTargetValue (isFrozen ? 0.0f : fdn_reverb::fixedInputGain);
+    wetGain1.setTargetValue (0.5f * wet * (1.0f + parameters.width));
+    wetGain2.setTargetValue (0.5f * wet * (1.0f - parameters.width));
+    dryGain.setTargetValue (parameters.dryLevel * fdn_reverb::dryScale);
+}
+
+void FDNReverb::updateLines() noexcept
+{
+    const auto roomSize = decaySmoother.skip (numSamplesPerUpdate);
+    dampingCoefficient = dampingSmoother.skip (numSamplesPerUpdate);
+    inputGain = inputGainSmoother.skip (numSamplesPerUpdate);
+
+    if (parameters.freezeMode >= 0.5f)
+    {
+        // Interpolating the delay would lose a little high end on every pass
+        // so the modulation stops at the nearest whole sample
+        for (size_t i = 0; i < numLines; ++i)
+        {
+            delays[i] = std::round (delays[i]);
+            feedbackGains[i] = 1.0f;
+        }
+
+        roomSizeForGains = -1.0f;
+        return;
+    }
+
+    for (size_t i = 0; i < numLines; ++i)
+    {
+        // Rotating the LFOs avoids calling sin, the error in their length is corrected as they go
+        const auto s = modulationSin[i] * rotationCos[i] + modulationCos[i] * rotationSin[i];
+        const auto c = modulationCos[i] * rotationCos[i] - modulationSin[i] * rotationSin[i];
+        const auto correction = 1.5f - 0.5f * (s * s + c * c);
+        modulationSin[i] = s * correction;
+        modulationCos[i] = c * correction;
+
+        delays[i] = baseDelays[i] + modulationDepth * (1.0f + modulationSin[i]);
+    }
+
+    if (roomSize != roomSizeForGains)
+    {
+        roomSizeForGains = roomSize;
+        const auto decayTimeSamples = fdn_reverb::getDecayTimeSeconds (roomSize) * (float) sampleRate;
+
+        // Each line's gain gives the same decay time regardless of its length.
+        // The modulation changes the length so little this uses the average.
+        for (size_t i = 0; i < numLines; ++i)
+            feedbackGains[i] = std::pow (10.0f, -3.0f * (baseDelays[i] + modulationDepth) / decayTimeSamples);
+    }
+}
+
+void FDNReverb::processBlock (const float* inputLeft, const float* inputRight, int numSamples) noexcept
+{
+    jassert (numSamples <= numSamplesPerUpdate);
+    const int mask = bufferSize - 1;
+    wetLeft.fill (0.0f);
+    wetRight.fill (0.0f);
+
+    for (size_t line = 0; line < numLines; ++line)
+    {
+        auto block = lineBlocks[line].data();
+        auto buffer = delayBuffer.data() + line * (size_t) bufferSize;
+
+        // Read the delayed audio, interpolating between each sample and the one before it
+        const auto wholeDelay = (int) delays[line];
+        const auto fraction = delays[line] - (float) wholeDelay;
+        const int readStart = (writePosition - wholeDelay - 1) & mask;
+
+        if (readStart + numSamples < bufferSize)
+        {
+            auto src = buffer + readStart;
+
+            for (int i = 0; i < numSamples; ++i)
+                block[i] = src[i + 1] + fraction * (src[i] - src[i + 1]);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto older = buffer[(readStart + i) & mask];
+                const auto newer = buffer[(readStart + i + 1) & mask];
+                block[i] = newer + fraction * (older - newer);
+            }
+        }
+
+        const auto signLeft = fdn_reverb::outputSignsLeft[line];
+        const auto signRight = fdn_reverb::outputSignsRight[line];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            wetLeft[(size_t) i] += block[i] * signLeft;
+            wetRight[(size_t) i] += block[i] * signRight;
+        }
+    }
+
+    if (dampingCoefficient > 0.0f)
+    {
+        // The lines are filtered together so their recursions can overlap
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (size_t line = 0; line < numLines; ++line)
+            {
+                const auto input = lineBlocks[line][(size_t) i];
+                filterStates[line] = input + dampingCoefficient * (filterStates[line] - input);
+                lineBlocks[line][(size_t) i] = filterStates[line];
+            }
+        }
+    }
+
+    for (size_t line = 0; line < numLines; ++line)
+    {
+        // This also normalises the Hadamard matrix
+        const auto gain = feedbackGains[line] / std::sqrt ((float) numLines);
+        auto block = lineBlocks[line].data();
+
+        for (int i = 0; i < numSamples; ++i)
+            block[i] *= gain;
+    }
+
+    fdn_reverb::applyHadamard (lineBlocks, numSamples);
+
+    for (size_t line = 0; line < numLines; ++line)
+    {
+        auto block = lineBlocks[line].data();
+        auto buffer = delayBuffer.data() + line * (size_t) bufferSize;
+        const auto gainLeft = inputGain * fdn_reverb::inputSignsLeft[line];
+        const auto gainRight = inputGain * fdn_reverb::inputSignsRight[line];
+
+        for (int i = 0; i < numSamples; ++i)
+            block[i] += inputLeft[i] * gainLeft + inputRight[i] * gainRight;
+
+        if (writePosition + numSamples <= bufferSize)
+            std::copy_n (block, numSamples, buffer + writePosition);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                buffer[(writePosition + i) & mask] = block[i];
+    }
+
+    writePosition = (writePosition + numSamples) & mask;
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,116 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+/** The reverb algorithms the built-in plugins can use. */
+enum class ReverbAlgorithm
+{
+    classic                 = 0,    ///< juce::Reverb, a Freeverb implementation.
+    feedbackDelayNetwork    = 1     ///< FDNReverb.
+};
+
+//==============================================================================
+/**
+    An algorithmic reverb based on a feedback delay network.
+
+    Eight delay lines are fed back through an orthogonal (Hadamard) matrix which
+    mixes every line into every other on each pass, so the echo density builds up
+    much faster than with parallel combs.
+
+    As the shortest line is much longer than a block, the audio is processed in
+    short blocks, each step being done for a whole block of every line at once.
+    This keeps the inner loops simple enough for the compiler to vectorise.
+
+    The line lengths are slowly modulated to avoid metallic ringing. This, along
+    with the feedback gains and damping filters, is only updated once per block.
+    A one-pole low-pass in each line gives the high frequencies a shorter decay
+    time, this is skipped when there's no damping.
+
+    The parameters match juce::Reverb so this can be used in its place.
+*/
+class FDNReverb
+{
+public:
+    //==============================================================================
+    /** The reverb's parameters. These have the same ranges as juce::Reverb's. */
+    struct Parameters
+    {
+        float roomSize   = 0.5f;    ///< Room size, 0 to 1.0, where 1.0 is big, 0 is small.
+        float damping    = 0.5f;    ///< Damping, 0 to 1.0, where 0 is not damped, 1.0 is fully damped.
+        float wetLevel   = 0.33f;   ///< Wet level, 0 to 1.0
+        float dryLevel   = 0.4f;    ///< Dry level, 0 to 1.0
+        float width      = 1.0f;    ///< Reverb width, 0 to 1.0, where 1.0 is very wide.
+        float freezeMode = 0.0f;    ///< Freeze mode - values < 0.5 are "normal" mode, values > 0.5 put the reverb into a continuous feedback loop.
+
+        bool operator== (const Parameters&) const = default;
+    };
+
+    //==============================================================================
+    /** Creates a reverb. Call setSampleRate() before processing. */
+    FDNReverb();
+
+    /** Returns the current parameters. */
+    const Parameters& getParameters() const noexcept    { return parameters; }
+
+    /** Sets the parameters. Changes are smoothed so this can be called on every block. */
+    void setParameters (const Parameters&);
+
+    /** Sets the sample rate and clears the reverb's state. */
+    void setSampleRate (double sampleRate);
+
+    /** Clears the reverb's state. */
+    void reset();
+
+    /** Returns the time it takes the reverb to decay by 60dB for a room size. */
+    static float getDecayTimeSeconds (float roomSize) noexcept;
+
+    //==============================================================================
+    /** Applies the reverb to two stereo channels of audio data. */
+    void processStereo (float* left, float* right, int numSamples) noexcept;
+
+    /** Applies the reverb to a single mono channel of audio data. */
+    void processMono (float* samples, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr size_t numLines = 8;
+    static constexpr int numSamplesPerUpdate = 32;
+
+    using Lanes = std::array<float, numLines>;
+    using Block = std::array<float, numSamplesPerUpdate>;
+
+    Parameters parameters;
+    double sampleRate = 44100.0;
+
+    std::vector<float> delayBuffer;     // Each line is stored contiguously
+    int bufferSize = 0, writePosition = 0;
+
+    Lanes baseDelays {}, delays {}, feedbackGains {}, filterStates {};
+    Lanes modulationSin {}, modulationCos {}, rotationSin {}, rotationCos {};
+    float modulationDepth = 0.0f, dampingCoefficient = 0.0f, inputGain = 0.0f;
+    float roomSizeForGains = -1.0f;
+    int numSamplesUntilUpdate = 0;
+
+    alignas (32) std::array<Block, numLines> lineBlocks {};
+    alignas (32) Block wetLeft {}, wetRight {};
+
+    juce::SmoothedValue<float> decaySmoother, dampingSmoother, inputGainSmoother,
+                               wetGain1, wetGain2, dryGain;
+
+    void updateGainTargets();
+    void updateLines() noexcept;
+    void processBlock (const float* inputLeft, const float* inputRight, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverb)
+};
+
+} // namespace tracktion::inline engine
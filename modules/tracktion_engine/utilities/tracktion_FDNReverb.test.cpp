@@ -0,0 +1,192 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_FDN_REVERB) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_FDN_REVERB)
+
+namespace tracktion::inline engine
+{
+
+namespace fdn_reverb_test_utilities
+{
+    /** Returns a buffer with noise in the first numNoiseSamples and silence after. */
+    inline juce::AudioBuffer<float> createNoiseBurst (int numSamples, int numNoiseSamples, juce::Random& r)
+    {
+        juce::AudioBuffer<float> buffer (2, numSamples);
+        buffer.clear();
+
+        for (int chan = 0; chan < 2; ++chan)
+            for (int i = 0; i < std::min (numSamples, numNoiseSamples); ++i)
+                buffer.setSample (chan, i, r.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    /** Processes a buffer in blocks. */
+    template<typename ReverbType>
+    void process (ReverbType& reverb, juce::AudioBuffer<float>& buffer, int blockSize)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            const int numThisTime = std::min (blockSize, buffer.getNumSamples() - start);
+            reverb.processStereo (buffer.getWritePointer (0, start), buffer.getWritePointer (1, start), numThisTime);
+        }
+    }
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_FDN_REVERB
+
+//==============================================================================
+//==============================================================================
+class FDNReverbTests  : public juce::UnitTest
+{
+public:
+    FDNReverbTests()
+        : juce::UnitTest ("FDNReverb", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using namespace fdn_reverb_test_utilities;
+        constexpr double sampleRate = 44'100.0;
+        constexpr int numSamples = (int) sampleRate * 4;
+
+        beginTest ("Tail decays");
+        {
+            for (float roomSize : { 0.0f, 0.5f })
+            {
+                juce::Random r (42);
+                FDNReverb reverb;
+                reverb.setSampleRate (sampleRate);
+                reverb.setParameters ({ roomSize, 0.5f, 0.33f, 0.0f, 1.0f, 0.0f });
+
+                auto buffer = createNoiseBurst (numSamples, 4'410, r);
+                process (reverb, buffer, 512);
+
+                expect (buffer.getRMSLevel (0, 4'410, 10'000) > 0.01f);
+                expect (buffer.getMagnitude (numSamples - 10'000, 10'000) < 0.001f, "Room size: " + juce::String (roomSize));
+            }
+        }
+
+        beginTest ("Freeze holds the tail");
+        {
+            juce::Random r (42);
+            FDNReverb reverb;
+            reverb.setSampleRate (sampleRate);
+            reverb.setParameters ({ 0.5f, 0.5f, 0.33f, 0.0f, 1.0f, 0.0f });
+
+            auto buffer = createNoiseBurst (numSamples / 8, numSamples / 8, r);
+            process (reverb, buffer, 512);
+
+            buffer.setSize (2, numSamples);
+            reverb.setParameters ({ 0.5f, 0.5f, 0.33f, 0.0f, 1.0f, 1.0f });
+            buffer.clear();
+            process (reverb, buffer, 512);
+
+            const auto levelStart = buffer.getRMSLevel (0, 20'000, 10'000);
+            const auto levelEnd = buffer.getRMSLevel (0, numSamples - 10'000, 10'000);
+            expect (levelStart > 0.01f);
+            expectWithinAbsoluteError (levelEnd / levelStart, 1.0f, 0.1f);
+        }
+
+        beginTest ("Block size independence");
+        {
+            juce::Random r (42);
+            const auto input = createNoiseBurst (numSamples / 4, 4'410, r);
+            juce::AudioBuffer<float> outputs[2];
+            int index = 0;
+
+            for (int blockSize : { 17, 512 })
+            {
+                FDNReverb reverb;
+                reverb.setSampleRate (sampleRate);
+                outputs[index] = input;
+                process (reverb, outputs[index++], blockSize);
+            }
+
+            float maxError = 0.0f;
+
+            for (int chan = 0; chan < 2; ++chan)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    maxError = std::max (maxError, std::abs (outputs[0].getSample (chan, i) - outputs[1].getSample (chan, i)));
+
+            expectLessThan (maxError, 1.0e-5f);
+        }
+    }
+};
+
+static FDNReverbTests fdnReverbTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_FDN_REVERB
+
+//==============================================================================
+//==============================================================================
+class FDNReverbBenchmarks  : public juce::UnitTest
+{
+public:
+    FDNReverbBenchmarks()
+        : juce::UnitTest ("FDNReverb", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Benchmark: Reverb");
+        {
+            constexpr double sampleRate = 48'000.0;
+            juce::Random r (42);
+            const auto input = fdn_reverb_test_utilities::createNoiseBurst ((int) sampleRate * 10, (int) sampleRate * 10, r);
+
+            for (int blockSize : { 64, 512 })
+            {
+                const auto suffix = " (10s stereo, 48KHz, " + std::to_string (blockSize) + " sample blocks)";
+
+                {
+                    juce::Reverb reverb;
+                    reverb.setSampleRate (sampleRate);
+                    benchmarkReverb (reverb, input, blockSize, "juce::Reverb" + suffix);
+                }
+
+                {
+                    FDNReverb reverb;
+                    reverb.setSampleRate (sampleRate);
+                    benchmarkReverb (reverb, input, blockSize, "FDNReverb" + suffix);
+                }
+            }
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    template<typename ReverbType>
+    void benchmarkReverb (ReverbType& reverb, const juce::AudioBuffer<float>& input, int blockSize, std::string name)
+    {
+        auto buffer = input;
+
+        ScopedBenchmark sb (getDescription (name));
+        fdn_reverb_test_utilities::process (reverb, buffer, blockSize);
+    }
+};
+
+static FDNReverbBenchmarks fdnReverbBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -221,6 +221,8 @@ namespace IDs
     DECLARE_ID (maxNote)
     DECLARE_ID (openEnded)
     DECLARE_ID (SOUND)
+    DECLARE_ID (diskStreaming)
+    DECLARE_ID (streamingPreloadSize)
     DECLARE_ID (threshold)
     DECLARE_ID (inputDb)
     DECLARE_ID (outputDb)
@@ -261,6 +263,7 @@ namespace IDs
     DECLARE_ID (colour)
     DECLARE_ID (hidden)
     DECLARE_ID (process)
+    DECLARE_ID (oversampling)
     DECLARE_ID (sync)
     DECLARE_ID (showingTakes)
     DECLARE_ID (markerID)
@@ -612,6 +615,7 @@ namespace IDs
     DECLARE_ID (reverbDamping)
     DECLARE_ID (reverbMix)
     DECLARE_ID (reverbWidth)
+    DECLARE_ID (reverbAlgorithm)
     DECLARE_ID (delayFeedback)
     DECLARE_ID (delayCrossfeed)
     DECLARE_ID (delayMix)
@@ -669,6 +673,9 @@ namespace IDs
     DECLARE_ID (followActionBeats)
     DECLARE_ID (followActionNumLoops)
 
+    DECLARE_ID (EDITCHUNK)
+    DECLARE_ID (chunkIndex)
+
     #undef DECLARE_ID
 }
 
@@ -205,7 +205,11 @@ MultiVoiceOscillator::MultiVoiceOscillator (int maxVoices)
 void MultiVoiceOscillator::start()
 {
     static juce::Random r;
+    start (r);
+}
 
+void MultiVoiceOscillator::start (juce::Random& r)
+{
     for (int i = 0; i < oscillators.size(); i += 2)
     {
         float phase = r.nextFloat();
@@ -263,6 +267,61 @@ void MultiVoiceOscillator::setSpread (float s)
 }
 
 void MultiVoiceOscillator::process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    // Noise needs a separate generator for each channel to stay decorrelated
+    if (buffer.getNumChannels() < 2 || oscillators[0]->getWave() == Oscillator::noise)
+    {
+        processChannelPairs (buffer, startSample, numSamples);
+        return;
+    }
+
+    // Unison voices alternate between two pan positions, so rather than rendering
+    // each voice once per channel, the voices are summed into a lane for each pan
+    // position and the lanes mixed into the output with vector operations
+    constexpr int laneSize = 256;
+    float lanes[2][laneSize];
+
+    const int numVoices = std::min (voices, oscillators.size() / 2);
+    const float lanePans[] = { voices == 1 ? pan : juce::jlimit (-1.0f, 1.0f, spread),
+                               juce::jlimit (-1.0f, 1.0f, -spread) };
+
+    const float base = note - detune / 2;
+    const float delta = numVoices > 1 ? detune / (voices - 1) : 0.0f;
+
+    float* left  = buffer.getWritePointer (0, startSample);
+    float* right = buffer.getWritePointer (1, startSample);
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int numThisTime = std::min (laneSize, numSamples - done);
+        const int numLanes = std::min (2, numVoices);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            juce::FloatVectorOperations::clear (lanes[lane], numThisTime);
+
+        for (int i = 0; i < numVoices; ++i)
+        {
+            float* laneData = lanes[i % 2];
+            juce::AudioBuffer<float> laneBuffer (&laneData, 1, numThisTime);
+
+            auto& o = *oscillators[i * 2];
+
+            o.setGain (gain / voices);
+            o.setNote (numVoices == 1 ? note : base + delta * i);
+            o.process (laneBuffer, 0, numThisTime);
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            juce::FloatVectorOperations::addWithMultiply (left + done, lanes[lane], 1.0f - lanePans[lane], numThisTime);
+            juce::FloatVectorOperations::addWithMultiply (right + done, lanes[lane], 1.0f + lanePans[lane], numThisTime);
+        }
+
+        done += numThisTime;
+    }
+}
+
+void MultiVoiceOscillator::processChannelPairs (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
     if (voices == 1)
     {
@@ -274,7 +333,7 @@ void MultiVoiceOscillator::process (juce::AudioBuffer<float>& buffer, int startS
             bool left = (i % 2) == 0;
             float panGain = left ? leftGain : rightGain;
 
-            float* data = buffer.getWritePointer (left ? 0 : 1, startSample);
+            float* data = buffer.getWritePointer (left ? 0 : std::min (1, buffer.getNumChannels() - 1), startSample);
             float* dataPointers[] = {data};
 
             juce::AudioBuffer<float> channelBuffer (dataPointers, 1, numSamples);
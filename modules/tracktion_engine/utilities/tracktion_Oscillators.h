@@ -60,6 +60,8 @@ public:
     void setGain (float g)          { gain = g;         }
     void setPulseWidth (float p)    { pulseWidth = p;   }
 
+    Waves getWave() const           { return wave;      }
+
     void process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
 private:
@@ -89,6 +91,7 @@ public:
     MultiVoiceOscillator (int maxVoices = 8);
 
     void start();
+    void start (juce::Random&);
     void setSampleRate (double sr);
     void setWave (Oscillator::Waves w);
     void setNote (float n);
@@ -102,6 +105,12 @@ public:
 
     void process (juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
+    /** Renders each voice once for each channel.
+        process() uses this for noise and mono buffers. Otherwise it renders each voice
+        once, into a lane for its pan position, which gives the same result.
+    */
+    void processChannelPairs (juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
 private:
     juce::OwnedArray<Oscillator> oscillators;
 
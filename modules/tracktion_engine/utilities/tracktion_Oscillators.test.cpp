@@ -0,0 +1,91 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_OSCILLATORS
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class MultiVoiceOscillatorTests  : public juce::UnitTest
+{
+public:
+    MultiVoiceOscillatorTests()
+        : juce::UnitTest ("MultiVoiceOscillator", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Rendering in lanes matches rendering each voice per channel");
+        {
+            for (auto wave : { Oscillator::sine, Oscillator::square, Oscillator::saw, Oscillator::triangle })
+                for (int numVoices : { 1, 2, 5, 8 })
+                    for (int blockSize : { 17, 1'000 })
+                        expectLanesMatchChannelPairs (wave, numVoices, blockSize);
+        }
+    }
+
+private:
+    void expectLanesMatchChannelPairs (Oscillator::Waves wave, int numVoices, int blockSize)
+    {
+        constexpr int numSamples = 4'410;
+        MultiVoiceOscillator lanes, channelPairs;
+        juce::AudioBuffer<float> outputs[2];
+        int index = 0;
+
+        for (auto osc : { &lanes, &channelPairs })
+        {
+            // Both start with the same phases
+            juce::Random r (42);
+            osc->setSampleRate (44'100.0);
+            osc->setWave (wave);
+            osc->setNote (60.0f);
+            osc->setGain (0.5f);
+            osc->setPan (0.3f);
+            osc->setPulseWidth (0.3f);
+            osc->setNumVoices (numVoices);
+            osc->setDetune (0.3f);
+            osc->setSpread (0.6f);
+            osc->start (r);
+
+            auto& output = outputs[index++];
+            output.setSize (2, numSamples);
+            output.clear();
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                const int numThisTime = std::min (blockSize, numSamples - start);
+
+                if (osc == &lanes)
+                    osc->process (output, start, numThisTime);
+                else
+                    osc->processChannelPairs (output, start, numThisTime);
+            }
+        }
+
+        float maxError = 0.0f;
+
+        for (int chan = 0; chan < 2; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = std::max (maxError, std::abs (outputs[0].getSample (chan, i) - outputs[1].getSample (chan, i)));
+
+        const auto description = "Wave: " + juce::String ((int) wave) + ", voices: " + juce::String (numVoices)
+                                    + ", block size: " + juce::String (blockSize);
+        expect (outputs[1].getMagnitude (0, numSamples) > 0.1f, description);
+        expectLessThan (maxError, 1.0e-5f, description);
+    }
+};
+
+static MultiVoiceOscillatorTests multiVoiceOscillatorTests;
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -0,0 +1,308 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace oversampling
+{
+    /** The number of taps in a stage's polyphase branch, this is half the full filter length. */
+    inline int getNumStageTaps (int stageIndex) noexcept
+    {
+        return stageIndex == 0 ? 32 : 12;
+    }
+
+    /** Returns the latency of the filters at the oversampled rate.
+        Each pair of filters delays by one less than its number of taps, at the stage's lower rate.
+    */
+    inline int getFilterLatencyAtOversampledRate (int ratio) noexcept
+    {
+        int latency = 0;
+
+        for (int stage = 0, stageRatio = 1; stageRatio < ratio; ++stage, stageRatio *= 2)
+            latency += (getNumStageTaps (stage) - 1) * (ratio / stageRatio);
+
+        return latency;
+    }
+
+    inline double besselI0 (double x)
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 30; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    /** Returns the non-zero taps, other than the centre tap, of a Kaiser windowed
+        half-band filter, scaled so they sum to 1.
+    */
+    inline std::vector<float> createHalfBandCoefficients (int numTaps)
+    {
+        constexpr double beta = 8.0;
+        const int filterLength = numTaps * 2 - 1;
+        const int centre = numTaps - 1;
+
+        std::vector<double> taps ((size_t) numTaps);
+        double sum = 0.0;
+
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const int index = k * 2;
+            const double x = juce::MathConstants<double>::halfPi * (index - centre);
+            const double position = 2.0 * index / (filterLength - 1) - 1.0;
+            const double window = besselI0 (beta * std::sqrt (1.0 - position * position)) / besselI0 (beta);
+
+            taps[(size_t) k] = std::sin (x) / x * window;
+            sum += taps[(size_t) k];
+        }
+
+        std::vector<float> result ((size_t) numTaps);
+
+        for (size_t k = 0; k < result.size(); ++k)
+            result[k] = (float) (taps[k] / sum);
+
+        return result;
+    }
+
+    /** Shifts the last numToKeep samples in a history buffer to the start. */
+    inline void keepHistory (std::vector<float>& history, int numSamplesAdded, int numToKeep) noexcept
+    {
+        std::copy (history.begin() + numSamplesAdded, history.begin() + numSamplesAdded + numToKeep, history.begin());
+    }
+}
+
+//==============================================================================
+/** Doubles or halves the rate with a pair of half-band filters.
+
+    The filter's taps are symmetric so the reversed taps used for the convolution
+    are the same as the forward ones, and the histories are laid out so each output
+    sample is a dot product of two contiguous arrays.
+*/
+struct Oversampler::Stage
+{
+    Stage (int numTapsToUse, int numChannels, int maxNumInputSamples)
+        : coefficients (oversampling::createHalfBandCoefficients (numTapsToUse)),
+          numTaps (numTapsToUse), halfNumTaps (numTapsToUse / 2),
+          buffer (numChannels, maxNumInputSamples * 2)
+    {
+        upHistories.assign ((size_t) numChannels, std::vector<float> ((size_t) (numTaps - 1 + maxNumInputSamples)));
+        evenHistories.assign ((size_t) numChannels, std::vector<float> ((size_t) (numTaps - 1 + maxNumInputSamples)));
+        oddHistories.assign ((size_t) numChannels, std::vector<float> ((size_t) (halfNumTaps + maxNumInputSamples)));
+    }
+
+    void reset()
+    {
+        for (auto histories : { &upHistories, &evenHistories, &oddHistories })
+            for (auto& h : *histories)
+                std::fill (h.begin(), h.end(), 0.0f);
+    }
+
+    float convolve (const float* samples) const noexcept
+    {
+        auto c = coefficients.data();
+        float sum = 0.0f;
+
+        for (int k = 0; k < numTaps; ++k)
+            sum += c[k] * samples[k];
+
+        return sum;
+    }
+
+    // Upsamples numSamples input samples in to twice as many samples in the buffer
+    void upsample (const float* const* input, int numChannels, int numSamples) noexcept
+    {
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto& history = upHistories[(size_t) chan];
+            std::copy (input[chan], input[chan] + numSamples, history.begin() + (numTaps - 1));
+
+            auto x = history.data();
+            auto dest = buffer.getWritePointer (chan);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                dest[i * 2]     = convolve (x + i);
+                dest[i * 2 + 1] = x[i + halfNumTaps];
+            }
+
+            oversampling::keepHistory (history, numSamples, numTaps - 1);
+        }
+    }
+
+    // Downsamples numSamples * 2 samples in the buffer in to numSamples output samples
+    void downsample (float* const* output, int numChannels, int numSamples) noexcept
+    {
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto& evenHistory = evenHistories[(size_t) chan];
+            auto& oddHistory = oddHistories[(size_t) chan];
+            auto src = buffer.getReadPointer (chan);
+            auto even = evenHistory.data() + (numTaps - 1);
+            auto odd = oddHistory.data() + halfNumTaps;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                even[i] = src[i * 2];
+                odd[i] = src[i * 2 + 1];
+            }
+
+            auto x = evenHistory.data();
+            auto dest = output[chan];
+
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = 0.5f * (convolve (x + i) + oddHistory[(size_t) i]);
+
+            oversampling::keepHistory (evenHistory, numSamples, numTaps - 1);
+            oversampling::keepHistory (oddHistory, numSamples, halfNumTaps);
+        }
+    }
+
+    const std::vector<float> coefficients;
+    const int numTaps, halfNumTaps;
+    juce::AudioBuffer<float> buffer;   // The audio at the higher rate
+    std::vector<std::vector<float>> upHistories, evenHistories, oddHistories;
+};
+
+//==============================================================================
+Oversampler::Factor Oversampler::getFactorForRatio (int ratio) noexcept
+{
+    if (ratio >= 8)     return Factor::x8;
+    if (ratio >= 4)     return Factor::x4;
+    if (ratio >= 2)     return Factor::x2;
+
+    return Factor::none;
+}
+
+Oversampler::Oversampler() = default;
+Oversampler::~Oversampler() = default;
+
+void Oversampler::prepare (Factor newMaxFactor, int numChannels, int maxBlockSizeToUse)
+{
+    maxFactor = newMaxFactor;
+    maxNumChannels = numChannels;
+    maxBlockSize = maxBlockSizeToUse;
+    stages.clear();
+
+    // Each stage is the same whatever the factor, lower factors just use fewer of them
+    for (int stageRatio = 1; stageRatio < (int) maxFactor; stageRatio *= 2)
+        stages.push_back (std::make_unique<Stage> (oversampling::getNumStageTaps ((int) stages.size()),
+                                                   numChannels, maxBlockSize * stageRatio));
+
+    // The padding is always less than the ratio
+    paddingStates.assign ((size_t) numChannels, std::vector<float> ((size_t) maxFactor));
+
+    factor = Factor::none;
+    numStagesInUse = 0;
+    numPaddingSamples = 0;
+    setFactor (maxFactor);
+    reset();
+}
+
+void Oversampler::setFactor (Factor newFactor) noexcept
+{
+    jassert (newFactor <= maxFactor);
+    newFactor = std::min (newFactor, maxFactor);
+
+    if (newFactor == factor)
+        return;
+
+    factor = newFactor;
+    numStagesInUse = 0;
+
+    for (int stageRatio = 1; stageRatio < getRatio(); stageRatio *= 2)
+        ++numStagesInUse;
+
+    // Pads the latency to a whole number of samples at the original rate
+    numPaddingSamples = getLatencySamples() * getRatio() - oversampling::getFilterLatencyAtOversampledRate (getRatio());
+    reset();
+}
+
+void Oversampler::reset()
+{
+    for (auto& stage : stages)
+        stage->reset();
+
+    for (auto& s : paddingStates)
+        std::fill (s.begin(), s.end(), 0.0f);
+}
+
+int Oversampler::getLatencySamples (Factor f) noexcept
+{
+    const int ratio = (int) f;
+    return (oversampling::getFilterLatencyAtOversampledRate (ratio) + ratio - 1) / ratio;
+}
+
+juce::AudioBuffer<float> Oversampler::upsample (const float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert (numStagesInUse > 0);
+    jassert (numChannels <= maxNumChannels && numSamples <= maxBlockSize);
+
+    for (size_t i = 0; i < numStagesInUse; ++i)
+    {
+        if (i == 0)
+            stages[i]->upsample (channels, numChannels, numSamples);
+        else
+            stages[i]->upsample (stages[i - 1]->buffer.getArrayOfReadPointers(), numChannels, numSamples << i);
+    }
+
+    auto& output = stages[numStagesInUse - 1]->buffer;
+    const int numOutputSamples = numSamples * getRatio();
+    applyPadding (output.getArrayOfWritePointers(), numChannels, numOutputSamples);
+
+    return juce::AudioBuffer<float> (output.getArrayOfWritePointers(), numChannels, numOutputSamples);
+}
+
+void Oversampler::downsample (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert (numStagesInUse > 0);
+
+    for (size_t i = numStagesInUse; --i > 0;)
+        stages[i]->downsample (stages[i - 1]->buffer.getArrayOfWritePointers(), numChannels, numSamples << i);
+
+    stages.front()->downsample (channels, numChannels, numSamples);
+}
+
+void Oversampler::applyPadding (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    if (numPaddingSamples == 0)
+        return;
+
+    // The padding is always less than the ratio so this is enough for the last samples of any block
+    std::array<float, 16> lastSamples;
+    jassert (numPaddingSamples <= (int) lastSamples.size() / 2);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto& delayed = paddingStates[(size_t) chan];
+        auto data = channels[chan];
+
+        if (numSamples >= numPaddingSamples)
+        {
+            std::copy (data + numSamples - numPaddingSamples, data + numSamples, lastSamples.begin());
+            std::copy_backward (data, data + numSamples - numPaddingSamples, data + numSamples);
+            std::copy (delayed.begin(), delayed.begin() + numPaddingSamples, data);
+            std::copy (lastSamples.begin(), lastSamples.begin() + numPaddingSamples, delayed.begin());
+        }
+        else
+        {
+            std::copy (delayed.begin(), delayed.begin() + numPaddingSamples, lastSamples.begin());
+            std::copy (data, data + numSamples, lastSamples.begin() + numPaddingSamples);
+            std::copy (lastSamples.begin(), lastSamples.begin() + numSamples, data);
+            std::copy (lastSamples.begin() + numSamples, lastSamples.begin() + numSamples + numPaddingSamples, delayed.begin());
+        }
+    }
+}
+
+} // namespace tracktion::inline engine
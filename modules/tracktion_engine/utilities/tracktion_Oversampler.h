@@ -0,0 +1,151 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+/**
+    Runs some processing at a multiple of the sample rate to reduce aliasing.
+
+    Each doubling of the rate is done by a stage of linear-phase half-band FIR
+    filters. As every other tap of a half-band filter is zero, the filters are
+    split into their two polyphase components, one of which is a plain delay, so
+    only the remaining taps are run at the lower of the stage's two rates. The
+    first stage has the steepest filters, later stages only need to remove the
+    images of what's already been band-limited so are much shorter.
+
+    The latency is always a whole number of samples at the original rate.
+    Plugins using this should report getLatencySamples() from
+    Plugin::getLatencySeconds().
+
+    The filters for every factor up to the one passed to prepare() are allocated
+    up front, so setFactor() can switch between them on the audio thread.
+
+    @see Plugin::canOversample
+*/
+class Oversampler
+{
+public:
+    //==============================================================================
+    /** The factors the sample rate can be multiplied by. */
+    enum class Factor
+    {
+        none    = 1,
+        x2      = 2,
+        x4      = 4,
+        x8      = 8
+    };
+
+    /** Returns the Factor closest to a number, e.g. 4 for Factor::x4. */
+    static Factor getFactorForRatio (int ratio) noexcept;
+
+    //==============================================================================
+    /** Creates an Oversampler. Call prepare() before processing. */
+    Oversampler();
+
+    /** Destructor. */
+    ~Oversampler();
+
+    /** Allocates the filters and buffers for the factor and any lower ones, then
+        sets the factor. This also clears the filters' state.
+    */
+    void prepare (Factor maxFactor, int numChannels, int maxBlockSize);
+
+    /** Changes the factor without allocating, clearing the filters' state if it
+        changes. The factor can't be higher than the one passed to prepare().
+    */
+    void setFactor (Factor) noexcept;
+
+    /** Clears the filters' state. */
+    void reset();
+
+    /** Returns the factor currently in use. */
+    Factor getFactor() const noexcept                   { return factor; }
+
+    /** Returns the factor as a number, e.g. 4 for Factor::x4. */
+    int getRatio() const noexcept                       { return (int) factor; }
+
+    /** Returns the latency, at the original rate, of the factor currently in use. */
+    int getLatencySamples() const noexcept              { return getLatencySamples (factor); }
+
+    /** Returns the latency, at the original rate, of a factor. */
+    static int getLatencySamples (Factor) noexcept;
+
+    //==============================================================================
+    /** Upsamples the buffer, calls the function with the oversampled audio and then
+        downsamples the result back into the buffer.
+        The function should take a juce::AudioBuffer<float>& and process it in place.
+        Buffers longer than the prepared block size are processed in several parts.
+        With Factor::none, the function is just called with the buffer.
+    */
+    template<typename ProcessFunction>
+    void process (juce::AudioBuffer<float>&, ProcessFunction&&);
+
+    /** Upsamples some channels in to the oversampled buffer, returning a buffer
+        referring to the oversampled audio.
+        The buffer is only valid until the next call to upsample(). The factor
+        mustn't be Factor::none and the block must fit the sizes passed to prepare().
+    */
+    juce::AudioBuffer<float> upsample (const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Downsamples the audio last returned from upsample() in to some channels. */
+    void downsample (float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct Stage;
+    std::vector<std::unique_ptr<Stage>> stages;
+    size_t numStagesInUse = 0;
+    Factor factor = Factor::none, maxFactor = Factor::none;
+    int maxNumChannels = 0, maxBlockSize = 0;
+
+    std::vector<std::vector<float>> paddingStates;
+    int numPaddingSamples = 0;
+
+    void applyPadding (float* const* channels, int numChannels, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampler)
+};
+
+
+//==============================================================================
+//        _        _           _  _
+//     __| |  ___ | |_   __ _ (_)| | ___
+//    / _` | / _ \| __| / _` || || |/ __|
+//   | (_| ||  __/| |_ | (_| || || |\__ \ _  _  _
+//    \__,_| \___| \__| \__,_||_||_||___/(_)(_)(_)
+//
+//   Code beyond this point is implementation detail...
+//
+//==============================================================================
+template<typename ProcessFunction>
+void Oversampler::process (juce::AudioBuffer<float>& buffer, ProcessFunction&& processFunction)
+{
+    if (factor == Factor::none)
+    {
+        processFunction (buffer);
+        return;
+    }
+
+    jassert (buffer.getNumChannels() <= maxNumChannels);
+    const int numChannels = std::min (buffer.getNumChannels(), maxNumChannels);
+
+    for (int start = 0; start < buffer.getNumSamples(); start += maxBlockSize)
+    {
+        const int numThisTime = std::min (maxBlockSize, buffer.getNumSamples() - start);
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), numChannels, start, numThisTime);
+
+        auto oversampled = upsample (block.getArrayOfReadPointers(), numChannels, numThisTime);
+        processFunction (oversampled);
+        downsample (block.getArrayOfWritePointers(), numChannels, numThisTime);
+    }
+}
+
+} // namespace tracktion::inline engine
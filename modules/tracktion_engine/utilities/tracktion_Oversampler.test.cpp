@@ -0,0 +1,251 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_OVERSAMPLER) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_OVERSAMPLER)
+
+namespace tracktion::inline engine
+{
+
+namespace oversampler_test_utilities
+{
+    /** Returns a buffer with the sum of two sines, one near the top of the audio band. */
+    inline juce::AudioBuffer<float> createSines (int numChannels, int numSamples, double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (chan, i, (float) (0.5 * std::sin (juce::MathConstants<double>::twoPi * 1'000.0 * i / sampleRate)
+                                                    + 0.3 * std::sin (juce::MathConstants<double>::twoPi * 15'000.0 * i / sampleRate)));
+
+        return buffer;
+    }
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_OVERSAMPLER
+
+//==============================================================================
+//==============================================================================
+class OversamplerTests  : public juce::UnitTest
+{
+public:
+    OversamplerTests()
+        : juce::UnitTest ("Oversampler", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using Factor = Oversampler::Factor;
+        constexpr double sampleRate = 48'000.0;
+
+        beginTest ("No oversampling");
+        {
+            Oversampler oversampler;
+            oversampler.prepare (Factor::none, 2, 512);
+            expectEquals (oversampler.getLatencySamples(), 0);
+
+            auto buffer = oversampler_test_utilities::createSines (2, 512, sampleRate);
+            int numSamplesProcessed = 0;
+            oversampler.process (buffer, [&] (juce::AudioBuffer<float>& b) { numSamplesProcessed += b.getNumSamples(); });
+            expectEquals (numSamplesProcessed, 512);
+        }
+
+        for (auto factor : { Factor::x2, Factor::x4, Factor::x8 })
+        {
+            const auto suffix = " (" + juce::String ((int) factor) + "x)";
+
+            beginTest ("Audio is delayed by the latency" + suffix);
+            {
+                Oversampler oversampler;
+                oversampler.prepare (factor, 2, 512);
+
+                const auto input = oversampler_test_utilities::createSines (2, 48'000, sampleRate);
+                auto output = input;
+                int numSamplesProcessed = 0;
+                juce::Random r (42);
+
+                // Includes blocks longer than the prepared size
+                for (int start = 0; start < output.getNumSamples();)
+                {
+                    const int numThisTime = std::min (output.getNumSamples() - start, r.nextInt ({ 1, 1'500 }));
+                    juce::AudioBuffer<float> block (output.getArrayOfWritePointers(), 2, start, numThisTime);
+
+                    oversampler.process (block, [&] (juce::AudioBuffer<float>& b)
+                    {
+                        numSamplesProcessed += b.getNumSamples();
+                    });
+
+                    start += numThisTime;
+                }
+
+                expectEquals (numSamplesProcessed, output.getNumSamples() * (int) factor);
+
+                const int latency = oversampler.getLatencySamples();
+                expectEquals (latency, Oversampler::getLatencySamples (factor));
+                float maxError = 0.0f;
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = latency + 1'000; i < output.getNumSamples(); ++i)
+                        maxError = std::max (maxError, std::abs (output.getSample (chan, i) - input.getSample (chan, i - latency)));
+
+                expectLessThan (maxError, 1.0e-3f);
+            }
+
+            beginTest ("Content above the original Nyquist is removed" + suffix);
+            {
+                Oversampler oversampler;
+                oversampler.prepare (factor, 1, 512);
+
+                juce::AudioBuffer<float> buffer (1, 512);
+                double phase = 0.0;
+                const double phaseDelta = juce::MathConstants<double>::twoPi * 30'000.0 / (sampleRate * (int) factor);
+                float maxLevel = 0.0f;
+
+                for (int block = 0; block < 40; ++block)
+                {
+                    oversampler.process (buffer, [&] (juce::AudioBuffer<float>& b)
+                    {
+                        for (int i = 0; i < b.getNumSamples(); ++i)
+                        {
+                            b.setSample (0, i, (float) std::sin (phase));
+                            phase += phaseDelta;
+                        }
+                    });
+
+                    if (block > 2)
+                        maxLevel = std::max (maxLevel, buffer.getMagnitude (0, 0, 512));
+                }
+
+                expectLessThan (maxLevel, juce::Decibels::decibelsToGain (-70.0f));
+            }
+        }
+
+        beginTest ("Switching factor without preparing again");
+        {
+            Oversampler oversampler;
+            oversampler.prepare (Factor::x8, 2, 512);
+
+            const auto input = oversampler_test_utilities::createSines (2, 8'192, sampleRate);
+
+            for (auto factor : { Factor::x2, Factor::none, Factor::x8, Factor::x4 })
+            {
+                oversampler.setFactor (factor);
+                expect (oversampler.getFactor() == factor);
+                expectEquals (oversampler.getLatencySamples(), Oversampler::getLatencySamples (factor));
+
+                auto output = input;
+                int numSamplesProcessed = 0;
+
+                for (int start = 0; start < output.getNumSamples(); start += 512)
+                {
+                    juce::AudioBuffer<float> block (output.getArrayOfWritePointers(), 2, start, 512);
+                    oversampler.process (block, [&] (juce::AudioBuffer<float>& b) { numSamplesProcessed += b.getNumSamples(); });
+                }
+
+                expectEquals (numSamplesProcessed, output.getNumSamples() * (int) factor);
+
+                // The previous factor's state mustn't leak in to the start of the output
+                const int latency = oversampler.getLatencySamples();
+                float maxError = 0.0f;
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = latency + 1'000; i < output.getNumSamples(); ++i)
+                        maxError = std::max (maxError, std::abs (output.getSample (chan, i) - input.getSample (chan, i - latency)));
+
+                expectLessThan (maxError, 1.0e-3f);
+
+                if (factor != Factor::none)
+                    expectLessThan (output.getMagnitude (0, latency / 4), 1.0e-4f);
+            }
+        }
+    }
+};
+
+static OversamplerTests oversamplerTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_OVERSAMPLER
+
+//==============================================================================
+//==============================================================================
+class OversamplerBenchmarks  : public juce::UnitTest
+{
+public:
+    OversamplerBenchmarks()
+        : juce::UnitTest ("Oversampler", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Benchmark: Oversampled waveshaper");
+        {
+            constexpr double sampleRate = 48'000.0;
+            const auto input = oversampler_test_utilities::createSines (2, (int) sampleRate * 10, sampleRate);
+
+            for (auto factor : { Oversampler::Factor::none, Oversampler::Factor::x2,
+                                 Oversampler::Factor::x4, Oversampler::Factor::x8 })
+            {
+                const auto factorName = factor == Oversampler::Factor::none ? std::string ("No oversampling")
+                                                                            : std::to_string ((int) factor) + "x";
+                const auto suffix = " (10s stereo, 48KHz, 512 sample blocks)";
+
+                benchmarkFactor (factor, input, false, factorName + ", oversampling only" + suffix);
+                benchmarkFactor (factor, input, true, factorName + ", tanh" + suffix);
+            }
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    void benchmarkFactor (Oversampler::Factor factor, const juce::AudioBuffer<float>& input, bool applyWaveshaper, std::string name)
+    {
+        Oversampler oversampler;
+        oversampler.prepare (factor, input.getNumChannels(), 512);
+        auto buffer = input;
+
+        ScopedBenchmark sb (getDescription (name));
+
+        for (int start = 0; start + 512 <= buffer.getNumSamples(); start += 512)
+        {
+            juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, 512);
+
+            oversampler.process (block, [applyWaveshaper] (juce::AudioBuffer<float>& b)
+            {
+                if (! applyWaveshaper)
+                    return;
+
+                for (int chan = 0; chan < b.getNumChannels(); ++chan)
+                {
+                    auto data = b.getWritePointer (chan);
+
+                    for (int i = 0; i < b.getNumSamples(); ++i)
+                        data[i] = std::tanh (4.0f * data[i]);
+                }
+            });
+        }
+    }
+};
+
+static OversamplerBenchmarks oversamplerBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif
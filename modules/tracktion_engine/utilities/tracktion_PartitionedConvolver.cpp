@@ -0,0 +1,546 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+namespace convolution
+{
+    /** Returns the number of floats in an interleaved spectrum of a partition. */
+    inline int getSpectrumSize (int partitionSize) noexcept
+    {
+        return (partitionSize + 1) * 2;
+    }
+
+    /** Multiplies two interleaved spectra and adds the result to a third. */
+    inline void multiplyAndAccumulate (float* dest, const float* a, const float* b, int numBins) noexcept
+    {
+        for (int i = 0; i < numBins; ++i)
+        {
+            const auto re = a[0] * b[0] - a[1] * b[1];
+            const auto im = a[0] * b[1] + a[1] * b[0];
+            dest[0] += re;
+            dest[1] += im;
+            dest += 2;
+            a += 2;
+            b += 2;
+        }
+    }
+
+    /** The sizes and positions of the segments for an IR of a given length.
+        Each segment uses partitions four times the size of the previous one and
+        starts at twice its partition size so its result can be computed during
+        the partition that follows the input it needs.
+    */
+    inline std::vector<std::tuple<int, int, int>> getSegmentLayout (int irLength, PartitionedConvolver::Options options)
+    {
+        jassert (juce::isPowerOfTwo (options.headSize) && juce::isPowerOfTwo (options.maxPartitionSize));
+        jassert (options.maxPartitionSize >= options.headSize);
+
+        std::vector<std::tuple<int, int, int>> layout;  // partitionSize, numPartitions, irOffset
+        int partitionSize = options.headSize;
+        int offset = options.headSize;
+
+        while (offset < irLength)
+        {
+            const auto nextPartitionSize = partitionSize * 4;
+            const auto nextOffset = nextPartitionSize * 2;
+
+            if (nextPartitionSize > options.maxPartitionSize || nextOffset >= irLength)
+            {
+                layout.emplace_back (partitionSize, (irLength - offset + partitionSize - 1) / partitionSize, offset);
+                break;
+            }
+
+            layout.emplace_back (partitionSize, (nextOffset - offset) / partitionSize, offset);
+            partitionSize = nextPartitionSize;
+            offset = nextOffset;
+        }
+
+        return layout;
+    }
+}
+
+//==============================================================================
+PartitionedConvolver::ImpulseResponse::ImpulseResponse (const juce::AudioBuffer<float>& ir, Options opts)
+    : options (opts),
+      numChannels (std::max (1, ir.getNumChannels())),
+      length (ir.getNumSamples())
+{
+    auto getSample = [&] (int chan, int index)
+    {
+        if (index >= length || ir.getNumChannels() == 0)
+            return 0.0f;
+
+        return ir.getSample (chan, index);
+    };
+
+    reversedHeads.resize (static_cast<size_t> (numChannels));
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto& head = reversedHeads[static_cast<size_t> (chan)];
+        head.resize (static_cast<size_t> (options.headSize));
+
+        for (int i = 0; i < options.headSize; ++i)
+            head[static_cast<size_t> (options.headSize - 1 - i)] = getSample (chan, i);
+    }
+
+    for (auto [partitionSize, numPartitions, irOffset] : convolution::getSegmentLayout (length, options))
+    {
+        Segment segment { partitionSize, numPartitions, irOffset, {} };
+
+        const auto spectrumSize = convolution::getSpectrumSize (partitionSize);
+        juce::dsp::FFT fft (juce::roundToInt (std::log2 (partitionSize * 2)));
+        std::vector<float> work (static_cast<size_t> (partitionSize * 4));
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto& spectra = segment.spectra.emplace_back (static_cast<size_t> (spectrumSize * numPartitions));
+
+            for (int part = 0; part < numPartitions; ++part)
+            {
+                // Each partition is zero padded to the FFT size
+                std::fill (work.begin(), work.end(), 0.0f);
+
+                for (int i = 0; i < partitionSize; ++i)
+                    work[static_cast<size_t> (i)] = getSample (chan, irOffset + part * partitionSize + i);
+
+                fft.performRealOnlyForwardTransform (work.data(), true);
+                std::copy_n (work.data(), spectrumSize, spectra.data() + part * spectrumSize);
+            }
+        }
+
+        segments.push_back (std::move (segment));
+    }
+}
+
+size_t PartitionedConvolver::ImpulseResponse::getMemoryUsage() const noexcept
+{
+    size_t numFloats = 0;
+
+    for (auto& head : reversedHeads)
+        numFloats += head.size();
+
+    for (auto& segment : segments)
+        for (auto& spectra : segment.spectra)
+            numFloats += spectra.size();
+
+    return numFloats * sizeof (float);
+}
+
+//==============================================================================
+PartitionedConvolver::ImpulseResponsePtr PartitionedConvolver::getSharedImpulseResponse (SharedAudioDataStore& store, SharedAudioDataStore::Key key,
+                                                                                         const std::function<juce::AudioBuffer<float>()>& createImpulseResponse,
+                                                                                         Options options)
+{
+    key.add (options.headSize).add (options.maxPartitionSize);
+
+    return store.getOrCreate<ImpulseResponse> (std::move (key), [&] { return ImpulseResponse (createImpulseResponse(), options); });
+}
+
+//==============================================================================
+/** The state of one segment of the IR for a convolver. */
+struct PartitionedConvolver::SegmentState
+{
+    enum class JobState
+    {
+        idle,
+        pending,
+        running,
+        finished
+    };
+
+    SegmentState (const ImpulseResponse::Segment& s, int numChannelsToUse, int headSize)
+        : segment (s),
+          numChannels (numChannelsToUse),
+          partitionSize (s.partitionSize),
+          spectrumSize (convolution::getSpectrumSize (s.partitionSize)),
+          fft (juce::roundToInt (std::log2 (s.partitionSize * 2))),
+          numStepsPerChannel (s.numPartitions + 2),
+          isProcessedImmediately (s.irOffset < s.partitionSize * 2)
+    {
+        inputBlocks.resize (static_cast<size_t> (numChannels * partitionSize * 2));
+        jobInputBlocks.resize (inputBlocks.size());
+        jobOutputs.resize (static_cast<size_t> (numChannels * partitionSize));
+        delayLines.resize (static_cast<size_t> (numChannels * segment.numPartitions * spectrumSize));
+        accumulator.resize (static_cast<size_t> (spectrumSize));
+        work.resize (static_cast<size_t> (partitionSize * 4));
+
+        // Spread the work over the ticks before the next partition starts
+        const int numTicksPerPartition = partitionSize / headSize;
+        numStepsPerTick = (numStepsPerChannel * numChannels + numTicksPerPartition - 1) / numTicksPerPartition;
+    }
+
+    void clear() noexcept
+    {
+        std::fill (inputBlocks.begin(), inputBlocks.end(), 0.0f);
+        std::fill (delayLines.begin(), delayLines.end(), 0.0f);
+        numInputFrames = 0;
+        newestPartition = 0;
+        jobState = JobState::idle;
+    }
+
+    /** Runs a number of steps of the current job. */
+    void runSteps (int numSteps) noexcept
+    {
+        const auto numStepsInJob = numStepsPerChannel * numChannels;
+
+        for (const auto end = std::min (nextStep + numSteps, numStepsInJob); nextStep < end; ++nextStep)
+        {
+            const auto chan = nextStep / numStepsPerChannel;
+            const auto step = nextStep % numStepsPerChannel;
+            const auto irChan = static_cast<size_t> (std::min (chan, (int) segment.spectra.size() - 1));
+            auto delayLine = delayLines.data() + chan * segment.numPartitions * spectrumSize;
+
+            if (step == 0)
+            {
+                // Transform the input into the newest slot of the delay line
+                std::copy_n (jobInputBlocks.data() + chan * partitionSize * 2, partitionSize * 2, work.data());
+                fft.performRealOnlyForwardTransform (work.data(), true);
+                std::copy_n (work.data(), spectrumSize, delayLine + newestPartition * spectrumSize);
+                std::fill (accumulator.begin(), accumulator.end(), 0.0f);
+            }
+            else if (step <= segment.numPartitions)
+            {
+                // Each IR partition is applied to the input from that many partitions ago
+                const auto partition = step - 1;
+                const auto slot = (newestPartition - partition + segment.numPartitions) % segment.numPartitions;
+
+                convolution::multiplyAndAccumulate (accumulator.data(),
+                                                    delayLine + slot * spectrumSize,
+                                                    segment.spectra[irChan].data() + partition * spectrumSize,
+                                                    partitionSize + 1);
+            }
+            else
+            {
+                // The second half of the inverse is the linear convolution of the new input
+                std::copy_n (accumulator.data(), spectrumSize, work.data());
+                fft.performRealOnlyInverseTransform (work.data());
+                std::copy_n (work.data() + partitionSize, partitionSize, jobOutputs.data() + chan * partitionSize);
+            }
+        }
+    }
+
+    void runRemainingSteps() noexcept
+    {
+        runSteps (numStepsPerChannel * numChannels);
+    }
+
+    const ImpulseResponse::Segment& segment;
+    const int numChannels, partitionSize, spectrumSize;
+    juce::dsp::FFT fft;
+    const int numStepsPerChannel;
+    const bool isProcessedImmediately;
+    int numStepsPerTick = 1;
+
+    std::vector<float> inputBlocks, jobInputBlocks, jobOutputs, delayLines, accumulator, work;
+    int numInputFrames = 0, newestPartition = 0, nextStep = 0;
+    int64_t jobOutputStart = 0;
+
+    std::atomic<JobState> jobState { JobState::idle };
+    std::atomic<int> numTimesQueued { 0 };
+};
+
+//==============================================================================
+/** Processes the tails of all the convolvers using the background thread. */
+class PartitionedConvolver::TailThread
+{
+public:
+    TailThread()
+    {
+        jobs.reset (1024);
+        thread = std::thread ([this] { run(); });
+    }
+
+    ~TailThread()
+    {
+        waitingToExitFlag.test_and_set();
+        event.signal();
+        thread.join();
+    }
+
+    /** Queues a segment's job. Returns false if the queue is full. */
+    bool push (SegmentState& segment) noexcept
+    {
+        ++segment.numTimesQueued;
+
+        if (! jobs.push (&segment))
+        {
+            --segment.numTimesQueued;
+            return false;
+        }
+
+        event.signal();
+        return true;
+    }
+
+private:
+    choc::fifo::SingleReaderMultipleWriterFIFO<SegmentState*> jobs;
+    std::thread thread;
+    juce::WaitableEvent event;
+    std::atomic_flag waitingToExitFlag = ATOMIC_FLAG_INIT;
+
+    void run()
+    {
+        juce::Thread::setCurrentThreadName ("Convolution tail");
+
+        while (! waitingToExitFlag.test (std::memory_order_acquire))
+        {
+            SegmentState* segment = nullptr;
+
+            while (jobs.pop (segment))
+            {
+                // If the audio thread has already taken over the job it'll be running or finished
+                auto expected = SegmentState::JobState::pending;
+
+                if (segment->jobState.compare_exchange_strong (expected, SegmentState::JobState::running))
+                {
+                    segment->runRemainingSteps();
+                    segment->jobState.store (SegmentState::JobState::finished, std::memory_order_release);
+                }
+
+                // N.B. the segment can be deleted as soon as this reaches zero
+                segment->numTimesQueued.fetch_sub (1, std::memory_order_release);
+            }
+
+            event.wait (-1);
+        }
+    }
+};
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver (ImpulseResponsePtr ir, int numChannelsToUse, TailProcessing tailProcessingToUse)
+    : impulseResponse (std::move (ir)),
+      numChannels (numChannelsToUse),
+      headSize (impulseResponse->getOptions().headSize),
+      tailProcessing (tailProcessingToUse)
+{
+    jassert (impulseResponse != nullptr);
+
+    int ringSize = headSize;
+
+    for (auto& segment : impulseResponse->segments)
+    {
+        segmentStates.push_back (std::make_unique<SegmentState> (segment, numChannels, headSize));
+        ringSize = std::max (ringSize, segment.irOffset + segment.partitionSize);
+    }
+
+    // The ring holds the output of the partitions until it's needed
+    ringSize = juce::nextPowerOfTwo (ringSize + headSize);
+    ringMask = ringSize - 1;
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        headHistories.emplace_back (static_cast<size_t> (headSize * 2));
+        outputRings.emplace_back (static_cast<size_t> (ringSize));
+    }
+
+    if (tailProcessing == TailProcessing::backgroundThread)
+        tailThread = std::make_unique<juce::SharedResourcePointer<TailThread>>();
+
+    reset();
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+    for (auto& segment : segmentStates)
+    {
+        finishJob (*segment);
+
+        // Wait for the background thread to be done with the segment
+        while (segment->numTimesQueued.load (std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+    }
+}
+
+void PartitionedConvolver::reset()
+{
+    for (auto& segment : segmentStates)
+    {
+        finishJob (*segment);
+        segment->clear();
+    }
+
+    for (auto& history : headHistories)
+        std::fill (history.begin(), history.end(), 0.0f);
+
+    for (auto& ring : outputRings)
+        std::fill (ring.begin(), ring.end(), 0.0f);
+
+    tickPosition = 0;
+    numSamplesProcessed = 0;
+}
+
+void PartitionedConvolver::process (float* const* channels, int numChannelsToProcess, int numSamples) noexcept
+{
+    numChannelsToProcess = std::min (numChannelsToProcess, numChannels);
+    const auto numIRChannels = impulseResponse->getNumChannels();
+
+    for (int done = 0; done < numSamples;)
+    {
+        // Audio is processed up to the end of each head sized tick
+        const int numThisTime = std::min (numSamples - done, headSize - tickPosition);
+
+        for (int chan = 0; chan < numChannelsToProcess; ++chan)
+        {
+            auto data = channels[chan] + done;
+            auto history = headHistories[static_cast<size_t> (chan)].data();
+            auto ring = outputRings[static_cast<size_t> (chan)].data();
+            auto taps = impulseResponse->reversedHeads[static_cast<size_t> (std::min (chan, numIRChannels - 1))].data();
+
+            std::copy_n (data, numThisTime, history + headSize + tickPosition);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                // The head is convolved directly so the output has no latency
+                auto input = history + tickPosition + i + 1;
+                float sum = 0.0f;
+
+                for (int tap = 0; tap < headSize; ++tap)
+                    sum += taps[tap] * input[tap];
+
+                auto& ringSample = ring[(numSamplesProcessed + i) & ringMask];
+                data[i] = sum + ringSample;
+                ringSample = 0.0f;
+            }
+        }
+
+        done += numThisTime;
+        tickPosition += numThisTime;
+        numSamplesProcessed += numThisTime;
+
+        if (tickPosition == headSize)
+        {
+            processTick();
+            tickPosition = 0;
+        }
+    }
+}
+
+//==============================================================================
+void PartitionedConvolver::processTick() noexcept
+{
+    for (auto& history : headHistories)
+        std::copy_n (history.data() + headSize, headSize, history.data());
+
+    for (auto& segmentPtr : segmentStates)
+    {
+        auto& segment = *segmentPtr;
+        const auto partitionSize = segment.partitionSize;
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            std::copy_n (headHistories[static_cast<size_t> (chan)].data(), headSize,
+                         segment.inputBlocks.data() + chan * partitionSize * 2 + partitionSize + segment.numInputFrames);
+
+        segment.numInputFrames += headSize;
+
+        if (segment.numInputFrames < partitionSize)
+        {
+            if (tailProcessing == TailProcessing::audioThread && segment.jobState == SegmentState::JobState::running)
+                segment.runSteps (segment.numStepsPerTick);
+
+            continue;
+        }
+
+        // The previous job's output is due to start playing after this partition
+        finishJob (segment);
+        addJobOutput (segment);
+        startJob (segment);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto block = segment.inputBlocks.data() + chan * partitionSize * 2;
+            std::copy_n (block + partitionSize, partitionSize, block);
+        }
+
+        segment.numInputFrames = 0;
+    }
+}
+
+void PartitionedConvolver::startJob (SegmentState& segment) noexcept
+{
+    segment.jobInputBlocks = segment.inputBlocks;
+    segment.newestPartition = (segment.newestPartition + 1) % segment.segment.numPartitions;
+    segment.nextStep = 0;
+
+    // The output covers the partition that's just been received, delayed by its position in the IR
+    segment.jobOutputStart = numSamplesProcessed - segment.partitionSize + segment.segment.irOffset;
+
+    if (segment.isProcessedImmediately)
+    {
+        segment.runRemainingSteps();
+        segment.jobState = SegmentState::JobState::finished;
+        addJobOutput (segment);
+        return;
+    }
+
+    if (tailProcessing == TailProcessing::backgroundThread)
+    {
+        segment.jobState.store (SegmentState::JobState::pending, std::memory_order_release);
+
+        // If the queue is full, the job gets done when it's finished
+        (*tailThread)->push (segment);
+    }
+    else
+    {
+        segment.jobState = SegmentState::JobState::running;
+        segment.runSteps (segment.numStepsPerTick);
+    }
+}
+
+void PartitionedConvolver::finishJob (SegmentState& segment) noexcept
+{
+    auto expected = SegmentState::JobState::pending;
+
+    if (segment.jobState.compare_exchange_strong (expected, SegmentState::JobState::running))
+    {
+        // The background thread hasn't got to this yet so do it here
+        segment.runRemainingSteps();
+        segment.jobState.store (SegmentState::JobState::finished, std::memory_order_release);
+        return;
+    }
+
+    if (tailProcessing == TailProcessing::audioThread)
+    {
+        if (segment.jobState == SegmentState::JobState::running)
+        {
+            segment.runRemainingSteps();
+            segment.jobState = SegmentState::JobState::finished;
+        }
+
+        return;
+    }
+
+    while (segment.jobState.load (std::memory_order_acquire) == SegmentState::JobState::running)
+        std::this_thread::yield();
+}
+
+void PartitionedConvolver::addJobOutput (SegmentState& segment) noexcept
+{
+    if (segment.jobState != SegmentState::JobState::finished)
+        return;
+
+    segment.jobState = SegmentState::JobState::idle;
+
+    // This should always be in the future or it'll be missed
+    jassert (segment.jobOutputStart >= numSamplesProcessed);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto ring = outputRings[static_cast<size_t> (chan)].data();
+        auto output = segment.jobOutputs.data() + chan * segment.partitionSize;
+
+        for (int i = 0; i < segment.partitionSize; ++i)
+            ring[(segment.jobOutputStart + i) & ringMask] += output[i];
+    }
+}
+
+} // namespace tracktion::inline engine
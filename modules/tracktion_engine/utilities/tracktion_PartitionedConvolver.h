@@ -0,0 +1,148 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Convolves audio with an impulse response without adding any latency.
+
+    The IR is split into partitions which get larger further into the IR. The
+    first few taps are convolved directly, the rest of the head uses small FFT
+    partitions processed as the audio arrives and the larger tail partitions are
+    processed while the following blocks play. This keeps the cost per sample
+    close to that of the largest partition size while the output starts
+    immediately.
+
+    The tail can either be processed on the audio thread, spread over the blocks
+    before it's needed, or on a background thread shared by all convolvers.
+
+    The transformed partitions are held in an ImpulseResponse which is immutable
+    so can be shared by any number of convolvers, e.g. several plugins using the
+    same IR, @see SharedAudioDataStore.
+*/
+class PartitionedConvolver
+{
+public:
+    //==============================================================================
+    /** Determines how an IR is partitioned. */
+    struct Options
+    {
+        int headSize = 64;              ///< The number of taps convolved directly, also the smallest partition size. Must be a power of 2.
+        int maxPartitionSize = 16384;   ///< The largest partition size. Must be a power of 2.
+    };
+
+    //==============================================================================
+    /** The transformed partitions of an impulse response. */
+    class ImpulseResponse
+    {
+    public:
+        /** Partitions and transforms an IR.
+            The IR should be at the sample rate the convolver will be used at.
+        */
+        ImpulseResponse (const juce::AudioBuffer<float>&, Options);
+
+        /** Returns the number of channels in the IR. */
+        int getNumChannels() const noexcept             { return numChannels; }
+
+        /** Returns the length of the IR in samples. */
+        int getLength() const noexcept                  { return length; }
+
+        /** Returns the options the IR was partitioned with. */
+        const Options& getOptions() const noexcept      { return options; }
+
+        /** Returns the number of bytes used by the transformed partitions. */
+        size_t getMemoryUsage() const noexcept;
+
+    private:
+        friend class PartitionedConvolver;
+
+        struct Segment
+        {
+            int partitionSize = 0, numPartitions = 0, irOffset = 0;
+            std::vector<std::vector<float>> spectra;    // One block of partitions per channel
+        };
+
+        Options options;
+        int numChannels = 0, length = 0;
+        std::vector<std::vector<float>> reversedHeads;  // The directly convolved taps, reversed
+        std::vector<Segment> segments;
+    };
+
+    using ImpulseResponsePtr = std::shared_ptr<const ImpulseResponse>;
+
+    /** Returns an ImpulseResponse from a store, shared with any other users of
+        the same key. If there isn't one already, createImpulseResponse is called
+        to get the audio data which is then partitioned. The key should identify
+        the source data along with anything done to it, e.g. the sample rate it's
+        been resampled to.
+    */
+    static ImpulseResponsePtr getSharedImpulseResponse (SharedAudioDataStore&, SharedAudioDataStore::Key,
+                                                        const std::function<juce::AudioBuffer<float>()>& createImpulseResponse,
+                                                        Options);
+
+    //==============================================================================
+    /** How the tail partitions are processed. */
+    enum class TailProcessing
+    {
+        audioThread,        ///< The tail is processed on the audio thread, spread over the blocks before it's needed.
+        backgroundThread    ///< The tail is processed on a background thread shared by all convolvers.
+    };
+
+    /** Creates a convolver for an IR and a number of input channels.
+        If the IR has fewer channels than the input, the last IR channel is
+        used for the remaining channels.
+    */
+    PartitionedConvolver (ImpulseResponsePtr, int numChannels,
+                          TailProcessing = TailProcessing::backgroundThread);
+
+    /** Destructor. */
+    ~PartitionedConvolver();
+
+    /** Returns the IR being used. */
+    const ImpulseResponsePtr& getImpulseResponse() const noexcept   { return impulseResponse; }
+
+    /** Clears the convolution history.
+        This must not be called at the same time as process().
+    */
+    void reset();
+
+    /** Convolves some audio in place.
+        This doesn't allocate but if the tail is processed on the background
+        thread and that falls behind, this will wait for it or take over the work.
+    */
+    void process (float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct SegmentState;
+    class TailThread;
+
+    ImpulseResponsePtr impulseResponse;
+    const int numChannels, headSize;
+    const TailProcessing tailProcessing;
+
+    std::vector<std::vector<float>> headHistories, outputRings;
+    std::vector<std::unique_ptr<SegmentState>> segmentStates;
+    int ringMask = 0, tickPosition = 0;
+    int64_t numSamplesProcessed = 0;
+
+    std::unique_ptr<juce::SharedResourcePointer<TailThread>> tailThread;
+
+    void processTick() noexcept;
+    void startJob (SegmentState&) noexcept;
+    void finishJob (SegmentState&) noexcept;
+    void addJobOutput (SegmentState&) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+};
+
+} // namespace tracktion::inline engine
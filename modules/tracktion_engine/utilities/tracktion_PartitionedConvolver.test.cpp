@@ -0,0 +1,267 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_PARTITIONED_CONVOLVER) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_PARTITIONED_CONVOLVER)
+
+namespace tracktion::inline engine
+{
+
+namespace partitioned_convolver_test_utilities
+{
+    /** Returns a decaying noise IR. */
+    inline juce::AudioBuffer<float> createImpulseResponse (int numChannels, int numSamples, juce::Random& r)
+    {
+        juce::AudioBuffer<float> ir (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                ir.setSample (chan, i, (r.nextFloat() * 2.0f - 1.0f) * std::exp (-4.0f * (float) i / (float) numSamples));
+
+        return ir;
+    }
+
+    /** Returns a buffer of noise. */
+    inline juce::AudioBuffer<float> createNoise (int numChannels, int numSamples, juce::Random& r)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (chan, i, r.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_PARTITIONED_CONVOLVER
+
+//==============================================================================
+//==============================================================================
+class PartitionedConvolverTests  : public juce::UnitTest
+{
+public:
+    PartitionedConvolverTests()
+        : juce::UnitTest ("PartitionedConvolver", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using TailProcessing = PartitionedConvolver::TailProcessing;
+
+        for (auto tailProcessing : { TailProcessing::audioThread, TailProcessing::backgroundThread })
+        {
+            const auto suffix = juce::String (tailProcessing == TailProcessing::audioThread ? " (audio thread)" : " (background thread)");
+
+            beginTest ("Short IRs" + suffix);
+            {
+                for (int length : { 1, 20, 64 })
+                    expectMatchesDirectConvolution (length, 1, tailProcessing);
+            }
+
+            beginTest ("Long IRs" + suffix);
+            {
+                for (int length : { 100, 1'000, 10'000 })
+                    expectMatchesDirectConvolution (length, 2, tailProcessing);
+            }
+        }
+
+        beginTest ("Shared impulse responses");
+        {
+            juce::Random r (42);
+            SharedAudioDataStore store;
+            int numTimesCreated = 0;
+
+            auto create = [&]
+            {
+                ++numTimesCreated;
+                return partitioned_convolver_test_utilities::createImpulseResponse (2, 1'000, r);
+            };
+
+            auto ir1 = PartitionedConvolver::getSharedImpulseResponse (store, SharedAudioDataStore::Key().add (1234), create, {});
+            auto ir2 = PartitionedConvolver::getSharedImpulseResponse (store, SharedAudioDataStore::Key().add (1234), create, {});
+            expect (ir1 == ir2);
+            expectEquals (numTimesCreated, 1);
+
+            auto ir3 = PartitionedConvolver::getSharedImpulseResponse (store, SharedAudioDataStore::Key().add (5678), create, {});
+            expect (ir1 != ir3);
+            expectEquals (numTimesCreated, 2);
+            expectEquals (store.getStatistics().numItems, (size_t) 2);
+
+            ir1.reset();
+            ir2.reset();
+            PartitionedConvolver::getSharedImpulseResponse (store, SharedAudioDataStore::Key().add (1234), create, {});
+            expectEquals (numTimesCreated, 3);
+        }
+    }
+
+private:
+    void expectMatchesDirectConvolution (int irLength, int numIRChannels, PartitionedConvolver::TailProcessing tailProcessing)
+    {
+        using namespace partitioned_convolver_test_utilities;
+
+        juce::Random r (irLength);
+        const int numChannels = 2, numSamples = 20'000;
+        const auto irBuffer = createImpulseResponse (numIRChannels, irLength, r);
+        const auto input = createNoise (numChannels, numSamples, r);
+
+        // Small partitions so even the short IRs use several segments
+        auto ir = std::make_shared<const PartitionedConvolver::ImpulseResponse> (irBuffer, PartitionedConvolver::Options { 16, 1024 });
+        PartitionedConvolver convolver (ir, numChannels, tailProcessing);
+
+        auto output = input;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int numThisTime = std::min (numSamples - start, r.nextInt ({ 1, 700 }));
+            float* channels[] = { output.getWritePointer (0, start), output.getWritePointer (1, start) };
+            convolver.process (channels, numChannels, numThisTime);
+            start += numThisTime;
+        }
+
+        float maxError = 0.0f;
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto irData = irBuffer.getReadPointer (std::min (chan, numIRChannels - 1));
+            auto inputData = input.getReadPointer (chan);
+
+            for (int i = 0; i < numSamples; i += 7)
+            {
+                double expected = 0.0;
+
+                for (int tap = 0; tap < std::min (irLength, i + 1); ++tap)
+                    expected += irData[tap] * inputData[i - tap];
+
+                maxError = std::max (maxError, std::abs ((float) expected - output.getSample (chan, i)));
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-3f, "IR length: " + juce::String (irLength));
+    }
+};
+
+static PartitionedConvolverTests partitionedConvolverTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_PARTITIONED_CONVOLVER
+
+//==============================================================================
+//==============================================================================
+class PartitionedConvolverBenchmarks  : public juce::UnitTest
+{
+public:
+    PartitionedConvolverBenchmarks()
+        : juce::UnitTest ("PartitionedConvolver", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Benchmark: Convolution");
+        {
+            // A long reverb IR at a high sample rate
+            constexpr double sampleRate = 96'000.0;
+            juce::Random r (42);
+            const auto ir = partitioned_convolver_test_utilities::createImpulseResponse (2, (int) (sampleRate * 6.0), r);
+            const auto input = partitioned_convolver_test_utilities::createNoise (2, (int) (sampleRate * 10.0), r);
+
+            for (int blockSize : { 64, 512 })
+            {
+                const auto suffix = " (6s IR, 96KHz, " + std::to_string (blockSize) + " sample blocks)";
+                benchmarkJUCEConvolution (ir, input, sampleRate, blockSize, "juce::dsp::Convolution" + suffix);
+                benchmarkPartitionedConvolver (ir, input, blockSize, PartitionedConvolver::TailProcessing::audioThread,
+                                               "PartitionedConvolver, audio thread" + suffix);
+                benchmarkPartitionedConvolver (ir, input, blockSize, PartitionedConvolver::TailProcessing::backgroundThread,
+                                               "PartitionedConvolver, background thread" + suffix);
+            }
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    template<typename ProcessFunction>
+    static void processInBlocks (const juce::AudioBuffer<float>& input, int blockSize, ProcessFunction&& process)
+    {
+        juce::AudioBuffer<float> block (input.getNumChannels(), blockSize);
+
+        for (int start = 0; start + blockSize <= input.getNumSamples(); start += blockSize)
+        {
+            for (int chan = 0; chan < input.getNumChannels(); ++chan)
+                block.copyFrom (chan, 0, input, chan, start, blockSize);
+
+            process (block);
+        }
+    }
+
+    void benchmarkJUCEConvolution (const juce::AudioBuffer<float>& ir, const juce::AudioBuffer<float>& input,
+                                   double sampleRate, int blockSize, std::string name)
+    {
+        juce::dsp::Convolution convolution;
+        convolution.prepare ({ sampleRate, (juce::uint32) blockSize, (juce::uint32) input.getNumChannels() });
+
+        auto irCopy = ir;
+        convolution.loadImpulseResponse (std::move (irCopy), sampleRate,
+                                         juce::dsp::Convolution::Stereo::yes,
+                                         juce::dsp::Convolution::Trim::no,
+                                         juce::dsp::Convolution::Normalise::no);
+
+        // The IR is loaded on a background thread and swapped in during processing
+        {
+            juce::AudioBuffer<float> block (input.getNumChannels(), blockSize);
+
+            for (int i = 0; i < 1'000 && convolution.getCurrentIRSize() == 0; ++i)
+            {
+                juce::dsp::AudioBlock<float> audioBlock (block);
+                convolution.process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
+                std::this_thread::sleep_for (std::chrono::milliseconds (10));
+            }
+
+            expect (convolution.getCurrentIRSize() > 0);
+        }
+
+        ScopedBenchmark sb (getDescription (name));
+
+        processInBlocks (input, blockSize, [&] (auto& block)
+        {
+            juce::dsp::AudioBlock<float> audioBlock (block);
+            convolution.process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
+        });
+    }
+
+    void benchmarkPartitionedConvolver (const juce::AudioBuffer<float>& ir, const juce::AudioBuffer<float>& input,
+                                        int blockSize, PartitionedConvolver::TailProcessing tailProcessing, std::string name)
+    {
+        PartitionedConvolver convolver (std::make_shared<const PartitionedConvolver::ImpulseResponse> (ir, PartitionedConvolver::Options()),
+                                        input.getNumChannels(), tailProcessing);
+
+        ScopedBenchmark sb (getDescription (name));
+
+        processInBlocks (input, blockSize, [&] (auto& block)
+        {
+            convolver.process (block.getArrayOfWritePointers(), block.getNumChannels(), block.getNumSamples());
+        });
+    }
+};
+
+static PartitionedConvolverBenchmarks partitionedConvolverBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -0,0 +1,83 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+SharedAudioDataStore::Key& SharedAudioDataStore::Key::add (std::string_view newData)
+{
+    // The size goes first so the parts of a key can't run into one another
+    add (newData.size());
+    data.append (newData);
+    return *this;
+}
+
+SharedAudioDataStore::Key SharedAudioDataStore::createKey (const void* data, size_t numBytes)
+{
+    return Key().add (std::string_view (static_cast<const char*> (data), numBytes));
+}
+
+SharedAudioDataStore::Key SharedAudioDataStore::createKey (const AudioFile& audioFile)
+{
+    // Copying the contents of large files would be too slow so use the
+    // modification time and size to spot files that have changed
+    const auto file = audioFile.getFile();
+
+    return Key().add (file.getFullPathName().toStdString())
+                .add (file.getLastModificationTime().toMilliseconds())
+                .add (file.getSize());
+}
+
+SharedAudioDataStore::Statistics SharedAudioDataStore::getStatistics()
+{
+    const std::scoped_lock sl (mutex);
+    Statistics stats;
+
+    for (auto& [key, item] : items)
+    {
+        if (item.item.expired())
+            continue;
+
+        ++stats.numItems;
+        stats.numBytes += item.numBytes;
+    }
+
+    return stats;
+}
+
+std::shared_ptr<const void> SharedAudioDataStore::findItem (const Key& key)
+{
+    const std::scoped_lock sl (mutex);
+
+    if (auto found = items.find (key); found != items.end())
+        return found->second.item.lock();
+
+    return {};
+}
+
+std::shared_ptr<const void> SharedAudioDataStore::addItem (Key key, std::shared_ptr<const void> newItem, size_t numBytes)
+{
+    const std::scoped_lock sl (mutex);
+
+    // Another thread may have created this while we were
+    auto& item = items[std::move (key)];
+
+    if (auto existing = item.item.lock())
+        return existing;
+
+    item = { newItem, numBytes };
+
+    // Remove any items that are no longer used while we've got the lock
+    std::erase_if (items, [] (auto& entry) { return entry.second.item.expired(); });
+
+    return newItem;
+}
+
+} // namespace tracktion::inline engine
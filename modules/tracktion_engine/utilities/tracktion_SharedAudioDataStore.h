@@ -0,0 +1,183 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+/**
+    Shares decoded audio and data derived from it between the objects that use
+    it, e.g. several plugins loading the same IR or sample.
+
+    Items are looked up by a key that should identify the source data (e.g. the
+    contents of the file) along with anything done to it (e.g. the sample rate
+    it's been resampled to). If there's no live item for a key, it's created with the
+    given function. Items are held by the users as shared pointers to const and
+    are freed as soon as the last user lets go of them, so memory scales with
+    the number of unique items rather than the number of users.
+
+    As items are shared they must never be modified. To change one, take a copy,
+    modify that and add it under a new key.
+
+    The Engine holds one of these, @see Engine::getSharedAudioDataStore
+*/
+class SharedAudioDataStore
+{
+public:
+    //==============================================================================
+    /** Creates an empty store. */
+    SharedAudioDataStore() = default;
+
+    /** A shared, immutable item. */
+    template<typename ItemType>
+    using Ptr = std::shared_ptr<const ItemType>;
+
+    //==============================================================================
+    /** Identifies an item.
+        This holds every part of the key rather than a hash of them, and lookups
+        compare the whole key, so different items are never mistaken for one another.
+    */
+    class Key
+    {
+    public:
+        /** Creates an empty key. */
+        Key() = default;
+
+        /** Appends a value to the key, e.g. a sample rate or an offset. */
+        template<typename Type>
+        requires std::is_arithmetic_v<Type> || std::is_enum_v<Type>
+        Key& add (Type value)
+        {
+            data.append (reinterpret_cast<const char*> (&value), sizeof (value));
+            return *this;
+        }
+
+        /** Appends a block of data to the key, e.g. a path or the contents of a file. */
+        Key& add (std::string_view);
+
+        bool operator== (const Key&) const = default;
+
+        /** Returns a hash of the key for looking it up. */
+        size_t getHash() const                      { return std::hash<std::string>() (data); }
+
+        /** Returns the number of bytes the key holds. */
+        size_t getSize() const                      { return data.size(); }
+
+    private:
+        std::string data;
+    };
+
+    /** Returns the item for a key, creating it if there isn't one already.
+        The create function is called without the store being locked so may take
+        a while (e.g. decoding a file). If two threads create the same item at
+        the same time, the first one added is returned to both.
+        Keys are specific to the item type so the same key can be used for
+        different types of data derived from the same source.
+    */
+    template<typename ItemType, typename CreateFunction>
+    Ptr<ItemType> getOrCreate (Key, CreateFunction&& createItem);
+
+    /** Returns the item for a key if there's a live one, otherwise nullptr. */
+    template<typename ItemType>
+    Ptr<ItemType> find (Key);
+
+    //==============================================================================
+    /** Returns a key for a block of data, e.g. the contents of a file.
+        The key holds a copy of the data so this is meant for small blocks like
+        IR files. Larger sources should be identified some other way.
+    */
+    static Key createKey (const void* data, size_t numBytes);
+
+    /** Returns a key for an AudioFile. */
+    static Key createKey (const AudioFile&);
+
+    //==============================================================================
+    /** Describes the items currently in the store. */
+    struct Statistics
+    {
+        size_t numItems = 0;        ///< The number of live items.
+        size_t numBytes = 0;        ///< The size of the live items, for types where this is known.
+    };
+
+    /** Returns the current statistics. */
+    Statistics getStatistics();
+
+private:
+    //==============================================================================
+    struct Item
+    {
+        std::weak_ptr<const void> item;
+        size_t numBytes = 0;
+    };
+
+    std::mutex mutex;
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const    { return key.getHash(); }
+    };
+
+    std::unordered_map<Key, Item, KeyHash> items;
+
+    std::shared_ptr<const void> findItem (const Key&);
+    std::shared_ptr<const void> addItem (Key, std::shared_ptr<const void>, size_t numBytes);
+
+    template<typename ItemType>
+    static Key getKeyForType (Key key)
+    {
+        key.add (typeid (ItemType).name());
+        return key;
+    }
+
+    template<typename ItemType>
+    static size_t getSizeInBytes (const ItemType& item)
+    {
+        if constexpr (std::is_same_v<ItemType, juce::AudioBuffer<float>>)
+            return (size_t) item.getNumChannels() * (size_t) item.getNumSamples() * sizeof (float);
+        else if constexpr (requires { item.getMemoryUsage(); })
+            return item.getMemoryUsage();
+        else
+            return 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedAudioDataStore)
+};
+
+
+//==============================================================================
+//        _        _           _  _
+//     __| |  ___ | |_   __ _ (_)| | ___
+//    / _` | / _ \| __| / _` || || |/ __|
+//   | (_| ||  __/| |_ | (_| || || |\__ \ _  _  _
+//    \__,_| \___| \__| \__,_||_||_||___/(_)(_)(_)
+//
+//   Code beyond this point is implementation detail...
+//
+//==============================================================================
+template<typename ItemType, typename CreateFunction>
+SharedAudioDataStore::Ptr<ItemType> SharedAudioDataStore::getOrCreate (Key key, CreateFunction&& createItem)
+{
+    key = getKeyForType<ItemType> (std::move (key));
+
+    if (auto existing = findItem (key))
+        return std::static_pointer_cast<const ItemType> (existing);
+
+    auto newItem = std::make_shared<const ItemType> (createItem());
+    const auto numBytes = getSizeInBytes (*newItem);
+
+    return std::static_pointer_cast<const ItemType> (addItem (std::move (key), std::move (newItem), numBytes));
+}
+
+template<typename ItemType>
+SharedAudioDataStore::Ptr<ItemType> SharedAudioDataStore::find (Key key)
+{
+    return std::static_pointer_cast<const ItemType> (findItem (getKeyForType<ItemType> (std::move (key))));
+}
+
+} // namespace tracktion::inline engine
@@ -0,0 +1,94 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_SHARED_AUDIO_DATA_STORE
+
+namespace tracktion::inline engine
+{
+
+//==============================================================================
+//==============================================================================
+class SharedAudioDataStoreTests  : public juce::UnitTest
+{
+public:
+    SharedAudioDataStoreTests()
+        : juce::UnitTest ("SharedAudioDataStore", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        SharedAudioDataStore store;
+        int numTimesCreated = 0;
+
+        auto key = [] (int id) { return SharedAudioDataStore::Key().add (id); };
+
+        auto createBuffer = [&]
+        {
+            ++numTimesCreated;
+            juce::AudioBuffer<float> buffer (2, 1'000);
+            buffer.clear();
+            return buffer;
+        };
+
+        beginTest ("Sharing items");
+        {
+            auto item1 = store.getOrCreate<juce::AudioBuffer<float>> (key (1), createBuffer);
+            auto item2 = store.getOrCreate<juce::AudioBuffer<float>> (key (1), createBuffer);
+            expect (item1 == item2);
+            expectEquals (numTimesCreated, 1);
+            expect (store.find<juce::AudioBuffer<float>> (key (1)) == item1);
+
+            auto stats = store.getStatistics();
+            expectEquals (stats.numItems, (size_t) 1);
+            expectEquals (stats.numBytes, (size_t) 2'000 * sizeof (float));
+
+            auto item3 = store.getOrCreate<juce::AudioBuffer<float>> (key (2), createBuffer);
+            expect (item1 != item3);
+            expectEquals (numTimesCreated, 2);
+            expectEquals (store.getStatistics().numItems, (size_t) 2);
+        }
+
+        beginTest ("Keys are specific to the item type");
+        {
+            auto buffer = store.getOrCreate<juce::AudioBuffer<float>> (key (3), createBuffer);
+            auto number = store.getOrCreate<int> (key (3), [] { return 42; });
+            expectEquals (*number, 42);
+            expect (store.find<int> (key (3)) == number);
+            expect (store.find<int> (key (4)) == nullptr);
+        }
+
+        beginTest ("Items are freed when no longer used");
+        {
+            expectEquals (store.getStatistics().numItems, (size_t) 0);
+            expect (store.find<juce::AudioBuffer<float>> (key (1)) == nullptr);
+
+            numTimesCreated = 0;
+            auto item = store.getOrCreate<juce::AudioBuffer<float>> (key (1), createBuffer);
+            expectEquals (numTimesCreated, 1);
+        }
+
+        beginTest ("Keys");
+        {
+            const char data1[] = "abcdef", data2[] = "abcdeg";
+            expect (SharedAudioDataStore::createKey (data1, sizeof (data1)) == SharedAudioDataStore::createKey (data1, sizeof (data1)));
+            expect (SharedAudioDataStore::createKey (data1, sizeof (data1)) != SharedAudioDataStore::createKey (data2, sizeof (data2)));
+
+            // The whole key is kept so ones with the same bytes split differently don't match
+            expect (SharedAudioDataStore::Key().add ("ab").add ("c") != SharedAudioDataStore::Key().add ("a").add ("bc"));
+            expect (SharedAudioDataStore::Key().add (1) != SharedAudioDataStore::Key().add (1.0));
+        }
+    }
+};
+
+static SharedAudioDataStoreTests sharedAudioDataStoreTests;
+
+} // namespace tracktion::inline engine
+
+#endif
@@ -249,6 +249,230 @@ public:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeObjectList)
 };
 
+//==============================================================================
+/**
+    A ValueTreeObjectList that also remembers where each object's state is in the
+    parent tree.
+
+    The plain list finds objects by comparing every object's state and keeps them
+    in order by calling parent.indexOf for each comparison, so adding, removing or
+    moving children is O(n) at best and lists with thousands of children become
+    very slow to build and edit.
+    This keeps the child index of each object alongside it so objects can be found
+    with a binary search and appending, the most common case, needs no search.
+
+    It's used in exactly the same way as a ValueTreeObjectList, just make sure
+    rebuildObjects is called on this class rather than the base.
+*/
+template<typename ObjectType, typename CriticalSectionType = juce::DummyCriticalSection>
+class IndexedValueTreeObjectList   : public ValueTreeObjectList<ObjectType, CriticalSectionType>
+{
+public:
+    using BaseType = ValueTreeObjectList<ObjectType, CriticalSectionType>;
+    using ScopedLockType = typename BaseType::ScopedLockType;
+
+    IndexedValueTreeObjectList (const juce::ValueTree& parentTree)
+        : BaseType (parentTree)
+    {
+    }
+
+    // call in the sub-class when being created
+    void rebuildObjects()
+    {
+        jassert (this->objects.isEmpty()); // must only call this method once at construction
+
+        for (int i = 0; i < this->parent.getNumChildren(); ++i)
+        {
+            auto v = this->parent.getChild (i);
+
+            if (this->isSuitableType (v))
+            {
+                if (auto newObject = this->createNewObject (v))
+                {
+                    this->objects.add (newObject);
+                    positions.push_back (i);
+                }
+            }
+        }
+    }
+
+    /** Returns the object for a given state, or nullptr if it isn't in the list. */
+    ObjectType* getObjectFor (const juce::ValueTree& v) const noexcept
+    {
+        const auto index = indexOf (v);
+        return index >= 0 ? this->objects.getUnchecked (index) : nullptr;
+    }
+
+    //==============================================================================
+    void valueTreeChildAdded (juce::ValueTree& parentTree, juce::ValueTree& tree) override
+    {
+        if (parentTree != this->parent)
+            return;
+
+        jassert (positions.size() == (size_t) this->objects.size()); // rebuildObjects must be called on this class
+
+        // Most children are appended so check the end before searching
+        const auto numChildren = this->parent.getNumChildren();
+        const auto childIndex = this->parent.getChild (numChildren - 1) == tree ? numChildren - 1
+                                                                                 : this->parent.indexOf (tree);
+        jassert (childIndex >= 0);
+
+        const auto slot = getFirstSlotAtOrAfter (childIndex);
+        ObjectType* newObject = nullptr;
+
+        if (this->isSuitableType (tree))
+        {
+            newObject = this->createNewObject (tree);
+            jassert (newObject != nullptr);
+        }
+
+        {
+            const ScopedLockType sl (this->arrayLock);
+            offsetPositions (slot, positions.size(), 1);
+
+            if (newObject != nullptr)
+            {
+                this->objects.insert ((int) slot, newObject);
+                positions.insert (positions.begin() + (std::ptrdiff_t) slot, childIndex);
+            }
+        }
+
+        if (newObject != nullptr)
+            this->newObjectAdded (newObject);
+    }
+
+    void valueTreeChildRemoved (juce::ValueTree& exParent, juce::ValueTree& tree, int childIndex) override
+    {
+        if (exParent != this->parent)
+            return;
+
+        jassert (positions.size() == (size_t) this->objects.size()); // rebuildObjects must be called on this class
+
+        auto slot = getFirstSlotAtOrAfter (childIndex);
+        ObjectType* o = nullptr;
+
+        {
+            const ScopedLockType sl (this->arrayLock);
+
+            if (slot < positions.size() && positions[slot] == childIndex)
+            {
+                jassert (this->objects.getUnchecked ((int) slot)->state == tree);
+                o = this->objects.removeAndReturn ((int) slot);
+                positions.erase (positions.begin() + (std::ptrdiff_t) slot);
+            }
+
+            offsetPositions (slot, positions.size(), -1);
+        }
+
+        if (o != nullptr)
+        {
+            this->objectRemoved (o);
+            this->deleteObject (o);
+        }
+    }
+
+    void valueTreeChildOrderChanged (juce::ValueTree& tree, int oldIndex, int newIndex) override
+    {
+        if (tree != this->parent)
+            return;
+
+        {
+            const ScopedLockType sl (this->arrayLock);
+
+            // Sorting the tree doesn't say what moved so everything has to be found again
+            if (oldIndex == newIndex)
+                resyncPositions();
+            else
+                moveChild (oldIndex, newIndex);
+        }
+
+        this->objectOrderChanged();
+    }
+
+protected:
+    /** Returns the index of the object for a state, or -1 if it isn't in the list. */
+    int indexOf (const juce::ValueTree& v) const noexcept
+    {
+        const auto childIndex = this->parent.indexOf (v);
+
+        if (childIndex < 0)
+            return -1;
+
+        const auto slot = getFirstSlotAtOrAfter (childIndex);
+
+        if (slot < positions.size() && positions[slot] == childIndex)
+            return (int) slot;
+
+        return -1;
+    }
+
+private:
+    // The index of each object's state in the parent, in the same order as the objects
+    std::vector<int> positions;
+
+    size_t getFirstSlotAtOrAfter (int childIndex) const noexcept
+    {
+        return (size_t) std::distance (positions.begin(), std::lower_bound (positions.begin(), positions.end(), childIndex));
+    }
+
+    void offsetPositions (size_t start, size_t end, int delta) noexcept
+    {
+        for (auto i = start; i < end; ++i)
+            positions[i] += delta;
+    }
+
+    void moveChild (int oldIndex, int newIndex)
+    {
+        // Only the children between the two indexes change position and the
+        // moved object, if it's in the list, stays within that range
+        const auto movingUp = oldIndex < newIndex;
+        const auto start = getFirstSlotAtOrAfter (std::min (oldIndex, newIndex));
+        const auto end = getFirstSlotAtOrAfter (std::max (oldIndex, newIndex) + 1);
+        const auto oldSlot = getFirstSlotAtOrAfter (oldIndex);
+        const auto hasObject = oldSlot < positions.size() && positions[oldSlot] == oldIndex;
+
+        offsetPositions (start, end, movingUp ? -1 : 1);
+
+        if (! hasObject)
+            return;
+
+        positions[oldSlot] = newIndex;
+        auto first = (std::ptrdiff_t) (movingUp ? oldSlot : start);
+        auto middle = (std::ptrdiff_t) (movingUp ? oldSlot + 1 : oldSlot);
+        auto last = (std::ptrdiff_t) (movingUp ? end : oldSlot + 1);
+
+        std::rotate (positions.begin() + first, positions.begin() + middle, positions.begin() + last);
+        std::rotate (this->objects.begin() + first, this->objects.begin() + middle, this->objects.begin() + last);
+    }
+
+    void resyncPositions()
+    {
+        std::vector<std::pair<int, ObjectType*>> sorted;
+        sorted.reserve (positions.size());
+
+        for (auto o : this->objects)
+            sorted.emplace_back (this->parent.indexOf (o->state), o);
+
+        std::sort (sorted.begin(), sorted.end(),
+                   [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            positions[i] = sorted[i].first;
+            this->objects.setUnchecked ((int) i, sorted[i].second);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IndexedValueTreeObjectList)
+};
+
+/** Returns the object for a given state if it exists. */
+template<typename ObjectType>
+static ObjectType* getObjectFor (const IndexedValueTreeObjectList<ObjectType>& objectList, const juce::ValueTree& v)
+{
+    return objectList.getObjectFor (v);
+}
+
 //==============================================================================
 template<typename ObjectType>
 struct SortedValueTreeObjectList    : protected ValueTreeObjectList<ObjectType>
@@ -0,0 +1,215 @@
+/*
+    ,--.                     ,--.     ,--.  ,--.
+  ,-'  '-.,--.--.,--,--.,---.|  |,-.,-'  '-.`--' ,---. ,--,--,      Copyright 2024
+  '-.  .-'|  .--' ,-.  | .--'|     /'-.  .-',--.| .-. ||      \   Tracktion Software
+    |  |  |  |  \ '-'  \ `--.|  \  \  |  |  |  |' '-' '|  ||  |       Corporation
+    `---' `--'   `--`--'`---'`--'`--' `---' `--' `---' `--''--'    www.tracktion.com
+
+    Tracktion Engine uses a GPL/commercial licence - see LICENCE.md for details.
+*/
+
+#if (TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_VALUE_TREE_OBJECT_LIST) || (TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_VALUE_TREE_OBJECT_LIST)
+
+namespace tracktion::inline engine
+{
+
+namespace value_tree_object_list_test_utilities
+{
+    struct Object
+    {
+        Object (const juce::ValueTree& v) : state (v) {}
+        juce::ValueTree state;
+    };
+
+    /** Creates a list of the CLIP children of a tree using either list type. */
+    template<typename ListType>
+    struct TestList  : public ListType
+    {
+        TestList (const juce::ValueTree& v)
+            : ListType (v)
+        {
+            this->rebuildObjects();
+        }
+
+        ~TestList() override
+        {
+            this->freeObjects();
+        }
+
+        bool isSuitableType (const juce::ValueTree& v) const override   { return v.hasType (IDs::CLIP); }
+        Object* createNewObject (const juce::ValueTree& v) override     { return new Object (v); }
+        void deleteObject (Object* o) override                          { delete o; }
+
+        void newObjectAdded (Object*) override                          {}
+        void objectRemoved (Object*) override                           {}
+        void objectOrderChanged() override                              {}
+    };
+}
+
+#if TRACKTION_UNIT_TESTS && ENGINE_UNIT_TESTS_VALUE_TREE_OBJECT_LIST
+
+//==============================================================================
+//==============================================================================
+class ValueTreeObjectListTests  : public juce::UnitTest
+{
+public:
+    ValueTreeObjectListTests()
+        : juce::UnitTest ("ValueTreeObjectList", "tracktion_engine")
+    {}
+
+    void runTest() override
+    {
+        using namespace value_tree_object_list_test_utilities;
+
+        beginTest ("Indexed list matches the tree");
+        {
+            juce::Random r (42);
+            juce::ValueTree parent (IDs::TRACK);
+
+            auto createChild = [&r]
+            {
+                // Mix in some children the lists ignore
+                juce::ValueTree v (r.nextInt (3) == 0 ? IDs::PLUGIN : IDs::CLIP);
+                v.setProperty (IDs::id, r.nextInt (1000), nullptr);
+                return v;
+            };
+
+            for (int i = 0; i < 20; ++i)
+                parent.appendChild (createChild(), nullptr);
+
+            TestList<ValueTreeObjectList<Object>> list (parent);
+            TestList<IndexedValueTreeObjectList<Object>> indexedList (parent);
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                const auto numChildren = parent.getNumChildren();
+
+                switch (numChildren == 0 ? 0 : r.nextInt (5))
+                {
+                    case 0:     parent.appendChild (createChild(), nullptr); break;
+                    case 1:     parent.addChild (createChild(), r.nextInt (numChildren + 1), nullptr); break;
+                    case 2:     parent.removeChild (r.nextInt (numChildren), nullptr); break;
+                    case 3:     parent.moveChild (r.nextInt (numChildren), r.nextInt (numChildren), nullptr); break;
+                    default:
+                    {
+                        auto child = parent.getChild (r.nextInt (numChildren));
+                        auto o = getObjectFor (indexedList, child);
+                        expect (child.hasType (IDs::CLIP) ? (o != nullptr && o->state == child)
+                                                          : o == nullptr);
+                        break;
+                    }
+                }
+
+                expectEquals (indexedList.size(), list.size());
+
+                for (int j = 0; j < list.size(); ++j)
+                    expect (indexedList[j]->state == list[j]->state);
+            }
+
+            // Sorting the tree doesn't say which children moved
+            struct Sorter
+            {
+                int compareElements (const juce::ValueTree& first, const juce::ValueTree& second) const
+                {
+                    return static_cast<int> (first[IDs::id]) - static_cast<int> (second[IDs::id]);
+                }
+            };
+
+            Sorter sorter;
+            parent.sort (sorter, nullptr, false);
+
+            expectEquals (indexedList.size(), list.size());
+
+            for (int j = 0; j < list.size(); ++j)
+                expect (indexedList[j]->state == list[j]->state);
+        }
+    }
+};
+
+static ValueTreeObjectListTests valueTreeObjectListTests;
+
+#endif
+
+#if TRACKTION_BENCHMARKS && ENGINE_BENCHMARKS_VALUE_TREE_OBJECT_LIST
+
+//==============================================================================
+//==============================================================================
+class ValueTreeObjectListBenchmarks  : public juce::UnitTest
+{
+public:
+    ValueTreeObjectListBenchmarks()
+        : juce::UnitTest ("ValueTreeObjectList", "tracktion_benchmarks")
+    {}
+
+    void runTest() override
+    {
+        using namespace value_tree_object_list_test_utilities;
+
+        beginTest ("Benchmark: ValueTreeObjectList");
+        {
+            // Moving a child re-sorts the whole of the plain list so it only gets a few children
+            runBenchmarks<ValueTreeObjectList<Object>> ("ValueTreeObjectList", 2'000);
+            runBenchmarks<IndexedValueTreeObjectList<Object>> ("IndexedValueTreeObjectList", 2'000);
+            runBenchmarks<IndexedValueTreeObjectList<Object>> ("IndexedValueTreeObjectList", 100'000);
+        }
+    }
+
+private:
+    BenchmarkDescription getDescription (std::string bmName)
+    {
+        const auto bmCategory = (getName() + "/" + getCategory()).toStdString();
+        const auto bmDescription = bmName;
+
+        return { std::hash<std::string>{} (bmName + bmCategory + bmDescription),
+                 bmCategory, bmName, bmDescription };
+    }
+
+    template<typename ListType>
+    void runBenchmarks (std::string listName, int numChildren)
+    {
+        using namespace value_tree_object_list_test_utilities;
+
+        juce::Random r (42);
+        juce::ValueTree parent (IDs::TRACK);
+        TestList<ListType> list (parent);
+        const auto suffix = " (" + listName + ", " + std::to_string (numChildren) + " children)";
+
+        {
+            ScopedBenchmark sb (getDescription ("Append children" + suffix));
+
+            for (int i = 0; i < numChildren; ++i)
+                parent.appendChild (juce::ValueTree (IDs::CLIP), nullptr);
+        }
+
+        {
+            ScopedBenchmark sb (getDescription ("Find objects" + suffix));
+
+            for (int i = 0; i < 1'000; ++i)
+                expect (getObjectFor (list, parent.getChild (r.nextInt (numChildren))) != nullptr);
+        }
+
+        {
+            ScopedBenchmark sb (getDescription ("Move children" + suffix));
+
+            for (int i = 0; i < numChildren / 10; ++i)
+                parent.moveChild (r.nextInt (numChildren), r.nextInt (numChildren), nullptr);
+        }
+
+        {
+            ScopedBenchmark sb (getDescription ("Remove children" + suffix));
+
+            while (parent.getNumChildren() > 0)
+                parent.removeChild (r.nextInt (parent.getNumChildren()), nullptr);
+        }
+
+        expect (list.isEmpty());
+    }
+};
+
+static ValueTreeObjectListBenchmarks valueTreeObjectListBenchmarks;
+
+#endif
+
+} // namespace tracktion::inline engine
+
+#endif